@@ -13,25 +13,79 @@
 // Integral type used to store data within arbitrary-precision numbers
 typedef uint_most64_t bitfld_t;
 
-// Arbitrary-precision decimal
+/* Arbitrary-precision integer
+ * Bit buffers shared by `dwhl_share()' are counted by `refs', and copied before either integer is modified */
 typedef struct {
-    bitfld_t *whl, *dec;
-    size_t wsize, dsize;
+    bitfld_t *bits;
+    size_t size;
+    bool rval;
+    struct dwhl_refs *refs;     // # of integers sharing bit buffer, or NULL if not shared
+} dwhl_t;
+
+/* Arbitrary-precision decimal, holding value coef / 10^scale
+ * Scale is kept by every operation storing into the decimal; results needing more
+ * decimal places are rounded once, by `rules', which may be assigned directly */
+typedef struct {
+    dwhl_t coef;
+    size_t scale;
     enum {
-        AF_NULL,        // No flags
-        AF_ROUND,       // Round to # of decimal places
-        AF_FLOOR = 128, // Floor result
-        AF_CEIL  = 256  // Ceiling result
+        AF_NULL,        // Truncate towards zero
+        AF_ROUND,       // Round half away from zero
+        AF_FLOOR = 128, // Round towards negative infinity
+        AF_CEIL  = 256  // Round towards positive infinity
     } rules;
-    bool rval;
 } ddec_t;
 
-// Arbitrary-precision integer
+/* Fixed-width unsigned integers, wrapping modulo 2^256, 2^512, and 2^1024
+ * Bitfields are held in place, least significant first, so values may live on the stack */
 typedef struct {
-    bitfld_t *bits;
-    size_t size;
-    bool rval;
-} dwhl_t;
+    bitfld_t bits[256 / (UINT_MOST64_SIZE * 8)];
+} dwhl256_t;
+typedef struct {
+    bitfld_t bits[512 / (UINT_MOST64_SIZE * 8)];
+} dwhl512_t;
+typedef struct {
+    bitfld_t bits[1024 / (UINT_MOST64_SIZE * 8)];
+} dwhl1024_t;
+
+// Operand sizes, in bitfields, and widths at which arithmetic changes algorithm
+typedef struct {
+    size_t mul_karatsuba;   // Products of operands this long use Karatsuba; at least 2
+    size_t sqr_karatsuba;   // Squares of operands this long use Karatsuba; at least 2
+    unsigned powm_window;   // Widest window, in bits, of exponent scanned by modular exponentiation
+} dwhl_tune_t;
+
+// Cache of powers of radixes, shared between threads
+typedef struct dwhl_rpow_cache dwhl_rpow_cache_t;
+
+// Eviction policies of caches of radix powers
+typedef enum {
+    RP_LRU,     // Past memory limit, frees least recently used powers no longer referenced
+    RP_KEEP     // Never frees powers; those past memory limit are not cached
+} dwhl_rpow_policy_t;
+
+// Basis of residue number systems: its primes, and the product tree over them
+typedef struct dwhl_rns_basis dwhl_rns_basis_t;
+
+// Integer modulo product of primes of basis, held as its residue modulo each
+typedef struct {
+    const dwhl_rns_basis_t *basis;
+    uint32_t *res;                          // Residues, in Montgomery form
+} dwhl_rns_t;
+
+// Remainder tree over moduli of one bitfield each
+typedef struct dwhl_mtree dwhl_mtree_t;
+
+// Arithmetic context, owned by one thread at a time
+typedef struct {
+    void *(*realloc_fn)(void *, size_t);    // Allocates scratch space, as realloc()
+    void (*free_fn)(void *);                // Frees scratch space, as free()
+    bitfld_t *scratch;                      // Scratch space, kept between operations
+    size_t scratch_size;                    // # of bitfields in scratch space
+    dwhl_tune_t tune;
+    int err;                                // Error of last failed operation, as errno
+    dwhl_rpow_cache_t *rpow;                // Cache of radix powers, or NULL for the global cache
+} dwhl_ctx_t;
 
 // Printing options
 typedef enum {
@@ -66,12 +120,122 @@ typedef struct {
     shift_t quot, rem;
 } shdiv_t;
 
+/* Pseudo-Mersenne modulus 2^k - c, with k at least twice the width of a bitfield and c fitting one,
+ * reduced by folding bits above bit k back onto those below it */
+typedef struct {
+    shift_t k;
+    bitfld_t c;
+} dwhl_pmod_t;
+
+/* Read-only view of a range of bits of an integer, assigned by `dwhl_view()'
+ * Bits past the buffer of the integer read as its sign */
+typedef struct {
+    const bitfld_t *bits;   // Bitfield holding lowest bit of view
+    size_t size;            // # of bitfields of integer from `bits' on, or 0 if view starts past them
+    shift_t width;          // # of bits in view
+    unsigned char shift;    // Position of lowest bit of view within its bitfield
+    bool neg;               // Integer is negative
+} dwhl_view_t;
+
 // ---- ddec_t ----
 
-// ...
+/* Initializer of immutable decimal from scale and bitfields of its coefficient, as `DWHL_LITERAL()'
+ *     static const ddec_t *const cent = &(const ddec_t) DDEC_LITERAL(2, 1);
+ * Literals may be passed wherever `const ddec_t *' is taken, but are never modified or freed */
+#define DDEC_LITERAL(scale, ...)    {DWHL_LITERAL(__VA_ARGS__), (scale), AF_NULL}
+
+import extern const ddec_t *const ddec_one;
+import extern const ddec_t *const ddec_zero;
+
+BEGIN
+
+// -- Basic Utilities --
+
+/* Compares two decimals by value, regardless of scale
+ * Returns 2 and sets errno on internal error
+ *
+ * Case            Return
+ *  lhs < rhs     -1
+ *  lhs > rhs      1
+ *  lhs = rhs      0 */
+import int ddec_cmp(const ddec_t *lhs, const ddec_t *rhs) nonnull() pure;
+
+/* Assigns value to tar, keeping scale of tar, rounding by rules of tar
+ * Returns NULL and sets errno on internal error */
+import ddec_t *ddec_eq(ddec_t *restrict tar, const ddec_t *restrict val) nonnull();
+import ddec_t *ddec_eqi(ddec_t *restrict tar, const dwhl_t *restrict val) nonnull();
+import ddec_t *ddec_eqs(ddec_t *restrict tar, integr_t val) nonnull();
+import ddec_t *ddec_equ(ddec_t *restrict tar, uintegr_t val) nonnull();
+
+/* Assigns initial value to tar at given scale, with no rounding rules
+ * `ddec_initc()' takes the coefficient instead, so the value is coef / 10^scale
+ * `ddec_initf()' copies scale and rules of val
+ * Returns NULL and sets errno on internal error */
+import ddec_t *ddec_initc(ddec_t *restrict tar, const dwhl_t *restrict coef, size_t scale) nonnull();
+import ddec_t *ddec_initf(ddec_t *restrict tar, const ddec_t *restrict val) nonnull();
+import ddec_t *ddec_initi(ddec_t *restrict tar, const dwhl_t *restrict val, size_t scale) nonnull();
+import ddec_t *ddec_inits(ddec_t *restrict tar, integr_t val, size_t scale) nonnull();
+import ddec_t *ddec_initu(ddec_t *restrict tar, uintegr_t val, size_t scale) nonnull();
+
+// Returns true if decimal is negative
+import bool ddec_isneg(const ddec_t *restrict val) nonnull();
+
+/* Changes # of decimal places held by tar, rounding by its rules
+ * Returns NULL and sets errno on internal error */
+import ddec_t *ddec_rescale(ddec_t *tar, size_t scale) nonnull();
+
+// -- Basic Arithmetic --
+
+/* Stores result of arithmetic operation on two decimals within `tar', keeping its scale
+ * Exact result is rounded once, by rules of tar
+ * Returns NULL and sets errno on internal error */
+import ddec_t *ddec_abseq(ddec_t *tar) nonnull();
+import ddec_t *ddec_addeq(ddec_t *tar, const ddec_t *val) nonnull();
+import ddec_t *ddec_muleq(ddec_t *tar, const ddec_t *val) nonnull();
+import ddec_t *ddec_negeq(ddec_t *tar) nonnull();
+import ddec_t *ddec_subeq(ddec_t *tar, const ddec_t *val) nonnull();
+
+// Returns NULL and sets errno to EDOM on division by 0
+import ddec_t *ddec_diveq(ddec_t *tar, const ddec_t *val) nonnull();
+
+// -- Transcendental Functions --
+
+/* Assigns constant to tar, keeping scale of tar, rounding by rules of tar
+ * Constants are cached at the most places yet requested
+ * Returns NULL and sets errno on internal error */
+import ddec_t *ddec_eqe(ddec_t *tar) nonnull();
+import ddec_t *ddec_eqln2(ddec_t *tar) nonnull();
+import ddec_t *ddec_eqpi(ddec_t *tar) nonnull();
+
+/* Stores function of decimal within `tar', keeping its scale
+ * Result is rounded once, by rules of tar
+ * Returns NULL and sets errno to EDOM outside domain, or to ERANGE if result is too large
+ * Returns NULL and sets errno on internal error */
+import ddec_t *ddec_expeq(ddec_t *tar) nonnull();
+import ddec_t *ddec_logeq(ddec_t *tar) nonnull();
+import ddec_t *ddec_sqrteq(ddec_t *tar) nonnull();
+
+END
+
+// Frees contents of decimal
+static inline void ddec_clr(ddec_t *val) nonnull();
 
 // ---- dwhl_t ----
 
+/* Initializer of immutable integer from its bitfields, least significant first
+ * Bitfields are in two's complement, so a nonnegative integer whose top bitfield has its high bit set
+ * needs a trailing 0, and a negative integer must end in a bitfield with its high bit set
+ * At file scope, the integer is built at compile time, without heap use:
+ *     static const dwhl_t p = DWHL_LITERAL(0xffffffffffffffc5, 0xffffffffffffffff, 0);
+ *     static const dwhl_t *const q = &(const dwhl_t) DWHL_LITERAL(0x7b);
+ * Literals may be passed wherever `const dwhl_t *' is taken, but are never modified or freed
+ * Longer decimal constants are converted by `tools/dwhllit.c' */
+#define DWHL_LITERAL(...)   {                                    \
+    (bitfld_t *) (const bitfld_t[]) {__VA_ARGS__},               \
+    sizeof((const bitfld_t[]) {__VA_ARGS__}) / sizeof(bitfld_t), \
+    false, NULL                                                  \
+}
+
 import extern const dwhl_t *const dwhl_one;
 import extern const dwhl_t *const dwhl_zero;
 
@@ -94,15 +258,16 @@ import uintegr_t dwhl_castu(const dwhl_t *val, size_t size) nonnull() pure;
 import int dwhl_cmp(const dwhl_t *lhs, const dwhl_t *rhs) nonnull() pure;
 
 /* Assigns value to tar
+ * Decimals are rounded to integers by their rules
  * Returns NULL and sets errno on internal error */
 import dwhl_t *dwhl_eq(dwhl_t *restrict tar, const dwhl_t *restrict val) nonnull();
-// import dwhl_t *dwhl_eqf(dwhl_t *restrict tar, const ddec_t *restrict val) nonnull();
+import dwhl_t *dwhl_eqf(dwhl_t *restrict tar, const ddec_t *restrict val) nonnull();
 import dwhl_t *dwhl_eqs(dwhl_t *restrict tar, integr_t val) nonnull();
 import dwhl_t *dwhl_equ(dwhl_t *restrict tar, uintegr_t val) nonnull();
 
 /* Assigns initial value to tar
  * Returns NULL and sets errno on internal error */
-// import dwhl_t *dwhl_initf(dwhl_t *restrict tar, const ddec_t *restrict val) nonnull();
+import dwhl_t *dwhl_initf(dwhl_t *restrict tar, const ddec_t *restrict val) nonnull();
 import dwhl_t *dwhl_initi(dwhl_t *restrict tar, const dwhl_t *restrict val) nonnull();
 import dwhl_t *dwhl_inits(dwhl_t *restrict tar, integr_t val) nonnull();
 import dwhl_t *dwhl_initu(dwhl_t *restrict tar, uintegr_t val) nonnull();
@@ -110,64 +275,109 @@ import dwhl_t *dwhl_initu(dwhl_t *restrict tar, uintegr_t val) nonnull();
 // Returns true if integer is negative
 import bool dwhl_isneg(const dwhl_t *restrict val) nonnull();
 
+// Frees contents of integer, or releases its bit buffer if shared, as `dwhl_clr()'
+import void dwhl_release(dwhl_t *val) nonnull();
+
+/* Assigns initial value to tar, sharing bit buffer of val in constant time
+ * Whichever integer is modified first takes a private copy; until then, `dwhl_eq()', `dwhl_initi()',
+ * and `dwhl_tmp()' share the buffer too, rather than copy it
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_share(dwhl_t *restrict tar, dwhl_t *restrict val) nonnull();
+
 /* Swaps values of integers
  * Returns pointer to first integer
  * Returns NULL and sets errno if NULL is passed */
 import dwhl_t *dwhl_swp(dwhl_t *restrict ret, dwhl_t *restrict val) nonnull();
 
+/* Takes private copy of bit buffer of integer, if shared
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_unshare(dwhl_t *tar) nonnull();
+
 END
 
+/* Temporaries, returned by `dwhl_tmp()' and by operations that do not end in `-eq',
+ * are heap-allocated integers owned by the caller
+ * Functions taking `const dwhl_t *' only read it, so one integer may be read by many threads at once;
+ * a temporary passed to them is not freed, and must be passed to a function ending in `_take',
+ * or to `dwhl_drop()' */
+
 // Frees contents of integer
 static inline void dwhl_clr(dwhl_t *val) nonnull();
 
+// Frees temporary integer; lvalues are left untouched
+static inline void dwhl_drop(dwhl_t *val);
+
 // Creates temporary integer that can be passed as argument
 static inline dwhl_t *dwhl_tmp(const dwhl_t *val) nonnull() warn_unused;
-// static inline dwhl_t *dwhl_tmpf(const ddec_t *val) nonnull() warn_unused;
+static inline dwhl_t *dwhl_tmpf(const ddec_t *val) nonnull() warn_unused;
 static inline dwhl_t *dwhl_tmps(integr_t val) warn_unused;
 static inline dwhl_t *dwhl_tmpu(uintegr_t val) warn_unused;
 
 void dwhl_clr(dwhl_t *restrict val) {
-    if (val)
+    if (!val)
+        return;
+    if (val->refs)
+        dwhl_release(val);
+    else
         free(val->bits);
-    return;
+}
+
+void dwhl_drop(dwhl_t *val) {
+    if (val && val->rval) {
+        dwhl_clr(val);
+        free(val);
+    }
 }
 
 dwhl_t *dwhl_tmp(const dwhl_t *val) {
-    dwhl_t *tmp = dwhl_initi(malloc(sizeof(dwhl_t)), val);
+    dwhl_t *const tar = (dwhl_t *) malloc(sizeof(dwhl_t)), *tmp = dwhl_initi(tar, val);
 
     if (tmp)
         tmp->rval = true;
+    else
+        free(tar);
     return tmp;
 }
-/* dwhl_t *dwhl_tmpf(const ddec_t *val) {
-    dwhl_t *tmp = dwhl_initf(malloc(sizeof(dwhl_t)), val);
+dwhl_t *dwhl_tmpf(const ddec_t *val) {
+    dwhl_t *const tar = (dwhl_t *) malloc(sizeof(dwhl_t)), *tmp = dwhl_initf(tar, val);
 
     if (tmp)
         tmp->rval = true;
+    else
+        free(tar);
     return tmp;
-} */
+}
 dwhl_t *dwhl_tmps(integr_t val) {
-    dwhl_t *tmp = dwhl_inits(malloc(sizeof(dwhl_t)), val);
+    dwhl_t *const tar = (dwhl_t *) malloc(sizeof(dwhl_t)), *tmp = dwhl_inits(tar, val);
 
     if (tmp)
         tmp->rval = true;
+    else
+        free(tar);
     return tmp;
 }
 dwhl_t *dwhl_tmpu(uintegr_t val) {
-    dwhl_t *tmp = dwhl_initu(malloc(sizeof(dwhl_t)), val);
+    dwhl_t *const tar = (dwhl_t *) malloc(sizeof(dwhl_t)), *tmp = dwhl_initu(tar, val);
 
     if (tmp)
         tmp->rval = true;
+    else
+        free(tar);
     return tmp;
 }
 
+void ddec_clr(ddec_t *restrict val) {
+    if (val)
+        dwhl_clr(&val->coef);
+}
+
 BEGIN
 
 // -- Basic Arithmetic --
 
 /* Returns result of arithmetic/bitwise operation on two integers
  * Functions ending in '-eq' store result within `tar'
- * All other functions store result within heap-allocated copy
+ * All other functions store result within heap-allocated copy, returned as a temporary
  * Returns NULL and sets errno on internal error */
 import dwhl_t *dwhl_abseq(dwhl_t *tar) nonnull();
 import dwhl_t *dwhl_addeq(dwhl_t *tar, const dwhl_t *val) nonnull();
@@ -187,17 +397,41 @@ import dwhl_t *dwhl_not(const dwhl_t *val) nonnull() warn_unused;
 import dwhl_t *dwhl_sub(const dwhl_t *lhs, const dwhl_t *rhs) nonnull() warn_unused;
 import dwhl_t *dwhl_xor(const dwhl_t *lhs, const dwhl_t *rhs) nonnull() warn_unused;
 
-// Nonwhole results are truncated
+/* Nonwhole results are truncated, and remainders take the sign of `tar'
+ * Returns NULL and sets errno to EDOM on division by 0 */
 import dwhl_t *dwhl_diveq(dwhl_t *tar, const dwhl_t *val) nonnull();
 import dwhl_t *dwhl_modeq(dwhl_t *tar, const dwhl_t *val) nonnull();
 import dwhl_t *dwhl_muleq(dwhl_t *tar, const dwhl_t *val) nonnull();
 
+/* Divides by integer known to divide `tar' exactly, at about the cost of one product
+ * Result is undefined if division is inexact; unless the library is built with NDEBUG, the program terminates
+ * Returns NULL and sets errno to EDOM on division by 0 */
+import dwhl_t *dwhl_divexacteq(dwhl_t *tar, const dwhl_t *val) nonnull();
+
+/* Adds (addmul) or subtracts (submul) product of lhs and rhs to `tar', without a temporary for the product
+ * Any operand may be `tar' itself */
+import dwhl_t *dwhl_addmuleq(dwhl_t *tar, const dwhl_t *lhs, const dwhl_t *rhs) nonnull();
+import dwhl_t *dwhl_submuleq(dwhl_t *tar, const dwhl_t *lhs, const dwhl_t *rhs) nonnull();
+
+/* Stores low `bits' bits of product within `tar' (mullo), or product shifted right by `bits' (mulhi),
+ * computing only the bitfields that reach the result
+ * Low bits are those of the product in two's complement, so are never negative
+ * High result is truncated toward zero, but may fall short of it in magnitude by `dwhl_mulhi_err()' */
+import dwhl_t *dwhl_mulhieq(dwhl_t *tar, const dwhl_t *val, shift_t bits) nonnull();
+import dwhl_t *dwhl_mulloeq(dwhl_t *tar, const dwhl_t *val, shift_t bits) nonnull();
+
+// Returns greatest shortfall of `dwhl_mulhieq()' on given operands, or 0 if it is exact
+import size_t dwhl_mulhi_err(const dwhl_t *lhs, const dwhl_t *rhs, shift_t bits) nonnull();
+
 import dwhl_t *dwhl_div(const dwhl_t *lhs, const dwhl_t *rhs) nonnull() warn_unused;
+import dwhl_t *dwhl_divexact(const dwhl_t *lhs, const dwhl_t *rhs) nonnull() warn_unused;
 import dwhl_t *dwhl_mod(const dwhl_t *lhs, const dwhl_t *rhs) nonnull() warn_unused;
 import dwhl_t *dwhl_mul(const dwhl_t *lhs, const dwhl_t *rhs) nonnull() warn_unused;
+import dwhl_t *dwhl_mulhi(const dwhl_t *lhs, const dwhl_t *rhs, shift_t bits) nonnull() warn_unused;
+import dwhl_t *dwhl_mullo(const dwhl_t *lhs, const dwhl_t *rhs, shift_t bits) nonnull() warn_unused;
 
-/* Bits shifted right out-of-bounds will be saved
- * Bits shifted left out-of-bounds, however, will not be */
+/* Left shifts grow the integer as needed, and `slshift' sets the vacated bits
+ * Right shifts are arithmetic, rounding toward negative infinity */
 import dwhl_t *dwhl_lshifteq(dwhl_t *tar, shift_t shift) nonnull();
 import dwhl_t *dwhl_slshifteq(dwhl_t *tar, shift_t shift) nonnull();
 import dwhl_t *dwhl_rshifteq(dwhl_t *tar, shift_t shift) nonnull();
@@ -206,6 +440,439 @@ import dwhl_t *dwhl_lshift(const dwhl_t *val, shift_t shift) nonnull() warn_unus
 import dwhl_t *dwhl_slshift(const dwhl_t *val, shift_t shift) nonnull() warn_unused;
 import dwhl_t *dwhl_rshift(const dwhl_t *val, shift_t shift) nonnull() warn_unused;
 
+/* Stores remainder of division by 2^bits, which takes the sign of `tar' (mod_2exp), or is never negative (fdiv_r_2exp)
+ * Remainders never negative are the low `bits' bits of the integer in two's complement */
+import dwhl_t *dwhl_fdiv_r_2expeq(dwhl_t *tar, shift_t bits) nonnull();
+import dwhl_t *dwhl_mod_2expeq(dwhl_t *tar, shift_t bits) nonnull();
+
+import dwhl_t *dwhl_fdiv_r_2exp(const dwhl_t *val, shift_t bits) nonnull() warn_unused;
+import dwhl_t *dwhl_mod_2exp(const dwhl_t *val, shift_t bits) nonnull() warn_unused;
+
+// -- Scalar Arithmetic --
+
+/* Compares integer with signed (cmps) or unsigned (cmpu) machine integer
+ * Returns 2 and sets errno if NULL is passed */
+import int dwhl_cmps(const dwhl_t *lhs, integr_t rhs) nonnull();
+import int dwhl_cmpu(const dwhl_t *lhs, uintegr_t rhs) nonnull();
+
+/* Stores result of arithmetic/bitwise operation with machine integer within `tar'
+ * Bitwise operations sign-extend signed operands; no temporaries are allocated
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_addeqs(dwhl_t *tar, integr_t val) nonnull();
+import dwhl_t *dwhl_addequ(dwhl_t *tar, uintegr_t val) nonnull();
+import dwhl_t *dwhl_andeqs(dwhl_t *tar, integr_t val) nonnull();
+import dwhl_t *dwhl_andequ(dwhl_t *tar, uintegr_t val) nonnull();
+import dwhl_t *dwhl_oreqs(dwhl_t *tar, integr_t val) nonnull();
+import dwhl_t *dwhl_orequ(dwhl_t *tar, uintegr_t val) nonnull();
+import dwhl_t *dwhl_subeqs(dwhl_t *tar, integr_t val) nonnull();
+import dwhl_t *dwhl_subequ(dwhl_t *tar, uintegr_t val) nonnull();
+import dwhl_t *dwhl_xoreqs(dwhl_t *tar, integr_t val) nonnull();
+import dwhl_t *dwhl_xorequ(dwhl_t *tar, uintegr_t val) nonnull();
+
+/* Nonwhole results are truncated, and remainders take the sign of `tar'
+ * Returns NULL and sets errno to EDOM on division by 0 */
+import dwhl_t *dwhl_diveqs(dwhl_t *tar, integr_t val) nonnull();
+import dwhl_t *dwhl_divequ(dwhl_t *tar, uintegr_t val) nonnull();
+import dwhl_t *dwhl_modeqs(dwhl_t *tar, integr_t val) nonnull();
+import dwhl_t *dwhl_modequ(dwhl_t *tar, uintegr_t val) nonnull();
+
+// As `dwhl_divexacteq()'
+import dwhl_t *dwhl_divexacteqs(dwhl_t *tar, integr_t val) nonnull();
+import dwhl_t *dwhl_divexactequ(dwhl_t *tar, uintegr_t val) nonnull();
+import dwhl_t *dwhl_muleqs(dwhl_t *tar, integr_t val) nonnull();
+import dwhl_t *dwhl_mulequ(dwhl_t *tar, uintegr_t val) nonnull();
+
+// -- Floating-Point Conversion --
+
+/* Returns integer rounded to nearest floating-point value, ties to even
+ * Only the top bitfields are read, so conversion takes constant time for all but rare integers
+ * Returns infinity of matching sign and sets errno to ERANGE on overflow
+ * Returns 0 and sets errno if NULL is passed */
+import double dwhl_get_d(const dwhl_t *val) nonnull();
+import floatp_t dwhl_get_ld(const dwhl_t *val) nonnull();
+
+/* Returns fraction of magnitude from 0.5 to 1, with sign of integer, rounded as `dwhl_get_d()'
+ * Stores in *exp the power of 2 it is scaled by, the # of significant bits of the rounded magnitude;
+ * this never overflows */
+import double dwhl_get_d_2exp(const dwhl_t *val, shift_t *exp) nonnull();
+
+/* Assigns floating-point value to tar exactly, truncating its fraction
+ * Returns NULL and sets errno to EDOM if value is infinite or NaN */
+import dwhl_t *dwhl_set_d(dwhl_t *tar, double val) nonnull();
+import dwhl_t *dwhl_set_ld(dwhl_t *tar, floatp_t val) nonnull();
+
+// -- Bit Queries --
+
+/* Integers are treated as two's complement, with infinite sign extension
+ * Counts and positions that would be infinite are returned as SHIFT_MAX */
+
+/* Returns # of set bits in integer, or # of differing bits between two integers
+ * Negative integers, and integers of differing sign, give SHIFT_MAX */
+import shift_t dwhl_popcount(const dwhl_t *val) nonnull();
+import shift_t dwhl_hamdist(const dwhl_t *lhs, const dwhl_t *rhs) nonnull();
+
+// Returns index of first clear (scan0) or set (scan1) bit at or above start
+import shift_t dwhl_scan0(const dwhl_t *val, shift_t start) nonnull();
+import shift_t dwhl_scan1(const dwhl_t *val, shift_t start) nonnull();
+
+/* Returns # of digits of magnitude of integer in base 2 to 62, ignoring sign
+ * Exact for powers of 2; otherwise, may exceed the exact count by 1
+ * Returns 0 and sets errno to EINVAL if base is out of range */
+import size_t dwhl_sizeinbase(const dwhl_t *val, int base) nonnull();
+
+// Returns state of bit at index
+import bool dwhl_tstbit(const dwhl_t *val, shift_t index) nonnull();
+
+// -- Bit-Slice Views --
+
+/* Views read bits [lo, lo + width) of an integer in two's complement as a nonnegative integer,
+ * without copying them; shifts are applied as each bitfield is read
+ * A view is valid until its integer is modified or freed, so may not be of the integer an operation stores into */
+
+/* Assigns view of bits [lo, lo + width) of integer (view), or of another view (view_sub), to tar
+ * Views of views are clipped to the width of the view they are taken from
+ * Returns NULL and sets errno to ERANGE if lo + width exceeds SHIFT_MAX */
+import dwhl_view_t *dwhl_view(dwhl_view_t *restrict tar, const dwhl_t *restrict val, shift_t lo, shift_t width) nonnull();
+import dwhl_view_t *dwhl_view_sub(dwhl_view_t *tar, const dwhl_view_t *val, shift_t lo, shift_t width) nonnull();
+
+/* Assigns value of view to tar (eqv), or as its initial value (initv)
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_eqv(dwhl_t *restrict tar, const dwhl_view_t *restrict val) nonnull();
+import dwhl_t *dwhl_initv(dwhl_t *restrict tar, const dwhl_view_t *restrict val) nonnull();
+
+// Compares integer with view (cmpv), or two views (view_cmp), as `dwhl_cmp()'
+import int dwhl_cmpv(const dwhl_t *lhs, const dwhl_view_t *rhs) nonnull() pure;
+import int dwhl_view_cmp(const dwhl_view_t *lhs, const dwhl_view_t *rhs) nonnull() pure;
+
+/* Stores result of arithmetic operation with view (-eqv), or on two views (view_-), within `tar'
+ * Views starting on a bitfield boundary are multiplied in place; others are shifted into scratch space first
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_addeqv(dwhl_t *tar, const dwhl_view_t *val) nonnull();
+import dwhl_t *dwhl_muleqv(dwhl_t *tar, const dwhl_view_t *val) nonnull();
+import dwhl_t *dwhl_subeqv(dwhl_t *tar, const dwhl_view_t *val) nonnull();
+import dwhl_t *dwhl_view_add(dwhl_t *tar, const dwhl_view_t *lhs, const dwhl_view_t *rhs) nonnull();
+import dwhl_t *dwhl_view_mul(dwhl_t *tar, const dwhl_view_t *lhs, const dwhl_view_t *rhs) nonnull();
+
+// -- Number Theory --
+
+/* Returns greatest common divisor of two integers, which is never negative
+ * gcd(0, 0) is 0
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_gcdeq(dwhl_t *tar, const dwhl_t *val) nonnull();
+import dwhl_t *dwhl_gcd(const dwhl_t *lhs, const dwhl_t *rhs) nonnull() warn_unused;
+
+/* Assigns g = gcd(a, b) and cofactors s, t such that g = s*a + t*b
+ * If t is NULL, only s is computed
+ * Returns g
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_gcdext(dwhl_t *g, dwhl_t *s, dwhl_t *t, const dwhl_t *a, const dwhl_t *b) nonnull(1, 2, 4, 5);
+
+/* Returns inverse of integer modulo |mod|, in range [0, |mod|)
+ * Returns NULL and sets errno to EDOM if no inverse exists
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_inverteq(dwhl_t *tar, const dwhl_t *mod) nonnull();
+import dwhl_t *dwhl_invert(const dwhl_t *val, const dwhl_t *mod) nonnull() warn_unused;
+
+/* Returns base^exp modulo |mod|, in range [0, |mod|)
+ * Negative exponents use inverse of base
+ * Returns NULL and sets errno to EDOM if mod is 0, or if exp is negative and no inverse exists
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_powmeq(dwhl_t *tar, const dwhl_t *exp, const dwhl_t *mod) nonnull();
+import dwhl_t *dwhl_powm(const dwhl_t *base, const dwhl_t *exp, const dwhl_t *mod) nonnull() warn_unused;
+
+/* Assigns bases[i]^exps[i] modulo |mods[i]| to tars[i], for i below n, as `dwhl_powmeq()'
+ * Exponentiations modulo odd moduli of one size run side by side, several per vector instruction
+ * Each result may be the same integer as its own base, exponent, or modulus, but not as any other operand
+ * Stores errno of each, or 0 on success, in errs, if not NULL
+ * Returns # of exponentiations that failed, setting errno to that of the last if any */
+import size_t dwhl_powm_batch(dwhl_t *const *tars, const dwhl_t *const *bases, const dwhl_t *const *exps,
+  const dwhl_t *const *mods, size_t n, int *errs);
+
+/* Initializes reduction modulo |mod|, which `dwhl_powm()' also uses on its own for such moduli
+ * Returns NULL and sets errno to EDOM if |mod| is not pseudo-Mersenne
+ * Returns NULL and sets errno on internal error */
+import dwhl_pmod_t *dwhl_pmod_init(dwhl_pmod_t *pm, const dwhl_t *mod) nonnull();
+
+/* Stores integer (red), or product of integers (mul), modulo 2^k - c within `tar', in range [0, 2^k - c)
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_pmod_muleq(const dwhl_pmod_t *pm, dwhl_t *tar, const dwhl_t *val) nonnull();
+import dwhl_t *dwhl_pmod_redeq(const dwhl_pmod_t *pm, dwhl_t *tar) nonnull();
+
+/* Returns 2 if |val| is prime, 1 if probably prime, and 0 if composite
+ * Applies trial division and the Baillie-PSW test, which is exact below 2^64,
+ * then reps further Miller-Rabin rounds, each passed by a composite with probability below 1/4
+ * Returns 0 and sets errno on internal error */
+import int dwhl_probab_prime(const dwhl_t *val, int reps) nonnull();
+
+/* Returns least (probable) prime greater than integer
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_nextprimeeq(dwhl_t *tar) nonnull();
+import dwhl_t *dwhl_nextprime(const dwhl_t *val) nonnull() warn_unused;
+
+/* Assigns truncated n-th root of integer to root, and val - root^n to rem
+ * Remainder takes sign of val; rem may be NULL
+ * Returns root
+ * Returns NULL and sets errno to EDOM if n is 0, or if n is even and val is negative
+ * Returns NULL and sets errno on internal error */
+import dwhl_t *dwhl_rootrem(dwhl_t *root, dwhl_t *rem, const dwhl_t *val, unsigned long n) nonnull(1, 3);
+import dwhl_t *dwhl_sqrtrem(dwhl_t *root, dwhl_t *rem, const dwhl_t *val) nonnull(1, 3);
+
+import dwhl_t *dwhl_rooteq(dwhl_t *tar, unsigned long n) nonnull();
+import dwhl_t *dwhl_sqrteq(dwhl_t *tar) nonnull();
+
+import dwhl_t *dwhl_root(const dwhl_t *val, unsigned long n) nonnull() warn_unused;
+import dwhl_t *dwhl_sqrt(const dwhl_t *val) nonnull() warn_unused;
+
+/* Returns true if integer is a perfect square, or a perfect power
+ * 0 and 1 are both; -1 is a perfect power
+ * Returns false and sets errno on internal error */
+import bool dwhl_issquare(const dwhl_t *val) nonnull();
+import bool dwhl_isperfpow(const dwhl_t *val) nonnull();
+
+// -- Fixed-width Integers --
+
+/* Operations on `dwhl256_t', `dwhl512_t', and `dwhl1024_t', named after their width
+ * Arithmetic wraps around and shifts are logical; nothing is allocated
+ * `eqi' keeps the low bits of an integer in two's complement; `dwhl_eq-' and `dwhl_init-'
+ * convert back to nonnegative integers
+ * Returns NULL, or 2 if comparing, and sets errno if NULL is passed */
+#define DWHL_FIXED(w)                                                                           \
+    import dwhl##w##_t *dwhl##w##_addeq(dwhl##w##_t *tar, const dwhl##w##_t *val) nonnull();    \
+    import dwhl##w##_t *dwhl##w##_subeq(dwhl##w##_t *tar, const dwhl##w##_t *val) nonnull();    \
+    import dwhl##w##_t *dwhl##w##_muleq(dwhl##w##_t *tar, const dwhl##w##_t *val) nonnull();    \
+    import dwhl##w##_t *dwhl##w##_lshifteq(dwhl##w##_t *tar, shift_t shift) nonnull();          \
+    import dwhl##w##_t *dwhl##w##_rshifteq(dwhl##w##_t *tar, shift_t shift) nonnull();          \
+    import int dwhl##w##_cmp(const dwhl##w##_t *lhs, const dwhl##w##_t *rhs) nonnull() pure;   \
+    import dwhl##w##_t *dwhl##w##_equ(dwhl##w##_t *tar, uintegr_t val) nonnull();               \
+    import dwhl##w##_t *dwhl##w##_eqi(dwhl##w##_t *tar, const dwhl_t *val) nonnull();           \
+    import dwhl_t *dwhl_eq##w(dwhl_t *tar, const dwhl##w##_t *val) nonnull();                   \
+    import dwhl_t *dwhl_init##w(dwhl_t *tar, const dwhl##w##_t *val) nonnull();
+
+DWHL_FIXED(256)
+DWHL_FIXED(512)
+DWHL_FIXED(1024)
+
+#undef DWHL_FIXED
+
+// -- Ownership Transfer --
+
+/* Functions ending in `_take' behave as their counterparts, except that every operand that is
+ * a temporary is consumed: its buffer is reused for the result where possible, and it is
+ * freed otherwise, even on error. Lvalue operands are only read
+ * An integer passed more than once is consumed once */
+import int dwhl_cmp_take(dwhl_t *lhs, dwhl_t *rhs) nonnull();
+import dwhl_t *dwhl_eq_take(dwhl_t *restrict tar, dwhl_t *restrict val) nonnull();
+import dwhl_t *dwhl_initi_take(dwhl_t *restrict tar, dwhl_t *val) nonnull();
+
+import dwhl_t *dwhl_addeq_take(dwhl_t *tar, dwhl_t *val) nonnull();
+import dwhl_t *dwhl_andeq_take(dwhl_t *tar, dwhl_t *val) nonnull();
+import dwhl_t *dwhl_diveq_take(dwhl_t *tar, dwhl_t *val) nonnull();
+import dwhl_t *dwhl_modeq_take(dwhl_t *tar, dwhl_t *val) nonnull();
+import dwhl_t *dwhl_muleq_take(dwhl_t *tar, dwhl_t *val) nonnull();
+import dwhl_t *dwhl_oreq_take(dwhl_t *tar, dwhl_t *val) nonnull();
+import dwhl_t *dwhl_subeq_take(dwhl_t *tar, dwhl_t *val) nonnull();
+import dwhl_t *dwhl_xoreq_take(dwhl_t *tar, dwhl_t *val) nonnull();
+
+import dwhl_t *dwhl_abs_take(dwhl_t *val) nonnull() warn_unused;
+import dwhl_t *dwhl_neg_take(dwhl_t *val) nonnull() warn_unused;
+import dwhl_t *dwhl_not_take(dwhl_t *val) nonnull() warn_unused;
+import dwhl_t *dwhl_add_take(dwhl_t *lhs, dwhl_t *rhs) nonnull() warn_unused;
+import dwhl_t *dwhl_and_take(dwhl_t *lhs, dwhl_t *rhs) nonnull() warn_unused;
+import dwhl_t *dwhl_div_take(dwhl_t *lhs, dwhl_t *rhs) nonnull() warn_unused;
+import dwhl_t *dwhl_mod_take(dwhl_t *lhs, dwhl_t *rhs) nonnull() warn_unused;
+import dwhl_t *dwhl_mul_take(dwhl_t *lhs, dwhl_t *rhs) nonnull() warn_unused;
+import dwhl_t *dwhl_or_take(dwhl_t *lhs, dwhl_t *rhs) nonnull() warn_unused;
+import dwhl_t *dwhl_sub_take(dwhl_t *lhs, dwhl_t *rhs) nonnull() warn_unused;
+import dwhl_t *dwhl_xor_take(dwhl_t *lhs, dwhl_t *rhs) nonnull() warn_unused;
+
+import dwhl_t *dwhl_lshift_take(dwhl_t *val, shift_t shift) nonnull() warn_unused;
+import dwhl_t *dwhl_slshift_take(dwhl_t *val, shift_t shift) nonnull() warn_unused;
+import dwhl_t *dwhl_rshift_take(dwhl_t *val, shift_t shift) nonnull() warn_unused;
+
+import dwhl_t *dwhl_gcdeq_take(dwhl_t *tar, dwhl_t *val) nonnull();
+import dwhl_t *dwhl_inverteq_take(dwhl_t *tar, dwhl_t *mod) nonnull();
+import dwhl_t *dwhl_powmeq_take(dwhl_t *tar, dwhl_t *exp, dwhl_t *mod) nonnull();
+
+import dwhl_t *dwhl_gcd_take(dwhl_t *lhs, dwhl_t *rhs) nonnull() warn_unused;
+import dwhl_t *dwhl_invert_take(dwhl_t *val, dwhl_t *mod) nonnull() warn_unused;
+import dwhl_t *dwhl_powm_take(dwhl_t *base, dwhl_t *exp, dwhl_t *mod) nonnull() warn_unused;
+import dwhl_t *dwhl_nextprime_take(dwhl_t *val) nonnull() warn_unused;
+import dwhl_t *dwhl_root_take(dwhl_t *val, unsigned long n) nonnull() warn_unused;
+import dwhl_t *dwhl_sqrt_take(dwhl_t *val) nonnull() warn_unused;
+
+// -- Contexts --
+
+/* Operations ending in `_ctx' behave as their counterparts, except that scratch space is
+ * taken from the context, grown as needed and reused by later calls, and errors are stored
+ * in ctx->err, leaving errno unchanged. Threads owning separate contexts share no state
+ * Integers themselves are still allocated with malloc() and freed with `dwhl_clr()' */
+
+/* Initializes context with malloc()-family allocation and default thresholds
+ * Members may be changed afterwards, but allocation functions only while no scratch space is held
+ * Returns NULL and sets errno if NULL is passed */
+import dwhl_ctx_t *dwhl_ctx_init(dwhl_ctx_t *ctx) nonnull();
+
+// Frees scratch space of context
+import void dwhl_ctx_clr(dwhl_ctx_t *ctx) nonnull();
+
+/* Returns NULL and sets ctx->err on internal error
+ * Returns NULL and sets errno if ctx is NULL */
+import dwhl_t *dwhl_diveq_ctx(dwhl_ctx_t *ctx, dwhl_t *tar, const dwhl_t *val) nonnull();
+import dwhl_t *dwhl_modeq_ctx(dwhl_ctx_t *ctx, dwhl_t *tar, const dwhl_t *val) nonnull();
+import dwhl_t *dwhl_muleq_ctx(dwhl_ctx_t *ctx, dwhl_t *tar, const dwhl_t *val) nonnull();
+import dwhl_t *dwhl_powmeq_ctx(dwhl_ctx_t *ctx, dwhl_t *tar, const dwhl_t *exp, const dwhl_t *mod) nonnull();
+
+/* Decimal operations take powers of ten from ctx->rpow, or from the global cache if NULL
+ * Their scratch space is still allocated on every call
+ * Returns NULL and sets ctx->err on internal error
+ * Returns NULL and sets errno if ctx is NULL */
+import ddec_t *ddec_addeq_ctx(dwhl_ctx_t *ctx, ddec_t *tar, const ddec_t *val) nonnull();
+import ddec_t *ddec_diveq_ctx(dwhl_ctx_t *ctx, ddec_t *tar, const ddec_t *val) nonnull();
+import ddec_t *ddec_muleq_ctx(dwhl_ctx_t *ctx, ddec_t *tar, const ddec_t *val) nonnull();
+import ddec_t *ddec_rescale_ctx(dwhl_ctx_t *ctx, ddec_t *tar, size_t scale) nonnull();
+import ddec_t *ddec_subeq_ctx(dwhl_ctx_t *ctx, ddec_t *tar, const ddec_t *val) nonnull();
+
+// -- Radix Powers --
+
+/* Powers base^(d 2^i) of radixes 2 to 36, where base^d is the largest power of base fitting
+ * one bitfield, are computed on first request by repeated squaring and kept in a cache
+ * Caches may be used by many threads at once. Each holds powers up to a memory limit, in bytes,
+ * beyond which its eviction policy applies. The global cache starts with a limit of 16 MiB,
+ * evicting the least recently used powers */
+
+/* Creates cache of radix powers
+ * Returns NULL on allocation failure */
+import dwhl_rpow_cache_t *dwhl_rpow_cache_new(size_t limit, dwhl_rpow_policy_t policy) warn_unused;
+
+// Frees cache and the powers it holds; none may still be referenced
+import void dwhl_rpow_cache_free(dwhl_rpow_cache_t *cache);
+
+/* Changes memory limit and eviction policy of cache, or of the global cache if NULL
+ * Under `RP_LRU', unreferenced powers past the new limit are freed at once */
+import void dwhl_rpow_config(dwhl_rpow_cache_t *cache, size_t limit, dwhl_rpow_policy_t policy);
+
+/* Returns d, the # of digits of base held by one bitfield
+ * Returns 0 and sets errno to EINVAL if base is not from 2 to 36 */
+import unsigned dwhl_rpow_digits(unsigned base) pure;
+
+/* Returns read-only reference to base^(d 2^i), from cache of ctx, or from the global cache
+ * if either is NULL; the power stays valid until passed to `dwhl_rpow_put()'
+ * Returns NULL and sets ctx->err, or errno if ctx is NULL, on internal error */
+import const dwhl_t *dwhl_rpow_get(dwhl_ctx_t *ctx, unsigned base, unsigned i) warn_unused;
+
+// Releases reference to radix power
+import void dwhl_rpow_put(const dwhl_t *pow);
+
+// -- Residue Number Systems --
+
+/* Integers held modulo M, the product of a basis of distinct primes below 2^31, as their
+ * residues modulo each prime, so that sums and products act on every residue independently
+ * Bases are read-only once created, and may be shared between threads. Operands of one
+ * operation must share one basis */
+
+/* Creates basis of the largest primes below 2^31, enough that M > 2^(bits + 1), so that
+ * integers of `bits' bits, and their sign, are recovered exactly
+ * Returns NULL and sets errno to ERANGE if basis would be too large */
+import dwhl_rns_basis_t *dwhl_rns_basis_new(size_t bits) warn_unused;
+
+/* Creates basis of given primes
+ * Returns NULL and sets errno to EDOM if any is not an odd prime below 2^31, or is repeated */
+import dwhl_rns_basis_t *dwhl_rns_basis_newp(const uint32_t *primes, size_t n) warn_unused;
+
+// Frees basis; no integer may still use it
+import void dwhl_rns_basis_free(dwhl_rns_basis_t *basis);
+
+// Returns M, the product of primes of basis
+import const dwhl_t *dwhl_rns_basis_mod(const dwhl_rns_basis_t *basis) pure;
+
+// Returns # of primes in basis
+import size_t dwhl_rns_basis_size(const dwhl_rns_basis_t *basis) pure;
+
+// Initializes tar to 0, over basis
+import dwhl_rns_t *dwhl_rns_init(dwhl_rns_t *tar, const dwhl_rns_basis_t *basis) nonnull();
+import void dwhl_rns_clr(dwhl_rns_t *tar);
+
+// Assigns val modulo M to tar
+import dwhl_rns_t *dwhl_rns_eqi(dwhl_rns_t *tar, const dwhl_t *val) nonnull();
+
+// Assigns value of val to tar, from 0 to M - 1, or, for `_gets', from -(M - 1) / 2 to (M - 1) / 2
+import dwhl_t *dwhl_rns_get(dwhl_t *tar, const dwhl_rns_t *val) nonnull();
+import dwhl_t *dwhl_rns_gets(dwhl_t *tar, const dwhl_rns_t *val) nonnull();
+
+/* Elementwise arithmetic modulo M
+ * Returns NULL and sets errno to EINVAL if operands are over different bases */
+import dwhl_rns_t *dwhl_rns_addeq(dwhl_rns_t *tar, const dwhl_rns_t *val) nonnull();
+import dwhl_rns_t *dwhl_rns_muleq(dwhl_rns_t *tar, const dwhl_rns_t *val) nonnull();
+import dwhl_rns_t *dwhl_rns_negeq(dwhl_rns_t *tar) nonnull();
+import dwhl_rns_t *dwhl_rns_subeq(dwhl_rns_t *tar, const dwhl_rns_t *val) nonnull();
+
+// -- Remainder Trees --
+
+/* Residues of one integer modulo many moduli of one bitfield, such as the small primes of trial
+ * division, found by reducing through a tree of products of moduli
+ * Trees are read-only once created, and may be shared between threads */
+
+/* Creates remainder tree over n moduli
+ * Returns NULL and sets errno to EDOM if any modulus is 0 */
+import dwhl_mtree_t *dwhl_mtree_new(const bitfld_t *moduli, size_t n) warn_unused;
+
+// Frees remainder tree
+import void dwhl_mtree_free(dwhl_mtree_t *tree);
+
+/* Stores val modulo each modulus, in range [0, modulus), in out, which holds one bitfield per modulus
+ * `dwhl_mod_multi()' builds and frees a tree of its moduli; reductions by many integers should share one
+ * Returns NULL and sets errno on internal error */
+import bitfld_t *dwhl_mtree_mod(const dwhl_mtree_t *tree, const dwhl_t *val, bitfld_t *out) nonnull();
+import bitfld_t *dwhl_mod_multi(const dwhl_t *val, const bitfld_t *moduli, size_t n, bitfld_t *out) nonnull();
+
+// -- Low-level Interface --
+
+/* Routines on little-endian buffers of bitfields ("limbs"), holding unsigned magnitudes
+ * Nothing is checked and nothing is allocated; routines needing temporary space
+ * take it from `tp', which holds as many bitfields as the matching `-itch' function returns */
+
+// Stores sum or difference of buffers of n bitfields in rp, returning carry or borrow
+import bitfld_t dwhl_ln_add_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n) nonnull();
+import bitfld_t dwhl_ln_sub_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n) nonnull();
+
+/* Stores product of a and b, or square of a, in rp, which holds an + bn (or 2n) bitfields
+ * Requires nonzero sizes; rp may not overlap either operand */
+import size_t dwhl_ln_mul_itch(size_t an, size_t bn);
+import void dwhl_ln_mul(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn, bitfld_t *tp) nonnull(1, 2, 4);
+import size_t dwhl_ln_sqr_itch(size_t n);
+import void dwhl_ln_sqr(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t *tp) nonnull(1, 2);
+
+/* Stores high (mulhi) or low (mullo) n bitfields of product of a and b, each n > 0 bitfields, in rp
+ * High half may fall short of the exact one by up to `dwhl_ln_mulhi_err(n)'
+ * rp may not overlap either operand */
+import size_t dwhl_ln_mulhi_itch(size_t n);
+import void dwhl_ln_mulhi(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp) nonnull(1, 2, 3);
+import size_t dwhl_ln_mulhi_err(size_t n);
+import size_t dwhl_ln_mullo_itch(size_t n);
+import void dwhl_ln_mullo(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp) nonnull(1, 2, 3);
+
+/* Divides n by d, storing nn - dn + 1 bitfields of quotient in qp and
+ * remainder in the low dn bitfields of np
+ * Requires nn >= dn and dp[dn - 1] != 0 */
+import size_t dwhl_ln_divrem_itch(size_t nn, size_t dn);
+import void dwhl_ln_divrem(bitfld_t *qp, bitfld_t *np, size_t nn, const bitfld_t *dp, size_t dn, bitfld_t *tp) nonnull();
+
+/* As above, storing only the quotient, given that d divides n exactly; np is destroyed */
+import size_t dwhl_ln_divexact_itch(size_t nn, size_t dn);
+import void dwhl_ln_divexact(bitfld_t *qp, bitfld_t *np, size_t nn, const bitfld_t *dp, size_t dn, bitfld_t *tp) nonnull();
+
+/* Shifts buffer of n > 0 bitfields by 0 < cnt < 64 bits, returning bits shifted out
+ * Left shift may be done in place or towards higher addresses; right shift,
+ * in place or towards lower addresses */
+import bitfld_t dwhl_ln_lshift(bitfld_t *rp, const bitfld_t *ap, size_t n, unsigned cnt) nonnull();
+import bitfld_t dwhl_ln_rshift(bitfld_t *rp, const bitfld_t *ap, size_t n, unsigned cnt) nonnull();
+
+// Compares buffers of n bitfields, returning -1, 0, or 1
+import int dwhl_ln_cmp(const bitfld_t *ap, const bitfld_t *bp, size_t n) nonnull();
+
+// Returns size of buffer without its high zero bitfields
+import size_t dwhl_ln_norm(const bitfld_t *ap, size_t n);
+
 END
 
 // ---- shift_t ----
@@ -0,0 +1,416 @@
+#ifndef LADLE_ARBITRARY_HPP
+#define LADLE_ARBITRARY_HPP
+#include <cerrno>
+#include <new>          // std::bad_alloc
+#include <stdexcept>    // std::domain_error, std::invalid_argument, std::length_error
+#include <type_traits>  // std::enable_if, std::is_integral, std::is_signed
+#include <utility>      // std::swap
+
+#ifndef restrict
+#define ARBITRARY_RESTRICT
+#define restrict __restrict
+#endif
+#include "arbitrary.h"
+#ifdef ARBITRARY_RESTRICT
+#undef ARBITRARY_RESTRICT
+#undef restrict
+#endif
+
+/* C++ interface to arbitrary-precision integers
+ *
+ * `arbitrary::dwhl' owns its bit buffer, freeing it on destruction, and moves
+ * steal buffers instead of copying them, so no temporaries of the C interface
+ * are ever created. Errors are thrown as exceptions instead of reported
+ * through errno.
+ *
+ * Sums, differences, and products of integers are not computed by their
+ * operators, which return small expression objects referring to their
+ * operands. Assigning an expression evaluates it within the buffer of the
+ * target, so `a = b * c + d' copies d into a, then adds the product of b and
+ * c in place, reusing the buffer a already holds; `a = b * c - d * e' forms
+ * b * c in a, then subtracts d * e in place. Expressions refer to their
+ * operands, so must not outlive the full expression that creates them, as
+ * with `auto e = b * c'. All other operators compute their results eagerly,
+ * reusing the buffer of their left operand when it is an rvalue.
+ *
+ * Moved-from integers may only be assigned or destroyed. */
+
+namespace arbitrary {
+
+class dwhl;
+
+// ---- Expressions ----
+
+// Product of two integers
+struct mul_expr {
+    const dwhl &lhs, &rhs;
+};
+
+// Sum (or difference, if `sub') of two integers
+struct add_expr {
+    const dwhl &lhs, &rhs;
+    bool sub;
+};
+
+// Sum (or difference, if `sub') of integer and product of two integers; integer is negated first if `neg'
+struct addmul_expr {
+    const dwhl &add, &lhs, &rhs;
+    bool sub, neg;
+};
+
+// Sum (or difference, if `sub') of two products
+struct mulsum_expr {
+    mul_expr lhs, rhs;
+    bool sub;
+};
+
+// ---- Helper Functions ----
+
+namespace detail {
+
+// Throws exception matching errno if operation failed
+inline void check(const void *res) {
+    if (res)
+        return;
+    switch (errno) {
+    case EDOM:
+        throw std::domain_error("arbitrary: result undefined");
+    case EINVAL:
+        throw std::invalid_argument("arbitrary: invalid argument");
+    case ERANGE:
+        throw std::length_error("arbitrary: integer too large");
+    default:
+        throw std::bad_alloc();
+    }
+}
+
+template <class T>
+using if_integral = typename std::enable_if<std::is_integral<T>::value, int>::type;
+
+} // namespace detail
+
+// ---- dwhl ----
+
+// Arbitrary-precision integer owning its storage
+class dwhl {
+public:
+    dwhl() : dwhl(0) {}
+    template <class T, detail::if_integral<T> = 0>
+    dwhl(T val) : val_() {
+        detail::check(std::is_signed<T>::value ? dwhl_inits(&val_, val) : dwhl_initu(&val_, val));
+    }
+    dwhl(const dwhl &other) : val_() {
+        detail::check(dwhl_initi(&val_, &other.val_));
+    }
+    dwhl(dwhl &&other) noexcept : val_(other.val_) {
+        other.val_ = dwhl_t();
+    }
+
+    // Copies integer of the C interface
+    explicit dwhl(const dwhl_t *val) : val_() {
+        detail::check(dwhl_initi(&val_, val));
+    }
+
+    dwhl(const mul_expr &expr) : dwhl(expr.lhs) {
+        *this *= expr.rhs;
+    }
+    dwhl(const add_expr &expr) : dwhl(expr.lhs) {
+        detail::check(expr.sub ? dwhl_subeq(&val_, &expr.rhs.val_) : dwhl_addeq(&val_, &expr.rhs.val_));
+    }
+    dwhl(const addmul_expr &expr) : dwhl(expr.add) {
+        if (expr.neg)
+            detail::check(dwhl_negeq(&val_));
+        addmul(expr.lhs, expr.rhs, expr.sub);
+    }
+    dwhl(const mulsum_expr &expr) : dwhl(expr.lhs) {
+        addmul(expr.rhs.lhs, expr.rhs.rhs, expr.sub);
+    }
+
+    ~dwhl() {
+        dwhl_clr(&val_);
+    }
+
+    /* Takes ownership of temporary returned by the C interface, reusing its buffer
+     * Lvalues are copied */
+    static dwhl adopt(dwhl_t *tmp) {
+        dwhl ret;
+
+        detail::check(dwhl_eq_take(&ret.val_, tmp));
+        return ret;
+    }
+
+    // Returns integer of the C interface, valid until this is modified or destroyed
+    dwhl_t *get() noexcept {
+        return &val_;
+    }
+    const dwhl_t *get() const noexcept {
+        return &val_;
+    }
+
+    // -- Assignment --
+
+    dwhl &operator=(const dwhl &other) {
+        if (this != &other)
+            copy(other);
+        return *this;
+    }
+    dwhl &operator=(dwhl &&other) noexcept {
+        std::swap(val_, other.val_);
+        return *this;
+    }
+    template <class T, detail::if_integral<T> = 0>
+    dwhl &operator=(T val) {
+        if (!val_.bits)
+            return *this = dwhl(val);
+        detail::check(std::is_signed<T>::value ? dwhl_eqs(&val_, val) : dwhl_equ(&val_, val));
+        return *this;
+    }
+
+    dwhl &operator=(const mul_expr &expr) {
+        if (&expr.rhs == this)  // Multiplication commutes
+            detail::check(dwhl_muleq(&val_, &expr.lhs.val_));
+        else {
+            if (&expr.lhs != this)
+                copy(expr.lhs);
+            detail::check(dwhl_muleq(&val_, &expr.rhs.val_));
+        }
+        return *this;
+    }
+    dwhl &operator=(const add_expr &expr) {
+        if (&expr.lhs != this && &expr.rhs == this) {   // rhs would be overwritten by lhs
+            if (expr.sub)
+                detail::check(dwhl_negeq(&val_));
+            detail::check(dwhl_addeq(&val_, &expr.lhs.val_));
+            return *this;
+        }
+        if (&expr.lhs != this)
+            copy(expr.lhs);
+        detail::check(expr.sub ? dwhl_subeq(&val_, &expr.rhs.val_) : dwhl_addeq(&val_, &expr.rhs.val_));
+        return *this;
+    }
+    dwhl &operator=(const addmul_expr &expr) {
+        // Operands of product would be overwritten by the integer, or by its negation
+        if ((&expr.add != this || expr.neg) && (&expr.lhs == this || &expr.rhs == this))
+            return *this = dwhl(expr);
+        if (&expr.add != this)
+            copy(expr.add);
+        if (expr.neg)
+            detail::check(dwhl_negeq(&val_));
+        addmul(expr.lhs, expr.rhs, expr.sub);
+        return *this;
+    }
+    dwhl &operator=(const mulsum_expr &expr) {
+        if (&expr.rhs.lhs == this || &expr.rhs.rhs == this)    // Operands of rhs would be overwritten by lhs
+            return *this = dwhl(expr);
+        *this = expr.lhs;
+        addmul(expr.rhs.lhs, expr.rhs.rhs, expr.sub);
+        return *this;
+    }
+
+    // -- Compound Assignment --
+
+    dwhl &operator+=(const dwhl &val) {
+        detail::check(dwhl_addeq(&val_, &val.val_));
+        return *this;
+    }
+    dwhl &operator-=(const dwhl &val) {
+        detail::check(dwhl_subeq(&val_, &val.val_));
+        return *this;
+    }
+    dwhl &operator*=(const dwhl &val) {
+        detail::check(dwhl_muleq(&val_, &val.val_));
+        return *this;
+    }
+    dwhl &operator/=(const dwhl &val) {
+        detail::check(dwhl_diveq(&val_, &val.val_));
+        return *this;
+    }
+    dwhl &operator%=(const dwhl &val) {
+        detail::check(dwhl_modeq(&val_, &val.val_));
+        return *this;
+    }
+    dwhl &operator&=(const dwhl &val) {
+        detail::check(dwhl_andeq(&val_, &val.val_));
+        return *this;
+    }
+    dwhl &operator|=(const dwhl &val) {
+        detail::check(dwhl_oreq(&val_, &val.val_));
+        return *this;
+    }
+    dwhl &operator^=(const dwhl &val) {
+        detail::check(dwhl_xoreq(&val_, &val.val_));
+        return *this;
+    }
+    dwhl &operator<<=(shift_t shift) {
+        detail::check(dwhl_lshifteq(&val_, shift));
+        return *this;
+    }
+    dwhl &operator>>=(shift_t shift) {
+        detail::check(dwhl_rshifteq(&val_, shift));
+        return *this;
+    }
+
+    dwhl &operator+=(const mul_expr &expr) {
+        addmul(expr.lhs, expr.rhs, false);
+        return *this;
+    }
+    dwhl &operator-=(const mul_expr &expr) {
+        addmul(expr.lhs, expr.rhs, true);
+        return *this;
+    }
+
+    // Machine-integer operands use the scalar kernels, allocating nothing
+    template <class T, detail::if_integral<T> = 0>
+    dwhl &operator+=(T val) {
+        detail::check(std::is_signed<T>::value ? dwhl_addeqs(&val_, val) : dwhl_addequ(&val_, val));
+        return *this;
+    }
+    template <class T, detail::if_integral<T> = 0>
+    dwhl &operator-=(T val) {
+        detail::check(std::is_signed<T>::value ? dwhl_subeqs(&val_, val) : dwhl_subequ(&val_, val));
+        return *this;
+    }
+    template <class T, detail::if_integral<T> = 0>
+    dwhl &operator*=(T val) {
+        detail::check(std::is_signed<T>::value ? dwhl_muleqs(&val_, val) : dwhl_mulequ(&val_, val));
+        return *this;
+    }
+    template <class T, detail::if_integral<T> = 0>
+    dwhl &operator/=(T val) {
+        detail::check(std::is_signed<T>::value ? dwhl_diveqs(&val_, val) : dwhl_divequ(&val_, val));
+        return *this;
+    }
+    template <class T, detail::if_integral<T> = 0>
+    dwhl &operator%=(T val) {
+        detail::check(std::is_signed<T>::value ? dwhl_modeqs(&val_, val) : dwhl_modequ(&val_, val));
+        return *this;
+    }
+
+    // -- Queries --
+
+    bool isneg() const noexcept {
+        return dwhl_isneg(&val_);
+    }
+
+    // Returns -1, 0, or 1 as this is less than, equal to, or greater than val
+    int cmp(const dwhl &val) const noexcept {
+        return dwhl_cmp(&val_, &val.val_);
+    }
+    template <class T, detail::if_integral<T> = 0>
+    int cmp(T val) const noexcept {
+        return std::is_signed<T>::value ? dwhl_cmps(&val_, val) : dwhl_cmpu(&val_, val);
+    }
+
+    friend void swap(dwhl &lhs, dwhl &rhs) noexcept {
+        std::swap(lhs.val_, rhs.val_);
+    }
+
+private:
+    dwhl_t val_;
+
+    // Assigns value, reusing buffer if large enough
+    void copy(const dwhl &other) {
+        if (val_.bits)
+            detail::check(dwhl_eq(&val_, &other.val_));
+        else
+            detail::check(dwhl_initi(&val_, &other.val_));
+    }
+
+    // Adds or subtracts product in place
+    void addmul(const dwhl &lhs, const dwhl &rhs, bool sub) {
+        detail::check(sub ? dwhl_submuleq(&val_, &lhs.val_, &rhs.val_) : dwhl_addmuleq(&val_, &lhs.val_, &rhs.val_));
+    }
+};
+
+// ---- Operators ----
+
+inline mul_expr operator*(const dwhl &lhs, const dwhl &rhs) {
+    return {lhs, rhs};
+}
+inline add_expr operator+(const dwhl &lhs, const dwhl &rhs) {
+    return {lhs, rhs, false};
+}
+inline add_expr operator-(const dwhl &lhs, const dwhl &rhs) {
+    return {lhs, rhs, true};
+}
+inline addmul_expr operator+(const mul_expr &lhs, const dwhl &rhs) {
+    return {rhs, lhs.lhs, lhs.rhs, false, false};
+}
+inline addmul_expr operator-(const mul_expr &lhs, const dwhl &rhs) {
+    return {rhs, lhs.lhs, lhs.rhs, false, true};
+}
+inline addmul_expr operator+(const dwhl &lhs, const mul_expr &rhs) {
+    return {lhs, rhs.lhs, rhs.rhs, false, false};
+}
+inline addmul_expr operator-(const dwhl &lhs, const mul_expr &rhs) {
+    return {lhs, rhs.lhs, rhs.rhs, true, false};
+}
+inline mulsum_expr operator+(const mul_expr &lhs, const mul_expr &rhs) {
+    return {lhs, rhs, false};
+}
+inline mulsum_expr operator-(const mul_expr &lhs, const mul_expr &rhs) {
+    return {lhs, rhs, true};
+}
+
+// Left operand is taken by value, so an rvalue lends its buffer to the result
+inline dwhl operator/(dwhl lhs, const dwhl &rhs) {
+    lhs /= rhs;
+    return lhs;
+}
+inline dwhl operator%(dwhl lhs, const dwhl &rhs) {
+    lhs %= rhs;
+    return lhs;
+}
+inline dwhl operator&(dwhl lhs, const dwhl &rhs) {
+    lhs &= rhs;
+    return lhs;
+}
+inline dwhl operator|(dwhl lhs, const dwhl &rhs) {
+    lhs |= rhs;
+    return lhs;
+}
+inline dwhl operator^(dwhl lhs, const dwhl &rhs) {
+    lhs ^= rhs;
+    return lhs;
+}
+inline dwhl operator<<(dwhl lhs, shift_t shift) {
+    lhs <<= shift;
+    return lhs;
+}
+inline dwhl operator>>(dwhl lhs, shift_t shift) {
+    lhs >>= shift;
+    return lhs;
+}
+inline dwhl operator-(dwhl val) {
+    detail::check(dwhl_negeq(val.get()));
+    return val;
+}
+inline dwhl operator~(dwhl val) {
+    detail::check(dwhl_noteq(val.get()));
+    return val;
+}
+
+inline bool operator==(const dwhl &lhs, const dwhl &rhs) { return lhs.cmp(rhs) == 0; }
+inline bool operator!=(const dwhl &lhs, const dwhl &rhs) { return lhs.cmp(rhs) != 0; }
+inline bool operator<(const dwhl &lhs, const dwhl &rhs)  { return lhs.cmp(rhs) < 0;  }
+inline bool operator>(const dwhl &lhs, const dwhl &rhs)  { return lhs.cmp(rhs) > 0;  }
+inline bool operator<=(const dwhl &lhs, const dwhl &rhs) { return lhs.cmp(rhs) <= 0; }
+inline bool operator>=(const dwhl &lhs, const dwhl &rhs) { return lhs.cmp(rhs) >= 0; }
+
+// Comparisons with machine integers allocate nothing
+template <class T, detail::if_integral<T> = 0>
+inline bool operator==(const dwhl &lhs, T rhs) { return lhs.cmp(rhs) == 0; }
+template <class T, detail::if_integral<T> = 0>
+inline bool operator!=(const dwhl &lhs, T rhs) { return lhs.cmp(rhs) != 0; }
+template <class T, detail::if_integral<T> = 0>
+inline bool operator<(const dwhl &lhs, T rhs)  { return lhs.cmp(rhs) < 0;  }
+template <class T, detail::if_integral<T> = 0>
+inline bool operator>(const dwhl &lhs, T rhs)  { return lhs.cmp(rhs) > 0;  }
+template <class T, detail::if_integral<T> = 0>
+inline bool operator<=(const dwhl &lhs, T rhs) { return lhs.cmp(rhs) <= 0; }
+template <class T, detail::if_integral<T> = 0>
+inline bool operator>=(const dwhl &lhs, T rhs) { return lhs.cmp(rhs) >= 0; }
+
+} // namespace arbitrary
+
+#endif  // #ifndef LADLE_ARBITRARY_HPP
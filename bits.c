@@ -0,0 +1,205 @@
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#define PREFIX  dwhl
+
+/* Bit queries
+ *
+ * Integers are treated as two's complement with infinite sign extension,
+ * so negative integers have infinitely many set bits. Each query inspects
+ * one bitfield at a time, using single-instruction counts and scans.
+ * Population counts of long buffers use a nibble lookup table in AVX2
+ * registers, 32 bytes per step, where the processor supports it. */
+
+// ---- Helper Functions ----
+
+#if defined(__x86_64__)
+static size_t popcount_avx2(const bitfld_t *, const bitfld_t *, size_t);
+
+/* Returns # of set bits in buffer, or in XOR of two buffers if bp is not NULL
+ * Requires AVX2 */
+__attribute__((target("avx2")))
+size_t popcount_avx2(const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    const __m256i lut = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+    ), low = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0, ct;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (ap + i));
+
+        if (bp)
+            v = _mm256_xor_si256(v, _mm256_loadu_si256((const __m256i *) (bp + i)));
+
+        const __m256i cnt = _mm256_add_epi8(
+            _mm256_shuffle_epi8(lut, _mm256_and_si256(v, low)),
+            _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low))
+        );
+
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+    }
+    ct = (size_t) _mm256_extract_epi64(acc, 0) + (size_t) _mm256_extract_epi64(acc, 1)
+      + (size_t) _mm256_extract_epi64(acc, 2) + (size_t) _mm256_extract_epi64(acc, 3);
+    for (; i < n; ++i)
+        ct += bitfld_popcount(bp ? ap[i] ^ bp[i] : ap[i]);
+    return ct;
+}
+#endif
+
+// ---- Limb Kernels ----
+
+size_t ln_popcount(const bitfld_t *ap, size_t n) {
+    size_t ct = 0;
+
+#if defined(__x86_64__)
+    if (n >= POPCOUNT_AVX2_THRESHOLD && __builtin_cpu_supports("avx2"))
+        return popcount_avx2(ap, NULL, n);
+#endif
+    for (size_t i = 0; i < n; ++i)
+        ct += bitfld_popcount(ap[i]);
+    return ct;
+}
+
+size_t ln_hamdist(const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    size_t ct = 0;
+
+#if defined(__x86_64__)
+    if (n >= POPCOUNT_AVX2_THRESHOLD && __builtin_cpu_supports("avx2"))
+        return popcount_avx2(ap, bp, n);
+#endif
+    for (size_t i = 0; i < n; ++i)
+        ct += bitfld_popcount(ap[i] ^ bp[i]);
+    return ct;
+}
+
+// ---- Bit Queries ----
+
+export shift_t dwhl_popcount(const dwhl_t *val) {
+    if (!val) {
+        errno = EINVAL;
+        return 0;
+    }
+
+    return last_fld(val) & SIGN_BIT ? SHIFT_MAX : ln_popcount(val->bits, val->size);
+}
+
+export shift_t dwhl_hamdist(const dwhl_t *lhs, const dwhl_t *rhs) {
+    if (!lhs || !rhs) {
+        errno = EINVAL;
+        return 0;
+    }
+
+    const bool neg = last_fld(lhs) & SIGN_BIT;
+    shift_t tmp = SHIFT_MAX;
+
+    if (neg == (bool) (last_fld(rhs) & SIGN_BIT)) {
+        const dwhl_t *max = lhs->size > rhs->size ? lhs : rhs;
+        const size_t n = lhs->size > rhs->size ? rhs->size : lhs->size, tail = max->size - n;
+
+        // Shorter integer extends with bits equal to the sign of both
+        tmp = ln_hamdist(lhs->bits, rhs->bits, n);
+        tmp += neg ? tail * BITFLD_BITS - ln_popcount(max->bits + n, tail) : ln_popcount(max->bits + n, tail);
+    }
+    return tmp;
+}
+
+export shift_t dwhl_scan0(const dwhl_t *val, shift_t start) {
+    if (!val) {
+        errno = EINVAL;
+        return 0;
+    }
+
+    const bool neg = last_fld(val) & SIGN_BIT;
+    size_t at = start / BITFLD_BITS;
+    shift_t tmp = neg ? SHIFT_MAX : start;
+
+    if (at < val->size) {
+        bitfld_t cur = ~val->bits[at] & BITFLD_MAX << start % BITFLD_BITS;
+
+        // Nonnegative integers have a clear sign bit, so the scan always ends
+        while (!cur && ++at < val->size)
+            cur = ~val->bits[at];
+        tmp = cur ? at * BITFLD_BITS + bitfld_ctz(cur) : SHIFT_MAX;
+    }
+    return tmp;
+}
+export shift_t dwhl_scan1(const dwhl_t *val, shift_t start) {
+    if (!val) {
+        errno = EINVAL;
+        return 0;
+    }
+
+    const bool neg = last_fld(val) & SIGN_BIT;
+    size_t at = start / BITFLD_BITS;
+    shift_t tmp = neg ? start : SHIFT_MAX;
+
+    if (at < val->size) {
+        bitfld_t cur = val->bits[at] & BITFLD_MAX << start % BITFLD_BITS;
+
+        while (!cur && ++at < val->size)
+            cur = val->bits[at];
+        tmp = cur ? at * BITFLD_BITS + bitfld_ctz(cur) : SHIFT_MAX;
+    }
+    return tmp;
+}
+
+export size_t dwhl_sizeinbase(const dwhl_t *val, int base) {
+    if (!val) {
+        errno = EINVAL;
+        return 0;
+    }
+    if (base < 2 || base > 62) {
+        errno = EINVAL;
+        return 0;
+    }
+
+    const size_t n = ln_norm(val->bits, val->size);
+    size_t bits = n ? (n - 1) * BITFLD_BITS + bitfld_sig(val->bits[n - 1]) : 0, tmp;
+
+    /* Magnitude of negative integer is one more than its complement, c
+     * If c + 1 is a power of 2, magnitude has one more bit than c */
+    if (last_fld(val) & SIGN_BIT) {
+        size_t cn = val->size, ones = 0;
+
+        while (cn && val->bits[cn - 1] == BITFLD_MAX)
+            --cn;
+        bits = cn ? (cn - 1) * BITFLD_BITS + bitfld_sig(~val->bits[cn - 1]) : 0;
+        for (size_t i = 0; i < cn; ++i)
+            ones += bitfld_popcount(~val->bits[i]);
+        if (ones == bits)
+            ++bits;
+    }
+    if (!bits)
+        return 1;
+    if (!(base & (base - 1))) {
+        const unsigned width = bitfld_ctz(base);
+
+        tmp = (bits + width - 1) / width;
+    } else  // Never underestimates, and exceeds the exact count by at most one
+        tmp = (size_t) ((floatp_t) bits / log2l(base)) + 1;
+    return tmp;
+}
+
+export bool dwhl_tstbit(const dwhl_t *val, shift_t index) {
+    if (!val) {
+        errno = EINVAL;
+        return false;
+    }
+
+    const size_t at = index / BITFLD_BITS;
+
+    return at < val->size ? val->bits[at] >> index % BITFLD_BITS & 1 : last_fld(val) & SIGN_BIT;
+}
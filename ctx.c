@@ -0,0 +1,198 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#define PREFIX  dwhl
+
+/* Arithmetic contexts
+ *
+ * Without a context, every multiplication, division, and exponentiation
+ * allocates its scratch space on entry and frees it on return, and errors
+ * are reported through errno. A context instead holds one scratch arena,
+ * grown to the largest size yet requested and reused by every later call,
+ * so a thread repeating an operation of one size allocates only once.
+ * Errors are stored in the context, and errno is restored before returning.
+ *
+ * Thresholds are read from the context on every call and passed down to the
+ * limb kernels, so threads may tune the same operation differently. Decimal
+ * operations likewise take their powers of ten from the cache of radix powers
+ * named by the context. */
+
+// ---- Helper Functions ----
+
+static bitfld_t *arena(dwhl_ctx_t *, size_t);
+static void *fail(dwhl_ctx_t *, int);
+static void *leave(dwhl_ctx_t *, void *, int);
+
+/* Returns scratch space of at least n bitfields, growing arena of context if needed
+ * Contents are not preserved across growth
+ * Returns NULL and sets errno on allocation failure */
+bitfld_t *arena(dwhl_ctx_t *ctx, size_t n) {
+    if (ctx->scratch_size >= n)
+        return ctx->scratch;
+
+    // Grows by at least half, so slowly increasing sizes do not reallocate every call
+    const size_t grown = ctx->scratch_size + ctx->scratch_size / 2, size = n > grown ? n : grown;
+
+    if (size > SIZE_MAX / sizeof(bitfld_t)) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    ctx->free_fn(ctx->scratch);
+    ctx->scratch_size = 0;
+    if (!(ctx->scratch = ctx->realloc_fn(NULL, size * sizeof(bitfld_t)))) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    ctx->scratch_size = size;
+    return ctx->scratch;
+}
+
+// Reports error in context, or through errno if there is none
+void *fail(dwhl_ctx_t *ctx, int err) {
+    if (ctx)
+        ctx->err = err;
+    else
+        errno = err;
+    return NULL;
+}
+
+/* Moves error raised by operation from errno to context, then restores errno
+ * Returns result of operation */
+void *leave(dwhl_ctx_t *ctx, void *tmp, int saved) {
+    if (!tmp)
+        ctx->err = errno ? errno : ENOMEM;
+    errno = saved;
+    return tmp;
+}
+
+// ---- Contexts ----
+
+export dwhl_ctx_t *dwhl_ctx_init(dwhl_ctx_t *ctx) {
+    if (!ctx) {
+        errno = EINVAL;
+        return NULL;
+    }
+    *ctx = (dwhl_ctx_t) {realloc, free, NULL, 0, ln_tune, 0, NULL};
+    return ctx;
+}
+
+export void dwhl_ctx_clr(dwhl_ctx_t *ctx) {
+    if (ctx) {
+        ctx->free_fn(ctx->scratch);
+        ctx->scratch = NULL;
+        ctx->scratch_size = 0;
+    }
+}
+
+export dwhl_t *dwhl_diveq_ctx(dwhl_ctx_t *ctx, dwhl_t *tar, const dwhl_t *val) {
+    if (!ctx || !tar || !val)
+        return fail(ctx, EINVAL);
+    assert_lval(tar);
+
+    const int saved = errno;
+    bitfld_t *tp;
+    dwhl_t *tmp;
+
+    errno = 0;
+    tp = arena(ctx, div_itch(tar, val));
+    tmp = tp ? do_div(tar, val, false, tp) : NULL;
+    return leave(ctx, tmp, saved);
+}
+export dwhl_t *dwhl_modeq_ctx(dwhl_ctx_t *ctx, dwhl_t *tar, const dwhl_t *val) {
+    if (!ctx || !tar || !val)
+        return fail(ctx, EINVAL);
+    assert_lval(tar);
+
+    const int saved = errno;
+    bitfld_t *tp;
+    dwhl_t *tmp;
+
+    errno = 0;
+    tp = arena(ctx, div_itch(tar, val));
+    tmp = tp ? do_div(tar, val, true, tp) : NULL;
+    return leave(ctx, tmp, saved);
+}
+export dwhl_t *dwhl_muleq_ctx(dwhl_ctx_t *ctx, dwhl_t *tar, const dwhl_t *val) {
+    if (!ctx || !tar || !val)
+        return fail(ctx, EINVAL);
+    assert_lval(tar);
+
+    const int saved = errno;
+    bitfld_t *tp = NULL;
+    dwhl_t *tmp;
+    size_t itch;
+
+    errno = 0;
+    if ((itch = mul_itch(tar, val, &ctx->tune)))
+        tp = arena(ctx, itch);
+    tmp = tp ? do_mul(tar, val, tp, &ctx->tune) : NULL;
+    return leave(ctx, tmp, saved);
+}
+
+export dwhl_t *dwhl_powmeq_ctx(dwhl_ctx_t *ctx, dwhl_t *tar, const dwhl_t *exp, const dwhl_t *mod) {
+    if (!ctx || !tar || !exp || !mod)
+        return fail(ctx, EINVAL);
+    assert_lval(tar);
+
+    const int saved = errno;
+    bitfld_t *tp;
+    dwhl_t *tmp;
+
+    errno = 0;
+    tp = arena(ctx, powm_itch(tar, exp, mod, &ctx->tune));
+    tmp = tp ? do_powm(tar, exp, mod, tp, &ctx->tune) : NULL;
+    return leave(ctx, tmp, saved);
+}
+
+export ddec_t *ddec_addeq_ctx(dwhl_ctx_t *ctx, ddec_t *tar, const ddec_t *val) {
+    if (!ctx || !tar || !val)
+        return fail(ctx, EINVAL);
+
+    const int saved = errno;
+
+    errno = 0;
+    return leave(ctx, add_scaled(tar, val, false, ctx->rpow), saved);
+}
+export ddec_t *ddec_diveq_ctx(dwhl_ctx_t *ctx, ddec_t *tar, const ddec_t *val) {
+    if (!ctx || !tar || !val)
+        return fail(ctx, EINVAL);
+
+    const int saved = errno;
+
+    errno = 0;
+    return leave(ctx, div_scaled(tar, val, ctx->rpow), saved);
+}
+export ddec_t *ddec_muleq_ctx(dwhl_ctx_t *ctx, ddec_t *tar, const ddec_t *val) {
+    if (!ctx || !tar || !val)
+        return fail(ctx, EINVAL);
+
+    const int saved = errno;
+
+    errno = 0;
+    return leave(ctx, mul_scaled(tar, val, ctx->rpow), saved);
+}
+export ddec_t *ddec_rescale_ctx(dwhl_ctx_t *ctx, ddec_t *tar, size_t scale) {
+    if (!ctx || !tar)
+        return fail(ctx, EINVAL);
+
+    const int saved = errno;
+
+    errno = 0;
+    return leave(ctx, do_rescale(tar, scale, ctx->rpow), saved);
+}
+export ddec_t *ddec_subeq_ctx(dwhl_ctx_t *ctx, ddec_t *tar, const ddec_t *val) {
+    if (!ctx || !tar || !val)
+        return fail(ctx, EINVAL);
+
+    const int saved = errno;
+
+    errno = 0;
+    return leave(ctx, add_scaled(tar, val, true, ctx->rpow), saved);
+}
@@ -1,18 +1,391 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include <ladle/common/lib.h>
-#include <ladle/common/ptrcmp.h>
 
-#include "etc.h"
 #include "arbitrary.h"
+#include "etc.h"
 
 #define PREFIX  ddec
 
+/* Fixed-point decimals
+ *
+ * A decimal is an integer coefficient scaled by a power of ten chosen per value,
+ * so sums, differences, and comparisons of decimals of equal scale are integer
+ * operations on their coefficients. Operations storing into a decimal keep its
+ * scale. Where the exact result needs more decimal places, it is formed as one
+ * integer quotient by a power of ten, or by the divisor, and the remainder alone
+ * decides the rounding, so a result is rounded once however many digits it drops.
+ *
+ * Powers of ten are multiplied from those kept in the shared cache of radix
+ * powers, or in that of a context; scales below 20 use the single-bitfield
+ * kernels instead. */
+
 // ---- Constants ----
 
 // Convenience constants
-export const ddec_t *const ddec_one  = &(ddec_t) {/* TODO */};
-export const ddec_t *const ddec_zero = &(ddec_t) {/* TODO */};
+export const ddec_t *const ddec_one  = &(const ddec_t) DDEC_LITERAL(0, 1);
+export const ddec_t *const ddec_zero = &(const ddec_t) DDEC_LITERAL(0, 0);
+
+// # of powers of ten fitting one bitfield
+#define POW10_CT    20
 
-// Maximum value to be multiplied by
-static ddec_t *ddec_maxmul = &(ddec_t) {/* TODO */};
+// Powers of ten fitting one bitfield
+static const bitfld_t pow10_tab[POW10_CT] = {
+    1ULL,                   10ULL,                  100ULL,                 1000ULL,
+    10000ULL,               100000ULL,              1000000ULL,             10000000ULL,
+    100000000ULL,           1000000000ULL,          10000000000ULL,         100000000000ULL,
+    1000000000000ULL,       10000000000000ULL,      100000000000000ULL,     1000000000000000ULL,
+    10000000000000000ULL,   100000000000000000ULL,  1000000000000000000ULL, 10000000000000000000ULL
+};
 
 // ---- Helper Functions ----
+
+static dwhl_t *round_div(dwhl_t *, bitfld_t *, size_t, const bitfld_t *, size_t, bool, int);
+
+/* Assigns quotient of magnitudes n / d to tar, negated if `neg', rounded once by rules
+ * Requires d normalized and nonzero; n is destroyed
+ * Returns NULL and sets errno on internal error */
+dwhl_t *round_div(dwhl_t *tar, bitfld_t *np, size_t nn, const bitfld_t *dp, size_t dn, bool neg, int rules) {
+    const size_t qn = nn < dn ? 0 : nn - dn + 1;
+    bitfld_t *const qp = malloc((qn + 1 + 2 * dn + (qn ? ln_divrem_itch(nn, dn) : 0)) * sizeof(bitfld_t));
+    bitfld_t *const hp = qp + qn + 1, *rp = np;
+    bool up = false;
+    dwhl_t *tmp;
+
+    if (!qp)
+        return NULL;
+    if (qn)
+        ln_divrem(qp, np, nn, dp, dn, hp + 2 * dn);
+    else {  // Quotient is 0, remainder is n, widened to size of d
+        rp = hp + dn;
+        memcpy(rp, np, nn * sizeof(bitfld_t));
+        memset(rp + nn, 0, (dn - nn) * sizeof(bitfld_t));
+    }
+
+    // Quotient is truncated; remainder decides whether its magnitude goes up by 1
+    switch (rules) {
+    case AF_ROUND:  // Remainder is at least half of divisor
+        ln_sub_n(hp, dp, rp, dn);
+        up = ln_cmp(rp, hp, dn) >= 0;
+        break;
+    case AF_FLOOR:
+        up = neg && ln_norm(rp, dn);
+        break;
+    case AF_CEIL:
+        up = !neg && ln_norm(rp, dn);
+        break;
+    }
+    qp[qn] = qn ? ln_add_1(qp, qp, qn, up) : up;
+    tmp = set_abs(tar, qp, qn + 1, neg);
+    free(qp);
+    return tmp;
+}
+
+ddec_t *add_scaled(ddec_t *tar, const ddec_t *val, bool sub, dwhl_rpow_cache_t *cache) {
+    dwhl_t *(*const op)(dwhl_t *, const dwhl_t *) = sub ? dwhl_subeq : dwhl_addeq;
+    dwhl_t cpy;
+    bool ok;
+
+    if (tar->scale == val->scale)
+        return op(&tar->coef, &val->coef) ? tar : NULL;
+    if (tar->scale > val->scale) {
+        ok = dwhl_initi(&cpy, &val->coef) && mul_pow10(&cpy, tar->scale - val->scale, cache) && op(&tar->coef, &cpy);
+    } else {
+        const size_t k = val->scale - tar->scale;
+
+        ok = dwhl_initi(&cpy, &tar->coef) && mul_pow10(&cpy, k, cache) && op(&cpy, &val->coef)
+          && div_pow10(&tar->coef, &cpy, k, tar->rules, cache);
+    }
+    dwhl_clr(&cpy);
+    return ok ? tar : NULL;
+}
+
+ddec_t *div_scaled(ddec_t *tar, const ddec_t *val, dwhl_rpow_cache_t *cache) {
+    /* Quotient at scale of tar is (a 10^-s) / (b 10^-t) 10^s = a 10^t / b,
+     * formed as one integer division */
+    const size_t an = tar->coef.size, bn = val->coef.size, pn = rpow_size(10, val->scale);
+    const bool neg = ddec_isneg(tar) != ddec_isneg(val);
+
+    if (an + pn > BITFLD_CT_MAX) {  // Integer too large
+        errno = ERANGE;
+        return NULL;
+    }
+
+    bitfld_t *const ap = malloc((2 * an + bn + 2 * pn + ln_mul_itch(an, pn)) * sizeof(bitfld_t));
+    bitfld_t *const bp = ap + an, *const pp = bp + bn, *const np = pp + pn, *const tp = np + an + pn;
+    size_t nn, dn, en;
+    dwhl_t *tmp = NULL;
+
+    if (!ap)
+        return NULL;
+    nn = get_abs(ap, &tar->coef);
+    if (!(dn = get_abs(bp, &val->coef)))
+        errno = EDOM;
+    else if ((en = rpow_get(pp, 10, val->scale, cache))) {
+        if (en == 1) {
+            np[nn] = ln_mul_1(np, ap, nn, pp[0]);
+            ++nn;
+        } else if (nn) {
+            ln_mul(np, ap, nn, pp, en, tp);
+            nn += en;
+        }
+        tmp = round_div(&tar->coef, np, ln_norm(np, nn), bp, dn, neg, tar->rules);
+    }
+    free(ap);
+    return tmp ? tar : NULL;
+}
+
+ddec_t *do_rescale(ddec_t *tar, size_t scale, dwhl_rpow_cache_t *cache) {
+    if (scale < tar->scale ? !div_pow10(&tar->coef, &tar->coef, tar->scale - scale, tar->rules, cache)
+      : !mul_pow10(&tar->coef, scale - tar->scale, cache))
+        return NULL;
+    tar->scale = scale;
+    return tar;
+}
+
+ddec_t *mul_scaled(ddec_t *tar, const ddec_t *val, dwhl_rpow_cache_t *cache) {
+    if (!val->scale)
+        return dwhl_muleq(&tar->coef, &val->coef) ? tar : NULL;
+
+    // Product holds the decimal places of both operands, of which those of val are dropped in one rounding
+    const size_t an = tar->coef.size, bn = val->coef.size, pn = rpow_size(10, val->scale);
+    const bool neg = ddec_isneg(tar) != ddec_isneg(val);
+
+    if (an + bn > BITFLD_CT_MAX || pn > BITFLD_CT_MAX) {    // Integer too large
+        errno = ERANGE;
+        return NULL;
+    }
+
+    bitfld_t *const ap = malloc((2 * (an + bn) + pn + ln_mul_itch(an, bn)) * sizeof(bitfld_t));
+    bitfld_t *const bp = ap + an, *const rp = bp + bn, *const pp = rp + an + bn, *const tp = pp + pn;
+    size_t rn = 0, en;
+    dwhl_t *tmp = NULL;
+
+    if (!ap)
+        return NULL;
+    const size_t na = get_abs(ap, &tar->coef), nb = get_abs(bp, &val->coef);
+
+    if (na && nb) {
+        ln_mul(rp, ap, na, bp, nb, tp);
+        rn = ln_norm(rp, na + nb);
+    }
+    if ((en = rpow_get(pp, 10, val->scale, cache)))
+        tmp = round_div(&tar->coef, rp, rn, pp, en, neg, tar->rules);
+    free(ap);
+    return tmp ? tar : NULL;
+}
+
+dwhl_t *div_pow10(dwhl_t *tar, const dwhl_t *val, size_t k, int rules, dwhl_rpow_cache_t *cache) {
+    if (!k)
+        return tar == val ? tar : dwhl_eq(tar, val);
+    if (rpow_size(10, k) > BITFLD_CT_MAX) { // Integer too large
+        errno = ERANGE;
+        return NULL;
+    }
+
+    const bool neg = last_fld(val) & SIGN_BIT;
+    bitfld_t *const np = malloc((val->size + rpow_size(10, k)) * sizeof(bitfld_t)), *const dp = np + val->size;
+    const size_t nn = np ? get_abs(np, val) : 0, dn = np ? rpow_get(dp, 10, k, cache) : 0;
+    dwhl_t *const tmp = dn ? round_div(tar, np, nn, dp, dn, neg, rules) : NULL;
+
+    free(np);
+    return tmp;
+}
+
+dwhl_t *mul_pow10(dwhl_t *tar, size_t k, dwhl_rpow_cache_t *cache) {
+    if (k < POW10_CT)
+        return k ? dwhl_mulequ(tar, pow10_tab[k]) : tar;
+    if (rpow_size(10, k) >= BITFLD_CT_MAX) {    // Integer too large
+        errno = ERANGE;
+        return NULL;
+    }
+
+    bitfld_t *const pp = malloc((rpow_size(10, k) + 1) * sizeof(bitfld_t));
+    dwhl_t *tmp;
+    size_t n;
+
+    if (!pp || !(n = rpow_get(pp, 10, k, cache))) {
+        free(pp);
+        return NULL;
+    }
+    pp[n] = 0;  // Sign bitfield
+    tmp = dwhl_muleq(tar, &(const dwhl_t) {pp, n + 1, false, NULL});
+    free(pp);
+    return tmp;
+}
+
+// ---- Basic Utilities ----
+
+export int ddec_cmp(const ddec_t *lhs, const ddec_t *rhs) {
+    if (!lhs || !rhs) {
+        errno = EINVAL;
+        return 2;
+    }
+    if (lhs->scale == rhs->scale)
+        return dwhl_cmp(&lhs->coef, &rhs->coef);
+
+    const bool neg = ddec_isneg(lhs);
+
+    if (neg != ddec_isneg(rhs))
+        return neg ? -1 : 1;
+
+    // Coefficient with fewer decimal places is brought to scale of the other
+    const ddec_t *const min = lhs->scale < rhs->scale ? lhs : rhs, *const max = min == lhs ? rhs : lhs;
+    dwhl_t cpy;
+    int tmp = 2;
+
+    if (dwhl_initi(&cpy, &min->coef) && mul_pow10(&cpy, max->scale - min->scale, NULL))
+        tmp = min == lhs ? dwhl_cmp(&cpy, &rhs->coef) : dwhl_cmp(&lhs->coef, &cpy);
+    dwhl_clr(&cpy);
+    return tmp;
+}
+export ddec_t *ddec_eq(ddec_t *restrict tar, const ddec_t *restrict val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (val->scale > tar->scale)
+        return div_pow10(&tar->coef, &val->coef, val->scale - tar->scale, tar->rules, NULL) ? tar : NULL;
+    return dwhl_eq(&tar->coef, &val->coef) && mul_pow10(&tar->coef, tar->scale - val->scale, NULL) ? tar : NULL;
+}
+export ddec_t *ddec_eqi(ddec_t *restrict tar, const dwhl_t *restrict val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return dwhl_eq(&tar->coef, val) && mul_pow10(&tar->coef, tar->scale, NULL) ? tar : NULL;
+}
+export ddec_t *ddec_eqs(ddec_t *restrict tar, integr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return dwhl_eqs(&tar->coef, val) && mul_pow10(&tar->coef, tar->scale, NULL) ? tar : NULL;
+}
+export ddec_t *ddec_equ(ddec_t *restrict tar, uintegr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return dwhl_equ(&tar->coef, val) && mul_pow10(&tar->coef, tar->scale, NULL) ? tar : NULL;
+}
+export ddec_t *ddec_initc(ddec_t *restrict tar, const dwhl_t *restrict coef, size_t scale) {
+    if (!tar || !coef) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (!dwhl_initi(&tar->coef, coef))
+        return NULL;
+    tar->scale = scale;
+    tar->rules = AF_NULL;
+    return tar;
+}
+export ddec_t *ddec_initf(ddec_t *restrict tar, const ddec_t *restrict val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (!dwhl_initi(&tar->coef, &val->coef))
+        return NULL;
+    tar->scale = val->scale;
+    tar->rules = val->rules;
+    return tar;
+}
+export ddec_t *ddec_initi(ddec_t *restrict tar, const dwhl_t *restrict val, size_t scale) {
+    if (!ddec_initc(tar, val, scale))
+        return NULL;
+    if (!mul_pow10(&tar->coef, scale, NULL)) {
+        dwhl_clr(&tar->coef);
+        return NULL;
+    }
+    return tar;
+}
+export ddec_t *ddec_inits(ddec_t *restrict tar, integr_t val, size_t scale) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (!dwhl_inits(&tar->coef, val))
+        return NULL;
+    if (!mul_pow10(&tar->coef, scale, NULL)) {
+        dwhl_clr(&tar->coef);
+        return NULL;
+    }
+    tar->scale = scale;
+    tar->rules = AF_NULL;
+    return tar;
+}
+export ddec_t *ddec_initu(ddec_t *restrict tar, uintegr_t val, size_t scale) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (!dwhl_initu(&tar->coef, val))
+        return NULL;
+    if (!mul_pow10(&tar->coef, scale, NULL)) {
+        dwhl_clr(&tar->coef);
+        return NULL;
+    }
+    tar->scale = scale;
+    tar->rules = AF_NULL;
+    return tar;
+}
+export bool ddec_isneg(const ddec_t *restrict val) {
+    return dwhl_isneg(&val->coef);
+}
+export ddec_t *ddec_rescale(ddec_t *tar, size_t scale) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return do_rescale(tar, scale, NULL);
+}
+
+// ---- Basic Arithmetic ----
+
+export ddec_t *ddec_abseq(ddec_t *tar) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return dwhl_abseq(&tar->coef) ? tar : NULL;
+}
+export ddec_t *ddec_addeq(ddec_t *tar, const ddec_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return add_scaled(tar, val, false, NULL);
+}
+export ddec_t *ddec_negeq(ddec_t *tar) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return dwhl_negeq(&tar->coef) ? tar : NULL;
+}
+export ddec_t *ddec_subeq(ddec_t *tar, const ddec_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return add_scaled(tar, val, true, NULL);
+}
+
+export ddec_t *ddec_diveq(ddec_t *tar, const ddec_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return div_scaled(tar, val, NULL);
+}
+export ddec_t *ddec_muleq(ddec_t *tar, const ddec_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return mul_scaled(tar, val, NULL);
+}
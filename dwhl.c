@@ -1,5 +1,8 @@
 #include <errno.h>
+#include <float.h>
 #include <limits.h>
+#include <math.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -13,232 +16,302 @@
 
 #define PREFIX  dwhl
 
-// TODO find EVERY instance of a possible `rvalue' integer being used in implementation function
-// Code workaround so rvalue can be used without freeing itself
-
 // ---- Constants ----
 
-// Number of bits within a bitfield
-#define BITFLD_BITS     (sizeof(bitfld_t) * 8)
-
-/* Maximum number of bitfields a bit buffer may hold
- * Ensures # of total bits representable as shift_t */
-#define BITFLD_CT_MAX   (SHIFT_MAX / (sizeof(bitfld_t) * 8))
-
-// Maximum val of a bitfield
-#define BITFLD_MAX      UINTMAX_MAX
-
-// For last field in an integer or float, the position of the sign bit
-#define SIGN_BIT        ((bitfld_t) 1 << sizeof(bitfld_t) * 8 - 1)
-
 // Convenience constants
-export const dwhl_t *const dwhl_one  = &(dwhl_t) {(bitfld_t[]) {1}, 1, false};
-export const dwhl_t *const dwhl_zero = &(dwhl_t) {(bitfld_t[]) {0}, 1, false};
+export const dwhl_t *const dwhl_one  = &(const dwhl_t) DWHL_LITERAL(1);
+export const dwhl_t *const dwhl_zero = &(const dwhl_t) DWHL_LITERAL(0);
+
+// ---- Types ----
 
-// Maximum value to be multiplied by
-static dwhl_t *maxmul = &(dwhl_t) {/* TODO find value */};
+// Count of integers sharing a bit buffer, freed with it
+struct dwhl_refs {
+    atomic_size_t n;
+};
 
 // ---- Helper Functions ----
 
-static dwhl_t *do_div(dwhl_t *, const dwhl_t *, bool);
+static dwhl_t *disown(dwhl_t *, size_t);
+static dwhl_t *do_add(dwhl_t *, const dwhl_t *, bool);
+static dwhl_t *do_addmul(dwhl_t *, const dwhl_t *, const dwhl_t *, bool);
+static dwhl_t *do_logic(dwhl_t *, const dwhl_t *, char);
 static dwhl_t *do_lshift(dwhl_t *, shift_t, bitfld_t);
-static dwhl_t *do_mul(dwhl_t *, dwhl_t *);
-static dwhl_t *extend(dwhl_t *tar, size_t resize);
-static dwhl_t *max_sig(const dwhl_t *, const dwhl_t *);
-static shift_t padding(const dwhl_t *);
+static dwhl_t *heap_div(dwhl_t *, const dwhl_t *, bool);
+static dbitfld_t round_abs(const dwhl_t *, unsigned, shift_t *);
+#ifndef NDEBUG
+static bool is_exact(const dwhl_t *, const bitfld_t *, size_t, const bitfld_t *, size_t);
+#endif
+static void low_flds(bitfld_t *, const dwhl_t *, size_t);
+static size_t mulhi_size(size_t, size_t, shift_t);
 static shift_t sig_bits(const dwhl_t *);
 
-static inline void clr_rval(const dwhl_t *, bool);
-static inline bool get_bit(const dwhl_t *, shift_t);
-static inline bool is_rval(const dwhl_t *);
-static inline bitfld_t insig_val(const dwhl_t *);
-static inline bitfld_t peek(const dwhl_t *, size_t);
-static inline bitfld_t last_fld(const dwhl_t *);
+static inline bitfld_t abs_fld(const dwhl_t *, size_t, size_t, bool);
 static inline dwhl_t *max_sz(const dwhl_t *, const dwhl_t *);
-static inline dwhl_t *min_sz(const dwhl_t *, const dwhl_t *);
-static inline dwhl_t *set_bit(dwhl_t *, shift_t, bool);
 
-// Performs division, stores result in tar
-dwhl_t *do_div(dwhl_t *tar, const dwhl_t *val, bool rem) {
+/* Drops reference of integer to shared bit buffer before it is overwritten, giving it a private
+ * buffer of `size' bitfields with unspecified contents instead
+ * Integer keeps sharing the buffer if allocation fails */
+dwhl_t *disown(dwhl_t *tar, size_t size) {
+    bitfld_t *const bits = malloc(size * sizeof(bitfld_t));
+
+    if (!bits)
+        return NULL;
+    dwhl_release(tar);
+    tar->bits = bits;
+    tar->size = size;
+    tar->refs = NULL;
+    return tar;
+}
+
+/* Adds or subtracts integer in two's complement, stores result in tar
+ * Shorter integer is sign-extended to length of longer integer */
+dwhl_t *do_add(dwhl_t *tar, const dwhl_t *val, bool sub) {
     if (!tar || !val) {
         errno = EINVAL;
         return NULL;
     }
     assert_lval(tar);
+    own_bits(tar);
 
-    dwhl_t *tmp;
-    const bool val_rval = is_rval(val);
+    const bitfld_t val_ext = sign_ext(val);
+    const size_t val_n = val->size;
 
-    if (!dwhl_cmp(val, dwhl_zero)) {
-        clr_rval(val, val_rval);
-        errno = EDOM;
+    if (tar->size < val_n && !extend(tar, val_n))
         return NULL;
-    }
-    if (!dwhl_cmp(tar, dwhl_zero)) {
-        clr_rval(val, val_rval);
-        return tar;
-    }
-    switch (dwhl_cmp(tar, val)) {
-    case -1:
-        tmp = dwhl_eq(tar, rem ? val : dwhl_zero);
-        clr_rval(val, val_rval);
-        return tmp;
-    case  0:
-        tmp = dwhl_eq(tar, rem ? dwhl_zero : dwhl_one);
-        clr_rval(val, val_rval);
-        return tmp;
-    }
 
-    dwhl_t *tar_abs = dwhl_abs(tar), *val_abs;
+    const bitfld_t tar_ext = sign_ext(tar);
+    bitfld_t *const high = tar->bits + val_n;
+    const size_t high_n = tar->size - val_n;
+    bitfld_t carry, ext;
+
+    /* Sign extension of val is B^high_n - 1 over high bitfields of tar
+     * Adding it subtracts 1 from them and carries out 1; subtracting it does the reverse */
+    if (sub) {
+        carry = ln_sub_n(tar->bits, tar->bits, val->bits, val_n);
+        if (!val_ext)
+            carry = ln_sub_1(high, high, high_n, carry);
+        else if (!carry)
+            carry = !ln_add_1(high, high, high_n, 1);
+        ext = tar_ext - val_ext - carry;
+    } else {
+        carry = ln_add_n(tar->bits, tar->bits, val->bits, val_n);
+        if (!val_ext)
+            carry = ln_add_1(high, high, high_n, carry);
+        else if (!carry)
+            carry = !ln_sub_1(high, high, high_n, 1);
+        ext = tar_ext + val_ext + carry;
+    }
+    return put_top(tar, ext, ext & SIGN_BIT);
+}
 
-    if (!tar_abs) {
-        clr_rval(val, val_rval);
+/* Adds or subtracts product of lhs and rhs, stores result in tar
+ * Product is formed in scratch space on the heap, so operands may alias tar */
+dwhl_t *do_addmul(dwhl_t *tar, const dwhl_t *lhs, const dwhl_t *rhs, bool sub) {
+    if (!tar || !lhs || !rhs) {
+        errno = EINVAL;
         return NULL;
     }
-    val_abs = dwhl_abs(val);
-    if (!val_abs) {
-        clr_rval(val, val_rval);
-        clr_rval(tar_abs, true);
+    assert_lval(tar);
+
+    const size_t asize = lhs->size, bsize = rhs->size;
+
+    if (asize + bsize >= BITFLD_CT_MAX) {  // Integer too large
+        errno = ERANGE;
         return NULL;
     }
-    tar_abs->rval = false;
-    val_abs->rval = false;
 
-    shift_t cur = sig_bits(tar_abs) - sig_bits(val_abs);
+    const bool neg = (last_fld(lhs) ^ last_fld(rhs)) & SIGN_BIT;
+    const size_t itch = lhs == rhs ? ln_sqr_itch(asize) : ln_mul_itch(asize, bsize);
+    bitfld_t *const ap = malloc((2 * (asize + bsize) + 1 + itch) * sizeof(bitfld_t)),
+      *const bp = ap + asize, *const rp = bp + bsize, *const ts = rp + asize + bsize + 1;
+    size_t an, bn;
+    dwhl_t *tmp = tar;
 
-    dwhl_swp(tar, dwhl_rshifteq(tar_abs, cur));
-    dwhl_andeq(tar_abs, dwhl_slshift(dwhl_zero, cur));
-    if (errno) {
-        clr_rval(val, val_rval);
-        clr_rval(tar_abs, true);
-        clr_rval(val_abs, true);
+    if (!ap)
         return NULL;
+    an = get_abs(ap, lhs);
+    bn = lhs == rhs ? an : get_abs(bp, rhs);
+    if (an && bn) {
+        if (lhs == rhs)
+            ln_sqr(rp, ap, an, ts);
+        else
+            ln_mul(rp, ap, an, bp, bn, ts);
+
+        // Product, with a bitfield for its sign, is read as an integer in two's complement
+        rp[an + bn] = 0;
+        if (neg) {
+            ln_com(rp, rp, an + bn + 1);
+            ln_add_1(rp, rp, an + bn + 1, 1);
+        }
+        tmp = do_add(tar, &(dwhl_t) {rp, an + bn + 1, false, NULL}, sub);
     }
-    for (;;) {
-        dwhl_subeq(tar, dwhl_muleq(set_bit(tar_abs, cur + 1,
-            dwhl_cmp(tar, val_abs) < 0 ? 0 : 1   // Primitive division
-        ), val_abs));
-        if (!cur)
-            break;
-        dwhl_lshifteq(tar, 1);
-        tar->bits[0] |= get_bit(tar_abs, --cur);
-    }
-    if (errno)
-        tmp = NULL;
-    else if (rem)
-        tmp = dwhl_isneg(val) ? dwhl_negeq(tar) : tar;
-    else {
-        if (dwhl_isneg(tar) ^ dwhl_isneg(val))
-            dwhl_negeq(tar_abs);
-        tmp = dwhl_swp(tar, tar_abs);
-    }
-    clr_rval(val, val_rval);
-    clr_rval(tar_abs, true);
-    clr_rval(val_abs, true);
+    free(ap);
     return tmp;
 }
 
-// Performs left shift, stores result in tar
-dwhl_t *do_lshift(dwhl_t *tar, shift_t shift, bitfld_t fill) {
-    if (!tar) {
+/* Performs bitwise operation ('&', '|', or '^'), stores result in tar
+ * Shorter integer is sign-extended to length of longer integer */
+dwhl_t *do_logic(dwhl_t *tar, const dwhl_t *val, char op) {
+    if (!tar || !val) {
         errno = EINVAL;
         return NULL;
     }
     assert_lval(tar);
+    own_bits(tar);
 
-    const shdiv_t result = sh_div(shift, BITFLD_BITS);
-    const shift_t move = result.quot, pad = padding(tar);
-
-    if (shift > pad) {
-        shift_t add = (shift - pad) / BITFLD_BITS;
-
-        add += ((shift - pad) % BITFLD_BITS) != 0;
-        if (tar->size > BITFLD_CT_MAX - add - 1) {   // Result too large
-            errno = ERANGE;
-            return NULL;
-        }
-        extend(tar, tar->size + add);
-        if (errno)
-            return NULL;
-    }
-
-    bitfld_t carry = 0, tmp;
+    const bool val_neg = last_fld(val) & SIGN_BIT;
 
-    shift = result.rem;
-    memmove(tar->bits + move, tar->bits, (tar->size - move) * sizeof(bitfld_t));
-    memset(tar->bits, (int) fill, move * sizeof(bitfld_t));
-    for (size_t i = move, lim = tar->size; i < lim; ++i) {
-        // Get carry
-        tmp = (tar->bits[i] & ~(BITFLD_MAX >> shift)) >> BITFLD_BITS - shift;
-
-        // Apply carry
-        tar->bits[i] = (tar->bits[i] << shift) | carry;
+    if (tar->size < val->size && !extend(tar, val->size))
+        return NULL;
 
-        if (i == move)
-            tar->bits[i] |= fill >> (sizeof(bitfld_t) * 8 - shift);
-        carry = tmp;
+    bitfld_t *const high = tar->bits + val->size;
+    const size_t high_n = tar->size - val->size;
+
+    switch (op) {
+    case '&':
+        ln_and_n(tar->bits, tar->bits, val->bits, val->size);
+        if (!val_neg)
+            memset(high, 0, high_n * sizeof(bitfld_t));
+        break;
+    case '|':
+        ln_ior_n(tar->bits, tar->bits, val->bits, val->size);
+        if (val_neg)
+            memset(high, 0xff, high_n * sizeof(bitfld_t));
+        break;
+    case '^':
+        ln_xor_n(tar->bits, tar->bits, val->bits, val->size);
+        if (val_neg)
+            ln_com(high, high, high_n);
+        break;
     }
     return tar;
 }
 
-// Recursive multiplication, stores result in max
-dwhl_t *do_mul(dwhl_t *max, dwhl_t *min) {
-    dwhl_t first;
-    const shift_t sig = sig_bits(min) - 1;
-
-    dwhl_initi(&first, max);
-    dwhl_lshifteq(max, sig);
-    dwhl_andeq(min, dwhl_slshift(dwhl_zero, sig));
-    if (errno) {
-        dwhl_clr(&first);
+/* Performs left shift, stores result in tar
+ * Vacated bits are set to those of `fill' */
+dwhl_t *do_lshift(dwhl_t *tar, shift_t shift, bitfld_t fill) {
+    if (!tar) {
+        errno = EINVAL;
         return NULL;
     }
-    if      (!dwhl_cmp(min, dwhl_one))  dwhl_addeq(max, &first);
-    else if (dwhl_cmp(min, dwhl_zero))  dwhl_addeq(max, do_mul(&first, min));
-    dwhl_clr(&first);
-    return errno ? NULL : max;
-}
+    assert_lval(tar);
+    own_bits(tar);
 
-// Extend integer to specified size
-dwhl_t *extend(dwhl_t *tar, size_t resize) {
-    if (resize > BITFLD_CT_MAX) {   // Integer too large
+    const shdiv_t result = sh_div(shift, BITFLD_BITS);
+    const size_t n = tar->size, move = result.quot, size = n + move + (result.rem != 0);
+    const bitfld_t ext = sign_ext(tar);
+    bitfld_t *bits;
+
+    if (size > BITFLD_CT_MAX) {     // Result too large
         errno = ERANGE;
         return NULL;
     }
-    tar->bits = realloc(tar->bits, resize * sizeof(bitfld_t));
-    if (errno)
+    if (!(bits = realloc(tar->bits, size * sizeof(bitfld_t))))
         return NULL;
-    memset(tar->bits + tar->size, ~0 * dwhl_isneg(tar), resize - tar->size);
-    tar->size = resize;
+    memmove(bits + move, bits, n * sizeof(bitfld_t));
+    if (result.rem)
+        bits[size - 1] = ext << result.rem | ln_lshift(bits + move, bits + move, n, result.rem);
+    memset(bits, fill ? 0xff : 0, move * sizeof(bitfld_t));
+    if (result.rem)
+        bits[move] |= fill & (((bitfld_t) 1 << result.rem) - 1);
+    tar->bits = bits;
+    tar->size = size;
     return tar;
 }
 
-// Returns positive integer with most significant bits
-dwhl_t *max_sig(const dwhl_t *lhs, const dwhl_t *rhs) {
-    const dwhl_t *max = max_sz(lhs, rhs), *min = ptr_rem(lhs, rhs, max);
-    size_t i;
-
-    for (i = max->size - 1; i >= min->size; --i) {
-        if (max->bits[i])
-            return (dwhl_t *) (max == lhs ? lhs : rhs);
+/* Performs truncating division, storing quotient or remainder in tar
+ * Scratch space is allocated on the heap */
+dwhl_t *heap_div(dwhl_t *tar, const dwhl_t *val, bool rem) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
     }
-    while (i) {
-        if (max->bits[i] > min->bits[i])
-            return (dwhl_t *) (max == lhs ? lhs : rhs);
-        if (max->bits[--i] < min->bits[i])
-            return (dwhl_t *) (min == lhs ? lhs : rhs);
-        --i;
+    assert_lval(tar);
+
+    bitfld_t *const tp = malloc(div_itch(tar, val) * sizeof(bitfld_t));
+    dwhl_t *const tmp = tp ? do_div(tar, val, rem, tp) : NULL;
+
+    free(tp);
+    return tmp;
+}
+
+#ifndef NDEBUG
+// Returns true if product of q and nonzero d is magnitude of integer, or if there is no memory to check
+bool is_exact(const dwhl_t *tar, const bitfld_t *qp, size_t qn, const bitfld_t *dp, size_t dn) {
+    bitfld_t *const np = malloc((tar->size + qn + dn + ln_mul_itch(qn, dn)) * sizeof(bitfld_t)),
+      *const rp = np + tar->size;
+    size_t nn;
+    bool exact;
+
+    if (!np)
+        return true;
+    nn = get_abs(np, tar);
+    if (!(qn = ln_norm(qp, qn)))
+        exact = !nn;
+    else {
+        ln_mul(rp, qp, qn, dp, dn, rp + qn + dn);
+        exact = ln_norm(rp, qn + dn) == nn && !ln_cmp(rp, np, nn);
     }
-    return (dwhl_t *) lhs;
+    free(np);
+    return exact;
+}
+#endif
+
+// Stores low n bitfields of integer in rp, sign-extending if shorter
+void low_flds(bitfld_t *rp, const dwhl_t *val, size_t n) {
+    const size_t m = val->size < n ? val->size : n;
+
+    memcpy(rp, val->bits, m * sizeof(bitfld_t));
+    memset(rp + m, sign_ext(val) ? 0xff : 0, (n - m) * sizeof(bitfld_t));
+}
+
+/* Returns size of short product yielding product of magnitudes of an and bn bitfields shifted right by
+ * `bits', or 0 if a full product costs no more; both operands are padded with zeros to this size,
+ * and those padded at the bottom keep the short product from dropping bitfields the result needs */
+size_t mulhi_size(size_t an, size_t bn, shift_t bits) {
+    const size_t n = an > bn ? an : bn, k = bits / BITFLD_BITS;
+
+    // A short product of size m costs about m^2/2 products of bitfields; a full product, an bn
+    if (!an || !bn || 4 * k <= 3 * n || 2 * (an < bn ? an : bn) < n)
+        return 0;
+    return k >= n ? n : 2 * n - k;
 }
 
-// Returns padding between most significant 1 bit and end of bit buffer, in bits
-shift_t padding(const dwhl_t *val) {
-    for (size_t i = 0, j = val->size - 1; i < val->size; ++i, --j) {
-        if (val->bits[j])
-            return (i + 1) * BITFLD_BITS - bitfld_sig(val->bits[j]);
+/* Returns magnitude of integer rounded to nearest, ties to even, as `dig' significant bits
+ * The rounded magnitude is the result times 2^(*bits - dig), where *bits is its # of significant bits
+ * Only the top three bitfields are read, and the others only until one is nonzero
+ * Requires 0 < dig < 2 * BITFLD_BITS */
+dbitfld_t round_abs(const dwhl_t *val, unsigned dig, shift_t *bits) {
+    const bool neg = last_fld(val) & SIGN_BIT;
+    size_t k = 0, n = val->size;
+
+    while (k < n && !val->bits[k])
+        ++k;
+    if (k == n) {
+        *bits = 0;
+        return 0;
     }
-    return val->size * BITFLD_BITS; // Integer equals 0
+    while (!abs_fld(val, n - 1, k, neg))
+        --n;
+
+    // Top bits, left-aligned, and whether any below them are set
+    const bitfld_t hi = abs_fld(val, n - 1, k, neg),
+      mid = n > 1 ? abs_fld(val, n - 2, k, neg) : 0,
+      lo = n > 2 ? abs_fld(val, n - 3, k, neg) : 0;
+    const unsigned c = bitfld_clz(hi);
+    const dbitfld_t top = ((dbitfld_t) hi << BITFLD_BITS | mid) << c | (c ? lo >> (BITFLD_BITS - c) : 0),
+      half = (dbitfld_t) 1 << (2 * BITFLD_BITS - 1), rest = top << dig;
+    const bool sticky = lo << c || k + 3 < n;
+    dbitfld_t m = top >> (2 * BITFLD_BITS - dig);
+
+    *bits = (shift_t) n * BITFLD_BITS - c;
+    if (rest > half || (rest == half && (sticky || m & 1)))
+        ++m;
+    if (m >> dig) {     // Rounded up to a power of 2
+        m >>= 1;
+        ++*bits;
+    }
+    return m;
 }
 
 // Returns number of significant bits in positive integer
@@ -247,72 +320,155 @@ shift_t sig_bits(const dwhl_t *val) {
 
     for (size_t i = val->size - 1;; --i) {
         if ((cur = val->bits[i]))
-            return i * sizeof(bitfld_t) + bitfld_sig(cur);
+            return i * BITFLD_BITS + bitfld_sig(cur);
         if (!i)
             break;
     }
     return 0;
 }
 
-// If temporary, free integer
-void clr_rval(const dwhl_t *val, bool tmp) {
-    if (tmp) {
-        free(val->bits);
-        free((dwhl_t *) val);
-    }
-    return;
+/* Returns bitfield i of magnitude of integer, whose lowest nonzero bitfield is k
+ * Below k, those of -val are zero; above it, they are complemented */
+bitfld_t abs_fld(const dwhl_t *val, size_t i, size_t k, bool neg) {
+    if (!neg)
+        return val->bits[i];
+    return i < k ? 0 : i == k ? -val->bits[i] : ~val->bits[i];
 }
 
-// Returns state of bit in integer
-bool get_bit(const dwhl_t *val, shift_t index) {
-    const shdiv_t result = sh_div(index, sizeof(bitfld_t));
+// Returns integer of largest bit buffer
+dwhl_t *max_sz(const dwhl_t *lhs, const dwhl_t *rhs) {
+    return (dwhl_t *) (lhs->size > rhs->size ? lhs : rhs);
+}
 
-    return val->bits[result.quot] & 1 << result.rem;
+// Stores magnitude of integer in dst, returning its normalized size
+size_t get_abs(bitfld_t *dst, const dwhl_t *val) {
+    memcpy(dst, val->bits, val->size * sizeof(bitfld_t));
+    if (last_fld(val) & SIGN_BIT) {
+        for (size_t i = 0; i < val->size; ++i)
+            dst[i] = ~dst[i];
+        ln_add_1(dst, dst, val->size, 1);
+    }
+    return ln_norm(dst, val->size);
 }
 
-// If temporary, returns true and sets .rval to false
-bool is_rval(const dwhl_t *val) {
-    bool tmp;
+/* Assigns signed magnitude to integer, growing bit buffer if needed
+ * Source may not overlap bit buffer of integer */
+dwhl_t *set_abs(dwhl_t *tar, const bitfld_t *src, size_t n, bool neg) {
+    n = ln_norm(src, n);
 
-    if (tmp = val->rval)
-        ((dwhl_t *) val)->rval = false;
-    return tmp;
-}
+    // Keep room for sign bit
+    const size_t size = n ? n + ((src[n - 1] & SIGN_BIT) != 0) : 1;
 
-// Returns value representing insignificant bits in an integer
-bitfld_t insig_val(const dwhl_t *val) {
-    return BITFLD_MAX * dwhl_isneg(val);
+    if (tar->refs) {
+        if (!disown(tar, size))
+            return NULL;
+    } else if (tar->size < size) {
+        bitfld_t *bits = realloc(tar->bits, size * sizeof(bitfld_t));
+
+        if (!bits)
+            return NULL;
+        tar->bits = bits;
+        tar->size = size;
+    }
+    memcpy(tar->bits, src, n * sizeof(bitfld_t));
+    memset(tar->bits + n, 0, (tar->size - n) * sizeof(bitfld_t));
+    if (neg && n) {
+        for (size_t i = 0; i < tar->size; ++i)
+            tar->bits[i] = ~tar->bits[i];
+        ln_add_1(tar->bits, tar->bits, tar->size, 1);
+    }
+    return tar;
 }
 
-/* Returns bitfield at position in bit buffer
- * If position exceeds size of buffer, returns insignificant value */
-bitfld_t peek(const dwhl_t *val, size_t at) {
-    if (at >= val->size)
-        return insig_val(val);
-    return val->bits[at];
+/* Appends `ext' to bit buffer unless the top bitfield already implies it, followed
+ * by a bitfield of the result's sign if `ext' alone would read with the wrong sign */
+dwhl_t *put_top(dwhl_t *tar, bitfld_t ext, bool neg) {
+    const bitfld_t fill = neg ? BITFLD_MAX : 0;
+    const bool implied = ext == fill && ext == sign_ext(tar);
+    const size_t size = tar->size + !implied + (!implied && (ext ^ fill) & SIGN_BIT);
+    bitfld_t *bits;
+
+    if (implied)
+        return tar;
+    if (size > BITFLD_CT_MAX) {     // Integer too large
+        errno = ERANGE;
+        return NULL;
+    }
+    if (!(bits = realloc(tar->bits, size * sizeof(bitfld_t))))
+        return NULL;
+    bits[tar->size] = ext;
+    if (size > tar->size + 1)
+        bits[tar->size + 1] = fill;
+    tar->bits = bits;
+    tar->size = size;
+    return tar;
 }
 
-// Returns final bitfield in bit buffer
-bitfld_t last_fld(const dwhl_t *val) {
-    return val->bits[val->size - 1];
+// Extend integer to specified size
+dwhl_t *extend(dwhl_t *tar, size_t resize) {
+    if (resize > BITFLD_CT_MAX) {   // Integer too large
+        errno = ERANGE;
+        return NULL;
+    }
+
+    const int fill = last_fld(tar) & SIGN_BIT ? 0xff : 0;
+    bitfld_t *const bits = realloc(tar->bits, resize * sizeof(bitfld_t));
+
+    if (!bits)
+        return NULL;
+    memset(bits + tar->size, fill, (resize - tar->size) * sizeof(bitfld_t));
+    tar->bits = bits;
+    tar->size = resize;
+    return tar;
 }
 
-// Returns integer of largest bit buffer
-dwhl_t *max_sz(const dwhl_t *lhs, const dwhl_t *rhs) {
-    return (dwhl_t *) (lhs->size > rhs->size ? lhs : rhs);
+// Returns scratch space, in bitfields, needed by `do_div()'
+size_t div_itch(const dwhl_t *tar, const dwhl_t *val) {
+    return 2 * tar->size + 1 + val->size + ln_divrem_itch(tar->size, val->size);
 }
 
-// Returns integer of smallest bitfield size
-dwhl_t *min_sz(const dwhl_t *lhs, const dwhl_t *rhs) {
-    return (dwhl_t *) (lhs->size < rhs->size ? rhs : lhs);
+/* Performs truncating division, storing quotient or remainder in tar
+ * Remainder takes sign of tar */
+dwhl_t *do_div(dwhl_t *tar, const dwhl_t *val, bool rem, bitfld_t *tp) {
+    const bool tar_neg = last_fld(tar) & SIGN_BIT, quot_neg = tar_neg ^ (bool) (last_fld(val) & SIGN_BIT);
+    bitfld_t *const np = tp, *const dp = np + tar->size + 1, *const qp = dp + val->size, *const ts = qp + tar->size;
+    const size_t nn = get_abs(np, tar), dn = get_abs(dp, val);
+
+    if (!dn) {
+        errno = EDOM;
+        return NULL;
+    }
+    if (nn < dn)    // Quotient is 0, remainder is tar
+        return rem ? tar : set_abs(tar, qp, 0, false);
+    ln_divrem(qp, np, nn, dp, dn, ts);
+    return rem ? set_abs(tar, np, dn, tar_neg) : set_abs(tar, qp, nn - dn + 1, quot_neg);
 }
 
-// Sets bit in integer to specified state
-dwhl_t *set_bit(dwhl_t *tar, shift_t index, bool state) {
-    const shdiv_t result = sh_div(index, sizeof(bitfld_t));
+// Returns scratch space, in bitfields, needed by `do_mul()', or 0 and sets errno if product is too large
+size_t mul_itch(const dwhl_t *tar, const dwhl_t *val, const dwhl_tune_t *tune) {
+    const size_t an = tar->size, bn = val->size;
 
-    tar->bits[result.quot] ^= 1 << result.rem;
-    return tar;
+    if (an + bn > BITFLD_CT_MAX) {  // Integer too large
+        errno = ERANGE;
+        return 0;
+    }
+    return 2 * (an + bn) + (tar == val ? ln_sqr_tuned_itch(an, tune) : ln_mul_tuned_itch(an, bn, tune));
+}
+
+/* Multiplies tar by val
+ * Squares when both operands are the same integer */
+dwhl_t *do_mul(dwhl_t *tar, const dwhl_t *val, bitfld_t *tp, const dwhl_tune_t *tune) {
+    const bool neg = (last_fld(tar) ^ last_fld(val)) & SIGN_BIT;
+    bitfld_t *const ap = tp, *const bp = ap + tar->size, *const rp = bp + val->size, *const ts = rp + tar->size + val->size;
+    const size_t an = get_abs(ap, tar), bn = tar == val ? an : get_abs(bp, val);
+
+    if (!an || !bn)
+        return set_abs(tar, rp, 0, false);
+    if (tar == val)
+        ln_sqr_tuned(rp, ap, an, ts, tune);
+    else
+        ln_mul_tuned(rp, ap, an, bp, bn, ts, tune);
+    return set_abs(tar, rp, an + bn, neg);
 }
 
 // ---- Basic Utilities ----
@@ -324,14 +480,10 @@ export integr_t dwhl_casts(const dwhl_t *val, size_t size) {
     }
     if (sig_bits(val) >= size * 8) {
         errno = EOVERFLOW;
-        clr_rval(val, val->rval);
         return 0;
     }
 
-    integr_t tmp = *(integr_t *) (val->bits + INTEGR_OFF);
-
-    clr_rval(val, val->rval);
-    return tmp;
+    return *(integr_t *) (val->bits + INTEGR_OFF);
 }
 export uintegr_t dwhl_castu(const dwhl_t *val, size_t size) {
     if (!val) {
@@ -340,103 +492,97 @@ export uintegr_t dwhl_castu(const dwhl_t *val, size_t size) {
     }
     if (val && val->bits[val->size - 1] & SIGN_BIT || sig_bits(val) > size * 8) {
         errno = EOVERFLOW;
-        clr_rval(val, val->rval);
         return 0;
     }
 
-    uintegr_t tmp = *(uintegr_t *) (val->bits + INTEGR_OFF);
-
-    clr_rval(val, val->rval);
-    return tmp;
+    return *(uintegr_t *) (val->bits + INTEGR_OFF);
 }
 export int dwhl_cmp(const dwhl_t *lhs, const dwhl_t *rhs) {
-    if (!lhs) {
-        if (rhs)
-            clr_rval(rhs, rhs->rval);
+    if (!lhs || !rhs) {
         errno = EINVAL;
         return 2;
     }
-    if (!rhs) {
-        clr_rval(lhs, lhs->rval);
-        errno = EINVAL;
-        return 2;    
-    }
 
-    const bool lhs_rval = is_rval(lhs), rhs_rval = is_rval(rhs), lhs_sign = dwhl_isneg(lhs);
+    const bool lhs_sign = last_fld(lhs) & SIGN_BIT;
+    int tmp;
 
-    if (lhs_sign ^ dwhl_isneg(rhs)) {
-        clr_rval(lhs, lhs_rval);
-        clr_rval(rhs, rhs_rval);
-        return lhs_sign ? -1 : 1;
+    if (lhs_sign != (bool) (last_fld(rhs) & SIGN_BIT))
+        tmp = lhs_sign ? -1 : 1;
+    else {
+        /* Integers of equal sign order the same as their two's complement, read unsigned
+         * Upper bitfields of longer integer are compared against sign extension of shorter */
+        const dwhl_t *max = max_sz(lhs, rhs), *min = max == lhs ? rhs : lhs;
+        const bitfld_t ext = lhs_sign ? BITFLD_MAX : 0;
+        size_t i = max->size;
+
+        while (i > min->size && max->bits[i - 1] == ext)
+            --i;
+        if (i > min->size)
+            tmp = (max->bits[i - 1] > ext) == (max == lhs) ? 1 : -1;
+        else
+            tmp = ln_cmp(lhs->bits, rhs->bits, min->size);
     }
+    return tmp;
+}
+export int dwhl_cmp_take(dwhl_t *lhs, dwhl_t *rhs) {
+    const int tmp = dwhl_cmp(lhs, rhs);
 
-    int cmpval;
-    const size_t final = max_sz(lhs, rhs)->size - 1;
-
-    for (size_t i = final;; --i) {
-        cmpval = (peek(lhs, i) > peek(rhs, i)) - (lhs->bits[i] < rhs->bits[i]);
-        if (cmpval) {
-            clr_rval(lhs, lhs_rval);
-            clr_rval(rhs, rhs_rval);
-            return lhs_sign ? -cmpval : cmpval;
-        }
-        if (!i) {
-            clr_rval(lhs, lhs_rval);
-            clr_rval(rhs, rhs_rval);
-            return 0;
-        }
-    }
+    dwhl_drop(lhs);
+    if (rhs != lhs)
+        dwhl_drop(rhs);
+    return tmp;
 }
 export dwhl_t *dwhl_eq(dwhl_t *restrict tar, const dwhl_t *restrict val) {
-    if (!val) {
-        errno = EINVAL;
-        return NULL;
-    }
-    if (!tar) {
-        clr_rval(val, val->rval);
+    if (!tar || !val) {
         errno = EINVAL;
         return NULL;
     }
     assert_lval(tar);
 
-    dwhl_t *tmp;
-
-    if (val->rval) {
-        ((dwhl_t *) val)->rval = false;
-        tmp = dwhl_swp(tar, (dwhl_t *) val);
-        clr_rval(val, true);
-        return tmp;
-    }
-    if (tar->size < val->size) {
-        free(tar->bits);
-        tmp = dwhl_initi(tar, val);
-        return tmp;
+    // Shared buffers are shared again, rather than copied into
+    if (tar->refs && tar->refs == val->refs)
+        return tar;
+    if (tar->size < val->size || tar->refs || val->refs) {
+        dwhl_clr(tar);
+        return dwhl_initi(tar, val);
     }
     memcpy(tar->bits, val->bits, val->size * sizeof(bitfld_t));
     memset(tar->bits + val->size, ~0 * dwhl_isneg(val), (tar->size - val->size) * sizeof(bitfld_t));
     return tar;
 }
-/* export dwhl_t *dwhl_eqf(dwhl_t *restrict tar, const ddec_t *restrict val) {
-    if (!val) {
+export dwhl_t *dwhl_eq_take(dwhl_t *restrict tar, dwhl_t *restrict val) {
+    if (!val || !val->rval)
+        return dwhl_eq(tar, val);
+    if (!tar) {
+        dwhl_drop(val);
         errno = EINVAL;
         return NULL;
     }
-    if (!tar) {
-        clr_rval(val, val->rval);
+    assert_lval(tar);
+
+    // Buffer of temporary is taken over, so nothing is copied
+    dwhl_clr(tar);
+    *tar = *val;
+    tar->rval = false;
+    free(val);
+    return tar;
+}
+export dwhl_t *dwhl_eqf(dwhl_t *restrict tar, const ddec_t *restrict val) {
+    if (!tar || !val) {
         errno = EINVAL;
         return NULL;
     }
     assert_lval(tar);
-
-    // ...
-
-} */
+    return div_pow10(tar, &val->coef, val->scale, val->rules, NULL);
+}
 export dwhl_t *dwhl_eqs(dwhl_t *restrict tar, integr_t val) {
     if (!tar) {
         errno = EINVAL;
         return NULL;
     }
     assert_lval(tar);
+    if (tar->refs && !disown(tar, tar->size))
+        return NULL;
     memcpy(tar->bits, &val, sizeof(bitfld_t));
     memset(tar->bits + 1, ~0 * (val < 0), (tar->size - 1) * sizeof(bitfld_t));
     return tar;
@@ -447,44 +593,54 @@ export dwhl_t *dwhl_equ(dwhl_t *restrict tar, uintegr_t val) {
         return NULL;
     }
     assert_lval(tar);
+    if (tar->refs && !disown(tar, tar->size))
+        return NULL;
     memcpy(tar->bits, &val, sizeof(bitfld_t));
     memset(tar->bits + 1, 0, (tar->size - 1) * sizeof(bitfld_t));
     return tar;
 }
-/* export dwhl_t *dwhl_initf(dwhl_t *restrict tar, const ddec_t *val) {
-    if (!val) {
+export dwhl_t *dwhl_initf(dwhl_t *restrict tar, const ddec_t *val) {
+    if (!tar || !val) {
         errno = EINVAL;
         return NULL;
     }
-    if (!tar) {
-        clr_rval(val, val->rval);
-        errno = EINVAL;
+    *tar = (dwhl_t) {NULL, 0, false, NULL};
+    if (!div_pow10(tar, &val->coef, val->scale, val->rules, NULL)) {
+        free(tar->bits);
         return NULL;
     }
-    assert_lval(tar);
-
-    // ...
-
-    clr_rval(val, val->rval);
-    tar->rval = false;
     return tar;
-} */
+}
 export dwhl_t *dwhl_initi(dwhl_t *restrict tar, const dwhl_t *val) {
-    if (!val) {
+    if (!tar || !val) {
         errno = EINVAL;
         return NULL;
     }
-    if (!tar) {
-        clr_rval(val, val->rval);
-        errno = EINVAL;
-        return NULL;
+    if (val->refs) {
+        atomic_fetch_add_explicit(&val->refs->n, 1, memory_order_relaxed);
+        *tar = *val;
+        tar->rval = false;
+        return tar;
     }
     tar->bits = malloc((tar->size = val->size) * sizeof(bitfld_t));
     if (!tar->bits)
         return NULL;
     memcpy(tar->bits, val->bits, val->size * sizeof(bitfld_t));
-    clr_rval(val, val->rval);
     tar->rval = false;
+    tar->refs = NULL;
+    return tar;
+}
+export dwhl_t *dwhl_initi_take(dwhl_t *restrict tar, dwhl_t *val) {
+    if (!val || !val->rval)
+        return dwhl_initi(tar, val);
+    if (!tar) {
+        dwhl_drop(val);
+        errno = EINVAL;
+        return NULL;
+    }
+    *tar = *val;
+    tar->rval = false;
+    free(val);
     return tar;
 }
 export dwhl_t *dwhl_inits(dwhl_t *restrict tar, integr_t val) {
@@ -498,6 +654,7 @@ export dwhl_t *dwhl_inits(dwhl_t *restrict tar, integr_t val) {
     tar->bits[1] = BITFLD_MAX * !!(val & SIGN_BIT);
     tar->bits[0] = val;
     tar->rval = false;
+    tar->refs = NULL;
     return tar;
 }
 export dwhl_t *dwhl_initu(dwhl_t *restrict tar, uintegr_t val) {
@@ -511,6 +668,7 @@ export dwhl_t *dwhl_initu(dwhl_t *restrict tar, uintegr_t val) {
     tar->bits[1] = 0;
     tar->bits[0] = val;
     tar->rval = false;
+    tar->refs = NULL;
     return tar;
 }
 export bool dwhl_isneg(const dwhl_t *restrict val) {
@@ -518,11 +676,34 @@ export bool dwhl_isneg(const dwhl_t *restrict val) {
         errno = EINVAL;
         return 0;
     }
-
-    const bool tmp = val->bits[val->size - 1] & SIGN_BIT;
-
-    clr_rval(val, val->rval);
-    return tmp;
+    return val->bits[val->size - 1] & SIGN_BIT;
+}
+export void dwhl_release(dwhl_t *val) {
+    if (!val) {
+        errno = EINVAL;
+        return;
+    }
+    if (!val->refs)
+        free(val->bits);
+    else if (atomic_fetch_sub_explicit(&val->refs->n, 1, memory_order_acq_rel) == 1) {
+        free(val->bits);
+        free(val->refs);
+    }
+}
+export dwhl_t *dwhl_share(dwhl_t *restrict tar, dwhl_t *restrict val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (!val->refs) {
+        if (!(val->refs = malloc(sizeof(struct dwhl_refs))))
+            return NULL;
+        atomic_init(&val->refs->n, 1);
+    }
+    atomic_fetch_add_explicit(&val->refs->n, 1, memory_order_relaxed);
+    *tar = *val;
+    tar->rval = false;
+    return tar;
 }
 export dwhl_t *dwhl_swp(dwhl_t *restrict ret, dwhl_t *restrict val) {
     if (!val) {
@@ -542,199 +723,333 @@ export dwhl_t *dwhl_swp(dwhl_t *restrict ret, dwhl_t *restrict val) {
     *val = tmp;
     return ret;
 }
+export dwhl_t *dwhl_unshare(dwhl_t *tar) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (!tar->refs)
+        return tar;
 
-// ---- Basic Arthmetic ----
+    // Buffer held by no other integer is taken over
+    if (atomic_load_explicit(&tar->refs->n, memory_order_acquire) == 1) {
+        free(tar->refs);
+        tar->refs = NULL;
+        return tar;
+    }
 
-export dwhl_t *dwhl_abseq(dwhl_t *tar) {
-    assert_lval(tar);
-    return dwhl_isneg(tar) ? dwhl_negeq(tar) : tar;
+    bitfld_t *const bits = malloc(tar->size * sizeof(bitfld_t));
+
+    if (!bits)
+        return NULL;
+    memcpy(bits, tar->bits, tar->size * sizeof(bitfld_t));
+    dwhl_release(tar);
+    tar->bits = bits;
+    tar->refs = NULL;
+    return tar;
 }
-export dwhl_t *dwhl_addeq(dwhl_t *tar, const dwhl_t *val) {
+
+// ---- Floating-Point Conversion ----
+
+export double dwhl_get_d(const dwhl_t *val) {
+    shift_t bits;
+    double abs;
+
     if (!val) {
         errno = EINVAL;
-        return NULL;
+        return 0;
     }
-    if (!tar) {
-        clr_rval(val, val->rval);
+
+    const dbitfld_t m = round_abs(val, DBL_MANT_DIG, &bits);
+
+    if (bits > DBL_MAX_EXP) {
+        errno = ERANGE;
+        abs = HUGE_VAL;
+    } else
+        abs = ldexp((double) m, (int) bits - DBL_MANT_DIG);
+    return dwhl_isneg(val) ? -abs : abs;
+}
+export double dwhl_get_d_2exp(const dwhl_t *val, shift_t *exp) {
+    if (!val || !exp) {
         errno = EINVAL;
-        return NULL;
+        return 0;
+    }
+
+    const dbitfld_t m = round_abs(val, DBL_MANT_DIG, exp);
+    const double frac = ldexp((double) m, -DBL_MANT_DIG);
+
+    return dwhl_isneg(val) ? -frac : frac;
+}
+export floatp_t dwhl_get_ld(const dwhl_t *val) {
+    shift_t bits;
+    floatp_t abs;
+
+    if (!val) {
+        errno = EINVAL;
+        return 0;
     }
-    assert_lval(tar);
 
-    const bool val_rval = is_rval(val);
-    dwhl_t *tar_abs = dwhl_abs(tar), *val_abs;
+    const dbitfld_t m = round_abs(val, LDBL_MANT_DIG, &bits);
 
-    if (!tar_abs) {
-        clr_rval(val, val_rval);
+    if (bits > LDBL_MAX_EXP) {
+        errno = ERANGE;
+        abs = HUGE_VALL;
+    } else
+        abs = ldexpl((floatp_t) m, (int) bits - LDBL_MANT_DIG);
+    return dwhl_isneg(val) ? -abs : abs;
+}
+export dwhl_t *dwhl_set_d(dwhl_t *tar, double val) {
+    return dwhl_set_ld(tar, val);   // Exact, as every double is a long double
+}
+export dwhl_t *dwhl_set_ld(dwhl_t *tar, floatp_t val) {
+    int exp;
+
+    if (!tar) {
+        errno = EINVAL;
         return NULL;
     }
-    val_abs = dwhl_abs(val);
-    if (!val_abs) {
-        clr_rval(tar_abs, true);
-        clr_rval(val, val_rval);
+    assert_lval(tar);
+    if (!isfinite(val)) {
+        errno = EDOM;
         return NULL;
     }
 
-    const dwhl_t *max = max_sig(tar_abs, val_abs);
-    bool tmp = last_fld(max) != insig_val(max);
+    // |val| = m 2^(exp - LDBL_MANT_DIG) exactly, for integral m
+    const dbitfld_t m = (dbitfld_t) ldexpl(frexpl(fabsl(val), &exp), LDBL_MANT_DIG);
 
-    // Append bit buffer if needed, with room for overflow
-    if (tar->size < max->size + tmp && !extend(tar, max->size + tmp)) {
-        clr_rval(tar_abs, true);
-        clr_rval(val_abs, true);
-        clr_rval(val, val_rval);
-        return NULL;
-    } 
+    if (exp <= 0)
+        return dwhl_equ(tar, 0);
 
-    bool overflow = false;
+    const dbitfld_t whole = exp < LDBL_MANT_DIG ? m >> (LDBL_MANT_DIG - exp) : m;
 
-    for (size_t i = 0, lim = tar->size; i < lim; ++i) {
-        tmp = tar->bits[i] > BITFLD_MAX - val->bits[i] || val->bits[i] > BITFLD_MAX - tar->bits[i];
-        tar->bits[i] += val->bits[i] + overflow;
-        overflow = tmp;
-    }
-    clr_rval(tar_abs, true);
-    clr_rval(val_abs, true);
-    clr_rval(val, val_rval);
-    return tar;
-}
-export dwhl_t *dwhl_andeq(dwhl_t *tar, const dwhl_t *val) {
-    if (!val) {
-        errno = EINVAL;
+    if (!set_abs(tar, (const bitfld_t[]) {(bitfld_t) whole, (bitfld_t) (whole >> BITFLD_BITS)}, 2, false)
+      || (exp > LDBL_MANT_DIG && !dwhl_lshifteq(tar, (shift_t) (exp - LDBL_MANT_DIG))))
         return NULL;
-    }
+    return val < 0 ? dwhl_negeq(tar) : tar;
+}
+
+// ---- Basic Arthmetic ----
+
+export dwhl_t *dwhl_abseq(dwhl_t *tar) {
     if (!tar) {
-        clr_rval(val, val->rval);
         errno = EINVAL;
         return NULL;
     }
     assert_lval(tar);
-    for (size_t i = 0, lim = min_sz(tar, val)->size; i < lim; ++i)
-        tar->bits[i] &= val->bits[i];
-    clr_rval(val, val->rval);
-    return tar;
+    return last_fld(tar) & SIGN_BIT ? dwhl_negeq(tar) : tar;
 }
-export dwhl_t *dwhl_negeq(dwhl_t *tar) {
-    assert_lval(tar);
-    return dwhl_addeq(dwhl_noteq(tar), dwhl_one);
+export dwhl_t *dwhl_addeq(dwhl_t *tar, const dwhl_t *val) {
+    return do_add(tar, val, false);
 }
-export dwhl_t *dwhl_noteq(dwhl_t *tar) {
+export dwhl_t *dwhl_andeq(dwhl_t *tar, const dwhl_t *val) {
+    return do_logic(tar, val, '&');
+}
+export dwhl_t *dwhl_negeq(dwhl_t *tar) {
     if (!tar) {
         errno = EINVAL;
         return NULL;
     }
     assert_lval(tar);
-    for (size_t i = 0, lim = tar->size; i < lim; ++i)
-        tar->bits[i] = ~tar->bits[i];
-    return tar;
+    own_bits(tar);
+
+    // -x = ~x + 1, whose sign extension is that of ~x plus carry
+    const bitfld_t ext = ~sign_ext(tar);
+    bitfld_t carry;
+
+    ln_com(tar->bits, tar->bits, tar->size);
+    carry = ln_add_1(tar->bits, tar->bits, tar->size, 1);
+    return put_top(tar, ext + carry, (ext + carry) & SIGN_BIT);
 }
-export dwhl_t *dwhl_oreq(dwhl_t *tar, const dwhl_t *val) {
-    if (!val) {
-        errno = EINVAL;
-        return NULL;
-    }
+export dwhl_t *dwhl_noteq(dwhl_t *tar) {
     if (!tar) {
-        clr_rval(val, val->rval);
         errno = EINVAL;
         return NULL;
     }
     assert_lval(tar);
-    if (tar->size < val->size) {
-        extend(tar, val->size);
-        if (errno) {
-            clr_rval(val, val->rval);
-            return NULL;
-        }
-    } 
-    for (size_t i = 0, lim = tar->size; i < lim; ++i)
-        tar->bits[i] |= val->bits[i];
-    clr_rval(val, val->rval);
+    own_bits(tar);
+    ln_com(tar->bits, tar->bits, tar->size);
     return tar;
 }
+export dwhl_t *dwhl_oreq(dwhl_t *tar, const dwhl_t *val) {
+    return do_logic(tar, val, '|');
+}
 export dwhl_t *dwhl_subeq(dwhl_t *tar, const dwhl_t *val) {
-    return dwhl_addeq(tar, dwhl_neg(val));
+    return do_add(tar, val, true);
 }
 export dwhl_t *dwhl_xoreq(dwhl_t *tar, const dwhl_t *val) {
-    if (!val) {
+    return do_logic(tar, val, '^');
+}
+export dwhl_t *dwhl_diveq(dwhl_t *tar, const dwhl_t *val) {
+    return heap_div(tar, val, false);
+}
+export dwhl_t *dwhl_modeq(dwhl_t *tar, const dwhl_t *val) {
+    return heap_div(tar, val, true);
+}
+export dwhl_t *dwhl_divexacteq(dwhl_t *tar, const dwhl_t *val) {
+    if (!tar || !val) {
         errno = EINVAL;
         return NULL;
     }
-    if (!tar) {
-        clr_rval(val, val->rval);
-        errno = EINVAL;
+    assert_lval(tar);
+
+    const bool neg = (last_fld(tar) ^ last_fld(val)) & SIGN_BIT;
+    bitfld_t *const np = malloc((2 * tar->size + val->size + ln_divexact_itch(tar->size, val->size)) * sizeof(bitfld_t)),
+      *const dp = np + tar->size, *const qp = dp + val->size;
+    size_t nn, dn;
+    dwhl_t *tmp;
+
+    if (!np)
+        return NULL;
+    nn = get_abs(np, tar);
+    if (!(dn = get_abs(dp, val))) {
+        free(np);
+        errno = EDOM;
         return NULL;
     }
-    assert_lval(tar);
-    if (tar->size < val->size) {
-        extend(tar, val->size);
-        if (errno) {
-            clr_rval(val, val->rval);
-            return NULL;
-        }
+    if (nn < dn) {  // Only 0 is divisible by a larger divisor
+        assert_exact(!nn, tar);
+        tmp = set_abs(tar, qp, 0, false);
+    } else {
+        ln_divexact(qp, np, nn, dp, dn, qp + nn - dn + 1);
+        assert_exact(is_exact(tar, qp, nn - dn + 1, dp, dn), tar);
+        tmp = set_abs(tar, qp, nn - dn + 1, neg);
     }
-    for (size_t i = 0, lim = tar->size; i < lim; ++i)
-        tar->bits[i] ^= val->bits[i];
-    clr_rval(val, val->rval);
-    return tar;
-}
-export dwhl_t *dwhl_diveq(dwhl_t *tar, const dwhl_t *val) {
-    return do_div(tar, val, false);
-}
-export dwhl_t *dwhl_modeq(dwhl_t *tar, const dwhl_t *val) {
-    return do_div(tar, val, true);
+    free(np);
+    return tmp;
 }
 export dwhl_t *dwhl_muleq(dwhl_t *tar, const dwhl_t *val) {
-    if (!val) {
+    if (!tar || !val) {
         errno = EINVAL;
         return NULL;
     }
-    if (!tar) {
-        clr_rval(val, val->rval);
+    assert_lval(tar);
+
+    const size_t itch = mul_itch(tar, val, &ln_tune);
+    bitfld_t *const tp = itch ? malloc(itch * sizeof(bitfld_t)) : NULL;
+    dwhl_t *const tmp = tp ? do_mul(tar, val, tp, &ln_tune) : NULL;
+
+    free(tp);
+    return tmp;
+}
+
+export dwhl_t *dwhl_mulhieq(dwhl_t *tar, const dwhl_t *val, shift_t bits) {
+    if (!tar || !val) {
         errno = EINVAL;
         return NULL;
     }
     assert_lval(tar);
 
-    const bool val_rval = is_rval(val);
+    const bool neg = (last_fld(tar) ^ last_fld(val)) & SIGN_BIT;
+    bitfld_t *const ap = malloc((tar->size + val->size) * sizeof(bitfld_t)), *const bp = ap + tar->size, *rp;
+    size_t an, bn;
+    dwhl_t *tmp = NULL;
 
-    if (!dwhl_cmp(tar, dwhl_zero) || !dwhl_cmp(val, dwhl_zero)) {
-        clr_rval(val, val_rval);
-        return dwhl_eq(tar, dwhl_zero);
+    if (!ap)
+        return NULL;
+    an = get_abs(ap, tar);
+    bn = get_abs(bp, val);
+    if (an + bn > BITFLD_CT_MAX) {  // Integer too large
+        free(ap);
+        errno = ERANGE;
+        return NULL;
     }
 
-    dwhl_t *tar_abs = dwhl_abs(tar), *val_abs;
-
-    if (!tar_abs) {
-        clr_rval(val, val_rval);
-        return NULL;
+    // Short product of size m yields product shifted right by m - 2 pad bitfields
+    const size_t m = mulhi_size(an, bn, bits), pad = m ? m - (an > bn ? an : bn) : 0;
+    const shift_t left = bits - (shift_t) (m - 2 * pad) * BITFLD_BITS;
+    size_t rn = m ? m : an + bn;
+
+    if (!(rp = malloc((rn + (m ? 2 * m + ln_mulhi_itch(m) : ln_mul_itch(an, bn))) * sizeof(bitfld_t))))
+        goto cleanup;
+    if (m) {
+        bitfld_t *const xp = rp + rn, *const yp = xp + m;
+
+        memset(xp, 0, 2 * m * sizeof(bitfld_t));
+        memcpy(xp + pad, ap, an * sizeof(bitfld_t));
+        memcpy(yp + pad, bp, bn * sizeof(bitfld_t));
+        ln_mulhi(rp, xp, yp, m, yp + m);
+    } else if (an && bn)
+        ln_mul(rp, ap, an, bp, bn, rp + rn);
+    else
+        rn = 0;
+
+    // Rest of shift is taken from magnitude, truncating toward zero
+    const shdiv_t result = sh_div(left, BITFLD_BITS);
+    size_t n = 0;
+
+    if (result.quot < rn) {
+        n = rn - result.quot;
+        if (result.rem)
+            ln_rshift(rp, rp + result.quot, n, result.rem);
+        else
+            memmove(rp, rp + result.quot, n * sizeof(bitfld_t));
+    }
+    tmp = set_abs(tar, rp, n, neg);
+cleanup:
+    free(rp);
+    free(ap);
+    return tmp;
+}
+export size_t dwhl_mulhi_err(const dwhl_t *lhs, const dwhl_t *rhs, shift_t bits) {
+    if (!lhs || !rhs) {
+        errno = EINVAL;
+        return 0;
     }
-    val_abs = dwhl_abs(val);
-    if (!val_abs) {
-        clr_rval(tar_abs, true);
-        clr_rval(val, val_rval);
+
+    const size_t an = dwhl_cmpu(lhs, 0) ? (dwhl_sizeinbase(lhs, 2) + BITFLD_BITS - 1) / BITFLD_BITS : 0,
+      bn = dwhl_cmpu(rhs, 0) ? (dwhl_sizeinbase(rhs, 2) + BITFLD_BITS - 1) / BITFLD_BITS : 0;
+
+    return ln_mulhi_err(mulhi_size(an, bn, bits));
+}
+export dwhl_t *dwhl_mulloeq(dwhl_t *tar, const dwhl_t *val, shift_t bits) {
+    if (!tar || !val) {
+        errno = EINVAL;
         return NULL;
     }
-    
-    dwhl_t *max = max_sig(tar_abs, val_abs), *min = ptr_rem(tar_abs, val_abs, max);
+    assert_lval(tar);
+
+    const shdiv_t result = sh_div(bits, BITFLD_BITS);
+    const size_t n = result.quot + (result.rem != 0);
 
-    if (dwhl_cmp(min, maxmul) > 0) {    // Shift overflow
-        clr_rval(tar_abs, true);
-        clr_rval(val_abs, true);
-        clr_rval(val, val_rval);
+    if (n > BITFLD_CT_MAX) {    // Integer too large
         errno = ERANGE;
         return NULL;
     }
+    if (!n)
+        return set_abs(tar, tar->bits, 0, false);
 
-    const bool negate = dwhl_isneg(tar) ^ dwhl_isneg(val);
+    // Low bitfields of product in two's complement depend only on those of the operands
+    bitfld_t *const ap = malloc((3 * n + ln_mullo_itch(n)) * sizeof(bitfld_t)), *const bp = ap + n, *const rp = bp + n;
+    dwhl_t *tmp;
 
-    dwhl_swp(tar, do_mul(max, min));
-    clr_rval(tar_abs, true);
-    clr_rval(val_abs, true);
-    clr_rval(val, val_rval);
-    if (errno)
+    if (!ap)
         return NULL;
-    return negate ? dwhl_negeq(tar) : tar;   
+    low_flds(ap, tar, n);
+    low_flds(bp, val, n);
+    ln_mullo(rp, ap, bp, n, rp + n);
+    if (result.rem)
+        rp[n - 1] &= BITFLD_MAX >> (BITFLD_BITS - result.rem);
+    tmp = set_abs(tar, rp, n, false);
+    free(ap);
+    return tmp;
+}
+
+export dwhl_t *dwhl_addmuleq(dwhl_t *tar, const dwhl_t *lhs, const dwhl_t *rhs) {
+    return do_addmul(tar, lhs, rhs, false);
+}
+export dwhl_t *dwhl_submuleq(dwhl_t *tar, const dwhl_t *lhs, const dwhl_t *rhs) {
+    return do_addmul(tar, lhs, rhs, true);
 }
+
+export dwhl_t *dwhl_addeq_take(dwhl_t *tar, dwhl_t *val) { BUILD_EQ_TAKE(add, tar, val); }
+export dwhl_t *dwhl_andeq_take(dwhl_t *tar, dwhl_t *val) { BUILD_EQ_TAKE(and, tar, val); }
+export dwhl_t *dwhl_oreq_take(dwhl_t *tar, dwhl_t *val)  { BUILD_EQ_TAKE(or, tar, val);  }
+export dwhl_t *dwhl_subeq_take(dwhl_t *tar, dwhl_t *val) { BUILD_EQ_TAKE(sub, tar, val); }
+export dwhl_t *dwhl_xoreq_take(dwhl_t *tar, dwhl_t *val) { BUILD_EQ_TAKE(xor, tar, val); }
+export dwhl_t *dwhl_diveq_take(dwhl_t *tar, dwhl_t *val) { BUILD_EQ_TAKE(div, tar, val); }
+export dwhl_t *dwhl_modeq_take(dwhl_t *tar, dwhl_t *val) { BUILD_EQ_TAKE(mod, tar, val); }
+export dwhl_t *dwhl_muleq_take(dwhl_t *tar, dwhl_t *val) { BUILD_EQ_TAKE(mul, tar, val); }
+
 export dwhl_t *dwhl_lshifteq(dwhl_t *tar, shift_t shift) {
     return do_lshift(tar, shift, 0);
 }
@@ -747,29 +1062,73 @@ export dwhl_t *dwhl_rshifteq(dwhl_t *tar, shift_t shift) {
         return NULL;
     }
     assert_lval(tar);
+    own_bits(tar);
 
     const shdiv_t result = sh_div(shift, BITFLD_BITS);
-    const shift_t move = result.quot;
-
-    if (move >= tar->size)
-        return dwhl_eq(tar, dwhl_zero);
+    const size_t n = tar->size, move = result.quot < n ? result.quot : n;
+    const bitfld_t ext = sign_ext(tar);
+
+    // Vacated high bits take the sign, rounding toward negative infinity
+    if (move < n) {
+        memmove(tar->bits, tar->bits + move, (n - move) * sizeof(bitfld_t));
+        if (result.rem) {
+            ln_rshift(tar->bits, tar->bits, n - move, result.rem);
+            tar->bits[n - move - 1] |= ext << (BITFLD_BITS - result.rem);
+        }
+    }
+    memset(tar->bits + (n - move), ext ? 0xff : 0, move * sizeof(bitfld_t));
+    return tar;
+}
+export dwhl_t *dwhl_fdiv_r_2expeq(dwhl_t *tar, shift_t bits) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
 
-    bitfld_t carry = 0, tmp;
+    const shdiv_t result = sh_div(bits, BITFLD_BITS);
+    const size_t n = result.quot + (result.rem != 0);
+    const bool neg = last_fld(tar) & SIGN_BIT;
 
-    shift = result.rem;
-    memmove(tar->bits, tar->bits + move, (tar->size - move) * sizeof(bitfld_t));
-    memset(tar->bits + (tar->size - move), 0, move * sizeof(bitfld_t));
-    for (size_t i = tar->size - move - 1, j = tar->size - 1;; --i, --j) {
-        // Get carry
-        tmp = (tar->bits[j] & ~(BITFLD_MAX << shift)) << BITFLD_BITS - shift ; 
+    // Low bits in two's complement, read as nonnegative
+    if (result.quot >= tar->size && !neg)
+        return tar;
+    if (n > tar->size && !extend(tar, n))
+        return NULL;
+    if (!n)
+        return set_abs(tar, tar->bits, 0, false);
+    if (result.rem)
+        tar->bits[n - 1] &= BITFLD_MAX >> (BITFLD_BITS - result.rem);
+    memset(tar->bits + n, 0, (tar->size - n) * sizeof(bitfld_t));
+    return put_top(tar, 0, false);
+}
+export dwhl_t *dwhl_mod_2expeq(dwhl_t *tar, shift_t bits) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    if (!(last_fld(tar) & SIGN_BIT))
+        return dwhl_fdiv_r_2expeq(tar, bits);
 
-        // Apply carry  
-        tar->bits[j] = (tar->bits[j] >> shift) | carry;
+    // Low bits of magnitude, taking sign of tar
+    const shdiv_t result = sh_div(bits, BITFLD_BITS);
+    bitfld_t *const ap = malloc(tar->size * sizeof(bitfld_t));
+    size_t an;
+    dwhl_t *tmp;
 
-        carry = tmp;
-        if (!i)
-            return tar;
-    }
+    if (!ap)
+        return NULL;
+    an = get_abs(ap, tar);
+    if (result.quot < an) {
+        an = result.quot + (result.rem != 0);
+        if (result.rem)
+            ap[an - 1] &= BITFLD_MAX >> (BITFLD_BITS - result.rem);
+    }
+    tmp = set_abs(tar, ap, an, true);
+    free(ap);
+    return tmp;
 }
 
 export dwhl_t *dwhl_abs(const dwhl_t *val) { BUILD_UNARY(abs, val); }
@@ -778,14 +1137,63 @@ export dwhl_t *dwhl_not(const dwhl_t *val) { BUILD_UNARY(not, val); }
 
 export dwhl_t *dwhl_sub(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_BINARY(sub, lhs, rhs); }
 export dwhl_t *dwhl_div(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_BINARY(div, lhs, rhs); }
+export dwhl_t *dwhl_divexact(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_BINARY(divexact, lhs, rhs); }
 export dwhl_t *dwhl_mod(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_BINARY(mod, lhs, rhs); }
 
-export dwhl_t *dwhl_add(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_COMMUT(add, lhs, rhs); }
-export dwhl_t *dwhl_and(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_COMMUT(and, lhs, rhs); }
-export dwhl_t *dwhl_or(const dwhl_t *lhs, const dwhl_t *rhs)  { BUILD_COMMUT(or, lhs, rhs);  }
-export dwhl_t *dwhl_xor(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_COMMUT(xor, lhs, rhs); }
-export dwhl_t *dwhl_mul(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_COMMUT(mul, lhs, rhs); }
+export dwhl_t *dwhl_add(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_BINARY(add, lhs, rhs); }
+export dwhl_t *dwhl_and(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_BINARY(and, lhs, rhs); }
+export dwhl_t *dwhl_or(const dwhl_t *lhs, const dwhl_t *rhs)  { BUILD_BINARY(or, lhs, rhs);  }
+export dwhl_t *dwhl_xor(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_BINARY(xor, lhs, rhs); }
+export dwhl_t *dwhl_mul(const dwhl_t *lhs, const dwhl_t *rhs) { BUILD_BINARY(mul, lhs, rhs); }
+
+export dwhl_t *dwhl_mulhi(const dwhl_t *lhs, const dwhl_t *rhs, shift_t bits) {
+    if (!rhs) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    dwhl_t *const cpy = dwhl_tmp(lhs);
+
+    if (!cpy)
+        return NULL;
+    cpy->rval = false;
+    return ret_rval(cpy, dwhl_mulhieq(cpy, rhs, bits));
+}
+export dwhl_t *dwhl_mullo(const dwhl_t *lhs, const dwhl_t *rhs, shift_t bits) {
+    if (!rhs) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    dwhl_t *const cpy = dwhl_tmp(lhs);
+
+    if (!cpy)
+        return NULL;
+    cpy->rval = false;
+    return ret_rval(cpy, dwhl_mulloeq(cpy, rhs, bits));
+}
 
 export dwhl_t *dwhl_lshift(const dwhl_t *val, shift_t shift)  { BUILD_SHIFT(lshift, val, shift);  }
 export dwhl_t *dwhl_slshift(const dwhl_t *val, shift_t shift) { BUILD_SHIFT(slshift, val, shift); }
 export dwhl_t *dwhl_rshift(const dwhl_t *val, shift_t shift)  { BUILD_SHIFT(rshift, val, shift);  }
+
+export dwhl_t *dwhl_fdiv_r_2exp(const dwhl_t *val, shift_t bits) { BUILD_SHIFT(fdiv_r_2exp, val, bits); }
+export dwhl_t *dwhl_mod_2exp(const dwhl_t *val, shift_t bits)    { BUILD_SHIFT(mod_2exp, val, bits);    }
+
+export dwhl_t *dwhl_abs_take(dwhl_t *val) { BUILD_UNARY_TAKE(abs, val); }
+export dwhl_t *dwhl_neg_take(dwhl_t *val) { BUILD_UNARY_TAKE(neg, val); }
+export dwhl_t *dwhl_not_take(dwhl_t *val) { BUILD_UNARY_TAKE(not, val); }
+
+export dwhl_t *dwhl_sub_take(dwhl_t *lhs, dwhl_t *rhs) { BUILD_BINARY_TAKE(sub, lhs, rhs); }
+export dwhl_t *dwhl_div_take(dwhl_t *lhs, dwhl_t *rhs) { BUILD_BINARY_TAKE(div, lhs, rhs); }
+export dwhl_t *dwhl_mod_take(dwhl_t *lhs, dwhl_t *rhs) { BUILD_BINARY_TAKE(mod, lhs, rhs); }
+
+export dwhl_t *dwhl_add_take(dwhl_t *lhs, dwhl_t *rhs) { BUILD_COMMUT_TAKE(add, lhs, rhs); }
+export dwhl_t *dwhl_and_take(dwhl_t *lhs, dwhl_t *rhs) { BUILD_COMMUT_TAKE(and, lhs, rhs); }
+export dwhl_t *dwhl_or_take(dwhl_t *lhs, dwhl_t *rhs)  { BUILD_COMMUT_TAKE(or, lhs, rhs);  }
+export dwhl_t *dwhl_xor_take(dwhl_t *lhs, dwhl_t *rhs) { BUILD_COMMUT_TAKE(xor, lhs, rhs); }
+export dwhl_t *dwhl_mul_take(dwhl_t *lhs, dwhl_t *rhs) { BUILD_COMMUT_TAKE(mul, lhs, rhs); }
+
+export dwhl_t *dwhl_lshift_take(dwhl_t *val, shift_t shift)  { BUILD_SHIFT_TAKE(lshift, val, shift);  }
+export dwhl_t *dwhl_slshift_take(dwhl_t *val, shift_t shift) { BUILD_SHIFT_TAKE(slshift, val, shift); }
+export dwhl_t *dwhl_rshift_take(dwhl_t *val, shift_t shift)  { BUILD_SHIFT_TAKE(rshift, val, shift);  }
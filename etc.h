@@ -1,6 +1,8 @@
 #ifndef LADLE_ARBITRARY_GLOBAL_H
 #define LADLE_ARBITRARY_GLOBAL_H
+#include <errno.h>
 #include <stdbool.h>
+#include <stdlib.h>
 
 #include <ladle/common/header.h>
 #include <ladle/common/ptrcmp.h>
@@ -9,71 +11,108 @@
 
 // ---- Procedure Shorthands ----
 
-// Function declaration of unary operation returning rvalue
-
+/* Function declaration of unary operation returning rvalue
+ * Operand is copied, never modified */
 #define   BUILD_UNARY(id, val)          _BUILD_UNARY(PREFIX, id, val)
 #define  _BUILD_UNARY(prefix, id, val) __BUILD_UNARY(prefix, id, val)
-#define __BUILD_UNARY(prefix, id, val) {             \
-    if (!(val)->rval)                               \
-        (val) = prefix##_tmp(val);                  \
-    prefix##_t *tmp;                                \
-    ((prefix##_t *) (val))->rval = false;           \
-    tmp = prefix##_##id##eq((prefix##_t *) (val));  \
-    ((prefix##_t *) (val))->rval = true;            \
-    return tmp;                                     \
-}
-
-// Function declaration of binary, commutative operation returning rvalue
-#define   BUILD_COMMUT(id, lhs, rhs)          _BUILD_COMMUT(PREFIX, id, lhs, rhs)
-#define  _BUILD_COMMUT(prefix, id, lhs, rhs) __BUILD_COMMUT(prefix, id, lhs, rhs)
-#define __BUILD_COMMUT(prefix, id, lhs, rhs) {                  \
-    prefix##_t *tmp;                                            \
-    if ((lhs)->rval) {                                          \
-        ((prefix##_t *) (lhs))->rval = false;                   \
-        tmp = prefix##_##id##eq((prefix##_t *) (lhs), (rhs));   \
-        ((prefix##_t *) (lhs))->rval = true;                    \
-        return tmp;                                             \
-    } else if ((rhs)->rval) {                                   \
-        ((prefix##_t *) (rhs))->rval = false;                   \
-        tmp = prefix##_##id##eq((prefix##_t *) (rhs), (lhs));   \
-        ((prefix##_t *) (rhs))->rval = true;                    \
-        return tmp;                                             \
-    }                                                           \
-    prefix##_t *cpy = prefix##_tmp((lhs));                      \
-    ((prefix##_t *) cpy)->rval = false;                         \
-    tmp = prefix##_##id##eq((prefix##_t *) cpy, (rhs));         \
-    ((prefix##_t *) cpy)->rval = true;                          \
-    return tmp;                                                 \
-}
-
-// Function declaration of binary, noncommutative operation returning rvalue
+#define __BUILD_UNARY(prefix, id, val) {                    \
+    prefix##_t *const cpy = prefix##_tmp(val);              \
+    if (!cpy)                                               \
+        return NULL;                                        \
+    cpy->rval = false;                                      \
+    return ret_rval(cpy, prefix##_##id##eq(cpy));           \
+}
+
+/* Function declaration of binary operation returning rvalue
+ * Left operand is copied; neither operand is modified */
 #define   BUILD_BINARY(id, lhs, rhs)          _BUILD_BINARY(PREFIX, id, lhs, rhs)
 #define  _BUILD_BINARY(prefix, id, lhs, rhs) __BUILD_BINARY(prefix, id, lhs, rhs)
-#define __BUILD_BINARY(prefix, id, lhs, rhs) {                  \
-    prefix##_t *tmp;                                            \
-    if ((lhs)->rval) {                                          \
-        ((prefix##_t *) (lhs))->rval = false;                   \
-        tmp = prefix##_##id##eq((prefix##_t *) (lhs), (rhs));   \
-        ((prefix##_t *) (lhs))->rval = true;                    \
-        return tmp;                                             \
-    }                                                           \
-    prefix##_t *cpy = prefix##_tmp((lhs));                      \
-    ((prefix##_t *) cpy)->rval = false;                         \
-    tmp = prefix##_##id##eq((prefix##_t *) cpy, (rhs));         \
-    ((prefix##_t *) cpy)->rval = true;                          \
-    return tmp;                                                 \
-}
-
-// Function declaration of bitwise shift returning rvalue
+#define __BUILD_BINARY(prefix, id, lhs, rhs) {              \
+    if (!(rhs)) {                                           \
+        errno = EINVAL;                                     \
+        return NULL;                                        \
+    }                                                       \
+    prefix##_t *const cpy = prefix##_tmp(lhs);              \
+    if (!cpy)                                               \
+        return NULL;                                        \
+    cpy->rval = false;                                      \
+    return ret_rval(cpy, prefix##_##id##eq(cpy, rhs));      \
+}
+
+/* Function declaration of bitwise shift returning rvalue
+ * Operand is copied, never modified */
 #define   BUILD_SHIFT(id, val, shift)          _BUILD_SHIFT(PREFIX, id, val, shift)
 #define  _BUILD_SHIFT(prefix, id, val, shift) __BUILD_SHIFT(prefix, id, val, shift)
 #define __BUILD_SHIFT(prefix, id, val, shift) {             \
-    if (!(val)->rval)                                       \
-        (val) = prefix##_tmp(val);                          \
+    prefix##_t *const cpy = prefix##_tmp(val);              \
+    if (!cpy)                                               \
+        return NULL;                                        \
+    cpy->rval = false;                                      \
+    return ret_rval(cpy, prefix##_##id##eq(cpy, shift));    \
+}
+
+/* Function declaration of unary operation consuming temporary operand
+ * Result is computed within buffer of temporary; lvalues are copied */
+#define   BUILD_UNARY_TAKE(id, val)          _BUILD_UNARY_TAKE(PREFIX, id, val)
+#define  _BUILD_UNARY_TAKE(prefix, id, val) __BUILD_UNARY_TAKE(prefix, id, val)
+#define __BUILD_UNARY_TAKE(prefix, id, val) {               \
+    if (!(val) || !(val)->rval)                             \
+        return prefix##_##id(val);                          \
+    (val)->rval = false;                                    \
+    return ret_rval(val, prefix##_##id##eq(val));           \
+}
+
+/* Function declaration of binary operation consuming temporary operands
+ * Result is computed within buffer of left operand if temporary,
+ * and right operand is freed if temporary */
+#define   BUILD_BINARY_TAKE(id, lhs, rhs)          _BUILD_BINARY_TAKE(PREFIX, id, lhs, rhs)
+#define  _BUILD_BINARY_TAKE(prefix, id, lhs, rhs) __BUILD_BINARY_TAKE(prefix, id, lhs, rhs)
+#define __BUILD_BINARY_TAKE(prefix, id, lhs, rhs) {         \
     prefix##_t *tmp;                                        \
-    ((prefix##_t *) (val))->rval = false;                   \
-    tmp = prefix##_##id##eq((prefix##_t *) (val), shift);   \
-    ((prefix##_t *) (val))->rval = true;                    \
+    if (!(lhs) || !(rhs)) {                                 \
+        prefix##_drop(lhs);                                 \
+        prefix##_drop(rhs);                                 \
+        errno = EINVAL;                                     \
+        return NULL;                                        \
+    }                                                       \
+    if ((lhs)->rval) {                                      \
+        (lhs)->rval = false;                                \
+        tmp = ret_rval(lhs, prefix##_##id##eq(lhs, rhs));   \
+    } else                                                  \
+        tmp = prefix##_##id(lhs, rhs);                      \
+    if ((rhs) != (lhs))                                     \
+        prefix##_drop(rhs);                                 \
+    return tmp;                                             \
+}
+
+/* Function declaration of binary, commutative operation consuming temporary operands
+ * As above, but computes within buffer of right operand if only it is temporary */
+#define   BUILD_COMMUT_TAKE(id, lhs, rhs)          _BUILD_COMMUT_TAKE(PREFIX, id, lhs, rhs)
+#define  _BUILD_COMMUT_TAKE(prefix, id, lhs, rhs) __BUILD_COMMUT_TAKE(prefix, id, lhs, rhs)
+#define __BUILD_COMMUT_TAKE(prefix, id, lhs, rhs) {         \
+    if ((lhs) && (rhs) && !(lhs)->rval && (rhs)->rval)      \
+        return prefix##_##id##_take(rhs, lhs);              \
+    __BUILD_BINARY_TAKE(prefix, id, lhs, rhs)               \
+}
+
+/* Function declaration of bitwise shift consuming temporary operand
+ * Result is computed within buffer of temporary; lvalues are copied */
+#define   BUILD_SHIFT_TAKE(id, val, shift)          _BUILD_SHIFT_TAKE(PREFIX, id, val, shift)
+#define  _BUILD_SHIFT_TAKE(prefix, id, val, shift) __BUILD_SHIFT_TAKE(prefix, id, val, shift)
+#define __BUILD_SHIFT_TAKE(prefix, id, val, shift) {        \
+    if (!(val) || !(val)->rval)                             \
+        return prefix##_##id(val, shift);                   \
+    (val)->rval = false;                                    \
+    return ret_rval(val, prefix##_##id##eq(val, shift));    \
+}
+
+/* Function declaration of assignment operation consuming temporary operand
+ * Operand is freed after use if temporary */
+#define   BUILD_EQ_TAKE(id, tar, val)          _BUILD_EQ_TAKE(PREFIX, id, tar, val)
+#define  _BUILD_EQ_TAKE(prefix, id, tar, val) __BUILD_EQ_TAKE(prefix, id, tar, val)
+#define __BUILD_EQ_TAKE(prefix, id, tar, val) {             \
+    prefix##_t *const tmp = prefix##_##id##eq(tar, val);    \
+    prefix##_drop(val);                                     \
     return tmp;                                             \
 }
 
@@ -82,6 +121,60 @@
 // Offset from pointer to bit buffer whose address returns an integral value
 #define INTEGR_OFF  (sizeof(integr_t) / sizeof(bitfld_t) - 1)
 
+// Number of bits within a bitfield
+#define BITFLD_BITS     (sizeof(bitfld_t) * 8)
+
+/* Maximum number of bitfields a bit buffer may hold
+ * Ensures # of total bits representable as shift_t */
+#define BITFLD_CT_MAX   (SHIFT_MAX / (sizeof(bitfld_t) * 8))
+
+// Maximum val of a bitfield
+#define BITFLD_MAX      UINTMAX_MAX
+
+// For last field in an integer or float, the position of the sign bit
+#define SIGN_BIT        ((bitfld_t) 1 << sizeof(bitfld_t) * 8 - 1)
+
+// ---- Tuning ----
+
+// Operand sizes, in bitfields, at which asymptotically faster algorithms take over
+#define MUL_KARATSUBA_THRESHOLD 32
+#define SQR_KARATSUBA_THRESHOLD 48
+#define HGCD_THRESHOLD          120
+#define GCD_DC_THRESHOLD        360
+#define GCDEXT_DC_THRESHOLD     300
+
+// Widest window, in bits, of exponent scanned by modular exponentiation
+#define POWM_WINDOW_MAX         6
+
+// Buffer size, in bitfields, from which population counts use AVX2 where available
+#define POPCOUNT_AVX2_THRESHOLD 32
+
+/* # of threads across which independent Miller-Rabin rounds are run,
+ * for candidates of at least PRIME_THREAD_THRESHOLD bitfields
+ * Values above 1 require linking against pthreads */
+#ifndef ARBITRARY_THREADS
+#define ARBITRARY_THREADS       1
+#endif
+#define PRIME_THREAD_THRESHOLD  64
+
+// # of terms from which halves of a series are summed on separate threads
+#define SERIES_THREAD_THRESHOLD 1024
+
+// Memory limit, in bytes, with which the global cache of radix powers starts
+#define RPOW_LIMIT              ((size_t) 16 << 20)
+
+/* Limb kernels with processor-specific variants are bound at load time
+ * through indirect functions (ifunc), where the platform supports them */
+#if defined(__x86_64__) && defined(__ELF__)
+#define ARBITRARY_IFUNC
+#endif
+
+// Double-width bitfield, holds full products and two-bitfield numerators
+typedef unsigned __int128 dbitfld_t;
+
+// Thresholds in effect outside of contexts, as given above
+extern const dwhl_tune_t ln_tune;
+
 // ---- Helper Functions ----
 
 /* Asserts value is lvalue
@@ -97,21 +190,325 @@
     }                                               \
 }
 
+/* Takes private copy of bit buffer shared with other integers, before it is modified in place
+ * If copy fails, returns NULL from caller */
+#define own_bits(tar) {                             \
+    if ((tar)->refs && !dwhl_unshare(tar))          \
+        return NULL;                                \
+}
+
+/* Asserts division is exact, unless NDEBUG is defined
+ * If assertion fails, terminates program */
+#ifdef NDEBUG
+#define assert_exact(exact, tar)
+#else
+#define assert_exact(exact, tar) {                  \
+    if (!(exact)) {                                 \
+        printf(                                     \
+            "arbitrary.h: division is not "         \
+            "exact: (dwhl_t *) %p\n"                \
+        , (void *) (tar));                          \
+        exit(EXIT_FAILURE);                         \
+    }                                               \
+}
+#endif
+
 // Defined, safe addition of x and y, subtracted by difference
 static inline void *ptr_rem(const void *(lhs), const void *(rhs), const void *diff) {
     return (void *) (((ptr_cast((lhs)) >> 1) + (ptr_cast((rhs)) >> 1) - (ptr_cast(diff) >> 1)) << 1);
 }
 
+/* Returns copy holding result, marked as temporary
+ * If operation failed, frees copy and returns NULL */
+static inline dwhl_t *ret_rval(dwhl_t *cpy, const dwhl_t *res) {
+    if (!res) {
+        dwhl_clr(cpy);
+        free(cpy);
+        return NULL;
+    }
+    cpy->rval = true;
+    return cpy;
+}
+
+// Returns final bitfield in bit buffer
+static inline bitfld_t last_fld(const dwhl_t *val) {
+    return val->bits[val->size - 1];
+}
+
+// Returns bitfield extending integer, all ones if negative
+static inline bitfld_t sign_ext(const dwhl_t *val) {
+    return last_fld(val) & SIGN_BIT ? BITFLD_MAX : 0;
+}
+
+// Returns # of leading zero bits in nonzero bitfield
+static inline unsigned bitfld_clz(bitfld_t bits) {
+    return __builtin_clzll(bits);
+}
+
+// Returns # of trailing zero bits in nonzero bitfield
+static inline unsigned bitfld_ctz(bitfld_t bits) {
+    return __builtin_ctzll(bits);
+}
+
+/* Divides two-bitfield numerator by single bitfield, returning quotient
+ * Requires nh < d */
+static inline bitfld_t bitfld_div(bitfld_t nh, bitfld_t nl, bitfld_t d, bitfld_t *rem) {
+#if defined(__x86_64__)
+    bitfld_t quot;
+
+    __asm__("divq %4" : "=a" (quot), "=d" (*rem) : "a" (nl), "d" (nh), "rm" (d));
+    return quot;
+#else
+    const dbitfld_t num = (dbitfld_t) nh << BITFLD_BITS | nl;
+
+    *rem = (bitfld_t) (num % d);
+    return (bitfld_t) (num / d);
+#endif
+}
+
+// Returns inverse of odd bitfield modulo 2^BITFLD_BITS
+static inline bitfld_t bitfld_binvert(bitfld_t bits) {
+    bitfld_t inv = bits;    // Correct to 3 bits, as odd squares are 1 (mod 8)
+
+    // Each Newton step doubles # of correct bits
+    for (int i = 0; i < 5; ++i)
+        inv *= 2 - bits * inv;
+    return inv;
+}
+
+// Returns # of set bits in bitfield
+static inline unsigned bitfld_popcount(bitfld_t bits) {
+    return __builtin_popcountll(bits);
+}
+
 // Returns # of significant bits in bitfield
 static inline unsigned char bitfld_sig(bitfld_t bits) {
-    unsigned char ct = 0;
+    return bits ? BITFLD_BITS - bitfld_clz(bits) : 0;
+}
 
-    while (bits) {
-        bits >>= 1;
-        ++ct;
-    }
-    return ct;
+// ---- Limb Kernels ----
+
+/* Low-level routines operating on little-endian bitfield buffers ("limbs")
+ * Buffers are unsigned magnitudes; sizes are in bitfields
+ * Unless noted otherwise, no routine allocates memory. Routines needing
+ * temporary space take it from `tp', sized by the matching `-itch' function
+ * Routines whose algorithm depends on operand size read thresholds from `tune',
+ * which is `&ln_tune' unless a context supplies its own */
+
+// Returns normalized size of buffer, stripping high zero bitfields
+static inline size_t ln_norm(const bitfld_t *ap, size_t n) {
+    while (n && !ap[n - 1])
+        --n;
+    return n;
 }
 
+/* Returns carry/borrow out of operation
+ * For two-size variants, requires an >= bn */
+bitfld_t ln_add_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n);
+bitfld_t ln_sub_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n);
+bitfld_t ln_add(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn);
+bitfld_t ln_sub(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn);
+bitfld_t ln_add_1(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b);
+bitfld_t ln_sub_1(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b);
+
+/* Multiplies buffer by single bitfield, storing (mul), adding (addmul),
+ * or subtracting (submul) product; returns high bitfield of product
+ * Dispatched at load time to BMI2 and ADX kernels where available */
+bitfld_t ln_mul_1(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b);
+bitfld_t ln_addmul_1(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b);
+bitfld_t ln_submul_1(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b);
+
+/* Shifts buffer by 0 < cnt < BITFLD_BITS; returns bits shifted out
+ * Left shift may be done in place or towards higher addresses; right shift,
+ * in place or towards lower addresses */
+bitfld_t ln_lshift(bitfld_t *rp, const bitfld_t *ap, size_t n, unsigned cnt);
+bitfld_t ln_rshift(bitfld_t *rp, const bitfld_t *ap, size_t n, unsigned cnt);
+
+// Returns # of set bits in buffer, or in XOR of two buffers
+size_t ln_popcount(const bitfld_t *ap, size_t n);
+size_t ln_hamdist(const bitfld_t *ap, const bitfld_t *bp, size_t n);
+
+/* Compares buffers of equal size, returning -1, 0, or 1
+ * Dispatched at load time to AVX-512 or AVX2 where available */
+int ln_cmp(const bitfld_t *ap, const bitfld_t *bp, size_t n);
+
+/* Stores bitwise AND, OR, or XOR of buffers of equal size, or complement of one buffer
+ * rp may equal ap or bp; dispatched at load time like `ln_cmp()' */
+void ln_and_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n);
+void ln_ior_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n);
+void ln_xor_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n);
+void ln_com(bitfld_t *rp, const bitfld_t *ap, size_t n);
+
+/* Stores |a - b| in rp, returning true if a < b
+ * Requires an >= bn; result has an bitfields */
+bool ln_absdiff(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn);
+
+/* Stores product of a and b in rp, which holds an + bn bitfields
+ * Operands may be given in either order; rp may not overlap either
+ * `-tuned' variants read thresholds from `tune'; the others, from `ln_tune' */
+size_t ln_mul_itch(size_t an, size_t bn);
+void ln_mul(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn, bitfld_t *tp);
+size_t ln_mul_tuned_itch(size_t an, size_t bn, const dwhl_tune_t *tune);
+void ln_mul_tuned(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn, bitfld_t *tp,
+  const dwhl_tune_t *tune);
+size_t ln_sqr_itch(size_t n);
+void ln_sqr(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t *tp);
+size_t ln_sqr_tuned_itch(size_t n, const dwhl_tune_t *tune);
+void ln_sqr_tuned(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t *tp, const dwhl_tune_t *tune);
+
+/* Stores high (mulhi) or low (mullo) n bitfields of product of a and b, each n bitfields, in rp
+ * High half falls short of ab / B^n, truncated, by at most `ln_mulhi_err(n)'
+ * rp may not overlap either operand; thresholds are read from `ln_tune' */
+size_t ln_mulhi_itch(size_t n);
+void ln_mulhi(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp);
+size_t ln_mulhi_err(size_t n);
+size_t ln_mullo_itch(size_t n);
+void ln_mullo(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp);
+
+/* Divides buffer by single bitfield, storing quotient in qp
+ * Returns remainder */
+bitfld_t ln_divrem_1(bitfld_t *qp, const bitfld_t *ap, size_t n, bitfld_t d);
+
+// Returns remainder of buffer divided by single bitfield
+bitfld_t ln_mod_1(const bitfld_t *ap, size_t n, bitfld_t d);
+
+/* Divides n by d, storing nn - dn + 1 bitfields of quotient in qp and
+ * remainder in the low dn bitfields of np
+ * Requires nn >= dn and dp[dn - 1] != 0 */
+size_t ln_divrem_itch(size_t nn, size_t dn);
+void ln_divrem(bitfld_t *qp, bitfld_t *np, size_t nn, const bitfld_t *dp, size_t dn, bitfld_t *tp);
+
+/* Stores nn - dn + 1 bitfields of n / d in qp, given that d divides n exactly
+ * Requires nn >= dn and dp[dn - 1] != 0; np is destroyed
+ * Single-bitfield variant reads n bitfields of a, and qp may equal ap */
+void ln_divexact_1(bitfld_t *qp, const bitfld_t *ap, size_t n, bitfld_t d);
+size_t ln_divexact_itch(size_t nn, size_t dn);
+void ln_divexact(bitfld_t *qp, bitfld_t *np, size_t nn, const bitfld_t *dp, size_t dn, bitfld_t *tp);
+
+/* Stores gcd of a and b in gp, returning its size; destroys both operands
+ * Requires a and b normalized and nonzero; ap and bp each hold one spare bitfield */
+size_t ln_gcd_itch(size_t an, size_t bn);
+size_t ln_gcd(bitfld_t *gp, bitfld_t *ap, size_t an, bitfld_t *bp, size_t bn, bitfld_t *tp);
+
+/* As above, additionally storing cofactor magnitude of a in sp and its sign
+ * in `sneg', such that g = s*a (mod b); sp holds max(an, bn) + 2 bitfields */
+size_t ln_gcdext_itch(size_t an, size_t bn);
+size_t ln_gcdext(bitfld_t *gp, bitfld_t *sp, size_t *sn, bool *sneg,
+  bitfld_t *ap, size_t an, bitfld_t *bp, size_t bn, bitfld_t *tp);
+
+/* Stores floor k-th root of a in rp, which holds an/k + 3 bitfields, returning its size
+ * If remp is not NULL, stores a - root^k there and its size in *remn
+ * Requires a normalized and nonzero, and k >= 2 */
+size_t ln_rootrem_itch(size_t an, unsigned long k);
+size_t ln_rootrem(bitfld_t *rp, bitfld_t *remp, size_t *remn, const bitfld_t *ap, size_t an,
+  unsigned long k, bitfld_t *tp);
+
+/* Montgomery reduction modulo odd m of n bitfields, where minv = -1/m (mod 2^BITFLD_BITS)
+ * Stores t / 2^(BITFLD_BITS n) mod m in rp for t < m^2 in tp, which holds 2n bitfields and is destroyed */
+void ln_redc(bitfld_t *rp, bitfld_t *tp, const bitfld_t *mp, size_t n, bitfld_t minv);
+
+/* Stores Montgomery product of a and b, each n bitfields, in rp, which may equal either
+ * Operands may be equal, in which case they are squared */
+size_t ln_mont_mul_itch(size_t n, const dwhl_tune_t *tune);
+void ln_mont_mul(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, const bitfld_t *mp, size_t n,
+  bitfld_t minv, bitfld_t *tp, const dwhl_tune_t *tune);
+
+// Converts a, of any size, to Montgomery form, and back from it
+size_t ln_mont_in_itch(size_t an, size_t n);
+void ln_mont_in(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *mp, size_t n, bitfld_t *tp);
+void ln_mont_out(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *mp, size_t n, bitfld_t minv, bitfld_t *tp);
+
+/* Stores b^e in rp, where b and result are n bitfields in Montgomery form
+ * Requires e normalized and nonzero */
+size_t ln_mont_powm_itch(size_t n, size_t en, const dwhl_tune_t *tune);
+void ln_mont_powm(bitfld_t *rp, const bitfld_t *bp, const bitfld_t *ep, size_t en,
+  const bitfld_t *mp, size_t n, bitfld_t minv, bitfld_t *tp, const dwhl_tune_t *tune);
+
+/* Reduction modulo pseudo-Mersenne m = 2^k - c, of n bitfields, where c fits one bitfield
+ * Returns true and stores k and c if m, normalized and nonzero, has this form with k >= 2 BITFLD_BITS */
+bool ln_pmod_form(const bitfld_t *mp, size_t mn, shift_t *k, bitfld_t *c);
+
+/* Stores x mod m in rp, which holds n bitfields and may not overlap x
+ * x, of any size, is destroyed; xp holds one spare bitfield */
+size_t ln_pmod_red_itch(size_t xn);
+void ln_pmod_red(bitfld_t *rp, bitfld_t *xp, size_t xn, shift_t k, bitfld_t c, bitfld_t *tp);
+
+/* As Montgomery counterparts, for operands and results in ordinary form below m
+ * Exponentiation requires e normalized and nonzero */
+size_t ln_pmod_mul_itch(size_t n, const dwhl_tune_t *tune);
+void ln_pmod_mul(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, shift_t k, bitfld_t c, size_t n,
+  bitfld_t *tp, const dwhl_tune_t *tune);
+size_t ln_pmod_powm_itch(size_t n, size_t en, const dwhl_tune_t *tune);
+void ln_pmod_powm(bitfld_t *rp, const bitfld_t *bp, const bitfld_t *ep, size_t en, shift_t k, bitfld_t c,
+  size_t n, bitfld_t *tp, const dwhl_tune_t *tune);
+
+/* Stores b^e mod m in rp, which holds n bitfields, returning its size
+ * Requires m and e normalized and nonzero, and m > 1 */
+size_t ln_powm_itch(size_t bn, size_t en, size_t n, const dwhl_tune_t *tune);
+size_t ln_powm(bitfld_t *rp, const bitfld_t *bp, size_t bn, const bitfld_t *ep, size_t en,
+  const bitfld_t *mp, size_t n, bitfld_t *tp, const dwhl_tune_t *tune);
+
+// ---- dwhl_t Internals ----
+
+/* Stores magnitude of integer in dst, which holds val->size bitfields
+ * Returns normalized size of magnitude */
+size_t get_abs(bitfld_t *dst, const dwhl_t *val);
+
+/* Assigns signed magnitude to integer, growing its buffer if needed
+ * Returns NULL and sets errno on internal error */
+dwhl_t *set_abs(dwhl_t *tar, const bitfld_t *src, size_t n, bool neg);
+
+/* Completes result whose bitfields past the top of the buffer are `ext', then the sign given by `neg',
+ * appending up to two bitfields
+ * Returns NULL and sets errno on internal error */
+dwhl_t *put_top(dwhl_t *tar, bitfld_t ext, bool neg);
+
+/* Grows bit buffer to `resize' bitfields, sign-extending the integer
+ * Returns NULL and sets errno on internal error */
+dwhl_t *extend(dwhl_t *tar, size_t resize);
+
+/* Heavy operations, taking scratch space from tp, which holds as many bitfields as the matching
+ * `-itch' function returns, and thresholds from `tune'
+ * Operands are already checked: none are NULL and tar is an lvalue; other operands are only read
+ * Return NULL and set errno on error */
+size_t div_itch(const dwhl_t *tar, const dwhl_t *val);
+dwhl_t *do_div(dwhl_t *tar, const dwhl_t *val, bool rem, bitfld_t *tp);
+size_t mul_itch(const dwhl_t *tar, const dwhl_t *val, const dwhl_tune_t *tune);
+dwhl_t *do_mul(dwhl_t *tar, const dwhl_t *val, bitfld_t *tp, const dwhl_tune_t *tune);
+size_t powm_itch(const dwhl_t *tar, const dwhl_t *exp, const dwhl_t *mod, const dwhl_tune_t *tune);
+dwhl_t *do_powm(dwhl_t *tar, const dwhl_t *exp, const dwhl_t *mod, bitfld_t *tp, const dwhl_tune_t *tune);
+
+// ---- Radix Power Internals ----
+
+// Returns # of bitfields holding base^k
+size_t rpow_size(unsigned base, size_t k);
+
+/* Stores base^k in rp, which holds `rpow_size(base, k)' bitfields, multiplying powers kept
+ * in cache, or in the global cache if NULL
+ * Returns normalized size, or 0 and sets errno on internal error */
+size_t rpow_get(bitfld_t *rp, unsigned base, size_t k, dwhl_rpow_cache_t *cache);
+
+// ---- ddec_t Internals ----
+
+/* Powers of ten are taken from cache, or from the global cache if NULL, so that
+ * operations ending in `_ctx' use the cache of their context */
+
+/* Multiplies integer by 10^k in place
+ * Returns NULL and sets errno on internal error */
+dwhl_t *mul_pow10(dwhl_t *tar, size_t k, dwhl_rpow_cache_t *cache);
+
+/* Assigns val / 10^k to tar, rounded once by `rules' of a decimal; tar may be val
+ * Returns NULL and sets errno on internal error */
+dwhl_t *div_pow10(dwhl_t *tar, const dwhl_t *val, size_t k, int rules, dwhl_rpow_cache_t *cache);
+
+/* Operations behind `ddec_addeq()', `ddec_subeq()', `ddec_diveq()', `ddec_muleq()', and `ddec_rescale()'
+ * Operands are already checked: none are NULL
+ * If val of `add_scaled()' has more decimal places, the exact sum is formed at its scale, then rounded
+ * Return NULL and set errno on error */
+ddec_t *add_scaled(ddec_t *tar, const ddec_t *val, bool sub, dwhl_rpow_cache_t *cache);
+ddec_t *div_scaled(ddec_t *tar, const ddec_t *val, dwhl_rpow_cache_t *cache);
+ddec_t *do_rescale(ddec_t *tar, size_t scale, dwhl_rpow_cache_t *cache);
+ddec_t *mul_scaled(ddec_t *tar, const ddec_t *val, dwhl_rpow_cache_t *cache);
+
 #include <ladle/common/end_header.h>
 #endif  // #ifndef LADLE_ARBITRARY_GLOBAL_H
\ No newline at end of file
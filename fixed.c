@@ -0,0 +1,213 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#define PREFIX  dwhl
+
+/* Fixed-width integers
+ *
+ * Values are unsigned and wrap modulo 2^width, held in place within their
+ * struct, so arithmetic never allocates and never fails once its operands are
+ * checked. Each width is built from the same helpers, which take their size
+ * as a constant; inlined into the functions of one width, loops over whole
+ * integers have a fixed trip count, and are unrolled into straight carry chains.
+ *
+ * Products are accumulated in a local buffer, so operands may alias. */
+
+// ---- Constants ----
+
+// # of bitfields in widest fixed-width integer
+#define FIXED_CT_MAX    (1024 / BITFLD_BITS)
+
+// ---- Helper Functions ----
+
+/* Defines operations on fixed-width integer of w bits, held in n bitfields
+ * Arguments are checked here; helpers assume valid operands */
+#define BUILD_FIXED(w, n)                                                                       \
+    export dwhl##w##_t *dwhl##w##_addeq(dwhl##w##_t *tar, const dwhl##w##_t *val) {             \
+        if (!tar || !val) {                                                                     \
+            errno = EINVAL;                                                                     \
+            return NULL;                                                                        \
+        }                                                                                       \
+        fx_add(tar->bits, val->bits, n);                                                        \
+        return tar;                                                                             \
+    }                                                                                           \
+    export dwhl##w##_t *dwhl##w##_subeq(dwhl##w##_t *tar, const dwhl##w##_t *val) {             \
+        if (!tar || !val) {                                                                     \
+            errno = EINVAL;                                                                     \
+            return NULL;                                                                        \
+        }                                                                                       \
+        fx_sub(tar->bits, val->bits, n);                                                        \
+        return tar;                                                                             \
+    }                                                                                           \
+    export dwhl##w##_t *dwhl##w##_muleq(dwhl##w##_t *tar, const dwhl##w##_t *val) {             \
+        if (!tar || !val) {                                                                     \
+            errno = EINVAL;                                                                     \
+            return NULL;                                                                        \
+        }                                                                                       \
+        fx_mul(tar->bits, val->bits, n);                                                        \
+        return tar;                                                                             \
+    }                                                                                           \
+    export dwhl##w##_t *dwhl##w##_lshifteq(dwhl##w##_t *tar, shift_t shift) {                   \
+        if (!tar) {                                                                             \
+            errno = EINVAL;                                                                     \
+            return NULL;                                                                        \
+        }                                                                                       \
+        fx_lshift(tar->bits, shift, n);                                                         \
+        return tar;                                                                             \
+    }                                                                                           \
+    export dwhl##w##_t *dwhl##w##_rshifteq(dwhl##w##_t *tar, shift_t shift) {                   \
+        if (!tar) {                                                                             \
+            errno = EINVAL;                                                                     \
+            return NULL;                                                                        \
+        }                                                                                       \
+        fx_rshift(tar->bits, shift, n);                                                         \
+        return tar;                                                                             \
+    }                                                                                           \
+    export int dwhl##w##_cmp(const dwhl##w##_t *lhs, const dwhl##w##_t *rhs) {                  \
+        if (!lhs || !rhs) {                                                                     \
+            errno = EINVAL;                                                                     \
+            return 2;                                                                           \
+        }                                                                                       \
+        return fx_cmp(lhs->bits, rhs->bits, n);                                                 \
+    }                                                                                           \
+    export dwhl##w##_t *dwhl##w##_equ(dwhl##w##_t *tar, uintegr_t val) {                        \
+        if (!tar) {                                                                             \
+            errno = EINVAL;                                                                     \
+            return NULL;                                                                        \
+        }                                                                                       \
+        tar->bits[0] = val;                                                                     \
+        memset(tar->bits + 1, 0, (n - 1) * sizeof(bitfld_t));                                   \
+        return tar;                                                                             \
+    }                                                                                           \
+    export dwhl##w##_t *dwhl##w##_eqi(dwhl##w##_t *tar, const dwhl_t *val) {                    \
+        if (!tar || !val) {                                                                     \
+            errno = EINVAL;                                                                     \
+            return NULL;                                                                        \
+        }                                                                                       \
+        fx_from(tar->bits, val, n);                                                             \
+        return tar;                                                                             \
+    }                                                                                           \
+    export dwhl_t *dwhl_eq##w(dwhl_t *tar, const dwhl##w##_t *val) {                            \
+        if (!tar || !val) {                                                                     \
+            errno = EINVAL;                                                                     \
+            return NULL;                                                                        \
+        }                                                                                       \
+        assert_lval(tar);                                                                       \
+        return set_abs(tar, val->bits, n, false);                                               \
+    }                                                                                           \
+    export dwhl_t *dwhl_init##w(dwhl_t *tar, const dwhl##w##_t *val) {                          \
+        if (!tar || !val) {                                                                     \
+            errno = EINVAL;                                                                     \
+            return NULL;                                                                        \
+        }                                                                                       \
+        *tar = (dwhl_t) {NULL, 0, false, NULL};                                                 \
+        return set_abs(tar, val->bits, n, false);                                               \
+    }
+
+static inline void fx_add(bitfld_t *, const bitfld_t *, size_t);
+static inline int fx_cmp(const bitfld_t *, const bitfld_t *, size_t);
+static inline void fx_from(bitfld_t *, const dwhl_t *, size_t);
+static inline void fx_lshift(bitfld_t *, shift_t, size_t);
+static inline void fx_mul(bitfld_t *, const bitfld_t *, size_t);
+static inline void fx_rshift(bitfld_t *, shift_t, size_t);
+static inline void fx_sub(bitfld_t *, const bitfld_t *, size_t);
+
+// Adds n bitfields of ap to rp, dropping final carry
+void fx_add(bitfld_t *rp, const bitfld_t *ap, size_t n) {
+    bitfld_t sum;
+    bool carry = false, tmp;
+
+#pragma GCC unroll 16
+    for (size_t i = 0; i < n; ++i) {
+        tmp = __builtin_add_overflow(rp[i], ap[i], &sum);
+        carry = __builtin_add_overflow(sum, (bitfld_t) carry, &rp[i]) | tmp;
+    }
+}
+
+// Compares n bitfields as unsigned integers
+int fx_cmp(const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+#pragma GCC unroll 16
+    while (n--) {
+        if (ap[n] != bp[n])
+            return ap[n] > bp[n] ? 1 : -1;
+    }
+    return 0;
+}
+
+// Stores low n bitfields of integer in rp, sign-extending if shorter
+void fx_from(bitfld_t *rp, const dwhl_t *val, size_t n) {
+    const size_t m = val->size < n ? val->size : n;
+
+    memcpy(rp, val->bits, m * sizeof(bitfld_t));
+    memset(rp + m, sign_ext(val) ? 0xff : 0, (n - m) * sizeof(bitfld_t));
+}
+
+// Shifts n bitfields left in place, dropping bits shifted out
+void fx_lshift(bitfld_t *rp, shift_t shift, size_t n) {
+    const size_t move = shift / BITFLD_BITS < n ? shift / BITFLD_BITS : n;
+    const unsigned rem = shift % BITFLD_BITS;
+
+    for (size_t i = n; i-- > move;) {
+        rp[i] = rp[i - move] << rem;
+        if (rem && i > move)
+            rp[i] |= rp[i - move - 1] >> (BITFLD_BITS - rem);
+    }
+    memset(rp, 0, move * sizeof(bitfld_t));
+}
+
+// Multiplies n bitfields of rp by those of ap, keeping low n bitfields of product
+void fx_mul(bitfld_t *rp, const bitfld_t *ap, size_t n) {
+    bitfld_t prod[FIXED_CT_MAX] = {0};
+
+#pragma GCC unroll 16
+    for (size_t i = 0; i < n; ++i) {
+        bitfld_t carry = 0;
+
+#pragma GCC unroll 16
+        for (size_t j = 0; i + j < n; ++j) {
+            const dbitfld_t sum = (dbitfld_t) rp[i] * ap[j] + prod[i + j] + carry;
+
+            prod[i + j] = (bitfld_t) sum;
+            carry = (bitfld_t) (sum >> BITFLD_BITS);
+        }
+    }
+    memcpy(rp, prod, n * sizeof(bitfld_t));
+}
+
+// Shifts n bitfields right in place, logically
+void fx_rshift(bitfld_t *rp, shift_t shift, size_t n) {
+    const size_t move = shift / BITFLD_BITS < n ? shift / BITFLD_BITS : n;
+    const unsigned rem = shift % BITFLD_BITS;
+
+    for (size_t i = 0; i + move < n; ++i) {
+        rp[i] = rp[i + move] >> rem;
+        if (rem && i + move + 1 < n)
+            rp[i] |= rp[i + move + 1] << (BITFLD_BITS - rem);
+    }
+    memset(rp + (n - move), 0, move * sizeof(bitfld_t));
+}
+
+// Subtracts n bitfields of ap from rp, dropping final borrow
+void fx_sub(bitfld_t *rp, const bitfld_t *ap, size_t n) {
+    bitfld_t diff;
+    bool borrow = false, tmp;
+
+#pragma GCC unroll 16
+    for (size_t i = 0; i < n; ++i) {
+        tmp = __builtin_sub_overflow(rp[i], ap[i], &diff);
+        borrow = __builtin_sub_overflow(diff, (bitfld_t) borrow, &rp[i]) | tmp;
+    }
+}
+
+// ---- Fixed-width Integers ----
+
+BUILD_FIXED(256, 4)
+BUILD_FIXED(512, 8)
+BUILD_FIXED(1024, 16)
@@ -0,0 +1,1011 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#define PREFIX  dwhl
+
+/* Greatest common divisors
+ *
+ * Small operands are reduced by Lehmer steps, each built from the top two
+ * bitfields of both operands (`hgcd2()') and applied as a 2x2 matrix of
+ * single-bitfield cofactors. Above GCD_DC_THRESHOLD, the half-gcd
+ * (`hgcd()') of the top part of both operands is computed recursively and
+ * applied to the full operands, giving subquadratic running time.
+ *
+ * Reduction matrices M have nonnegative entries and determinant 1, with
+ * (a; b) = M (a'; b') for original operands (a, b) and reduced (a', b').
+ * All temporary space is taken from one caller-supplied buffer. */
+
+// ---- Constants ----
+
+// Temporary space for reduction matrix of operands of n bitfields
+#define MAT_ITCH(n)     (4 * (((n) + 1) / 2 + 1))
+
+// ---- Types ----
+
+// Reduction matrix built by `hgcd()', each entry holding `alloc' bitfields
+typedef struct {
+    size_t alloc, n;
+    bitfld_t *p[2][2];
+} hmat_t;
+
+// Reduction matrix with single-bitfield entries, built by `hgcd2()'
+typedef struct {
+    bitfld_t u[2][2];
+} hmat1_t;
+
+/* Called by `subdiv_step()' when a quotient is applied or the gcd is found
+ * For quotients, `d' is 1 if the first operand was reduced, or 0 if the second was
+ * For the gcd, `d' is the operand whose cofactor applies, or -1 if either does */
+typedef void gcd_hook_t(void *ctx, const bitfld_t *gp, size_t gn,
+  const bitfld_t *qp, size_t qn, int d, bitfld_t *tp);
+
+// State of `ln_gcd()'
+typedef struct {
+    bitfld_t *gp;
+    size_t gn;
+} gcd_ctx_t;
+
+/* State of `ln_gcdext()'
+ * Cofactors of first original operand in current operands are +ux and -uy,
+ * both zero past `un' bitfields */
+typedef struct {
+    bitfld_t *gp, *ux, *uy, *sp;
+    size_t gn, un, *sn;
+    bool *sneg;
+} gcdext_ctx_t;
+
+// ---- Helper Functions ----
+
+static void cofactor_mat(gcdext_ctx_t *, const hmat_t *, bitfld_t *);
+static void cofactor_mat1(gcdext_ctx_t *, const hmat1_t *, bitfld_t *);
+static dbitfld_t gcd_22(dbitfld_t, dbitfld_t);
+static void gcd_hook(void *, const bitfld_t *, size_t, const bitfld_t *, size_t, int, bitfld_t *);
+static void gcdext_hook(void *, const bitfld_t *, size_t, const bitfld_t *, size_t, int, bitfld_t *);
+static size_t hgcd(bitfld_t *, bitfld_t *, size_t, hmat_t *, bitfld_t *);
+static bool hgcd2(bitfld_t, bitfld_t, bitfld_t, bitfld_t, hmat1_t *);
+static void hgcd_hook(void *, const bitfld_t *, size_t, const bitfld_t *, size_t, int, bitfld_t *);
+static size_t hgcd_itch(size_t);
+static size_t hgcd_step(size_t, bitfld_t *, bitfld_t *, size_t, hmat_t *, bitfld_t *);
+static size_t mat_adjust(const hmat_t *, size_t, bitfld_t *, bitfld_t *, size_t, bitfld_t *);
+static void mat_init(hmat_t *, size_t, bitfld_t *);
+static void mat_mul(hmat_t *, const hmat_t *, bitfld_t *);
+static void mat_mul_1(hmat_t *, const hmat1_t *, bitfld_t *);
+static void mat_update_q(hmat_t *, const bitfld_t *, size_t, unsigned, bitfld_t *);
+static size_t mul1_inverse_vector(const hmat1_t *, bitfld_t *, const bitfld_t *, bitfld_t *, size_t);
+static size_t mul_mat1_vector(const hmat1_t *, bitfld_t *, const bitfld_t *, bitfld_t *, size_t);
+static size_t step_itch(size_t);
+static size_t subdiv_step(bitfld_t *, bitfld_t *, size_t, size_t, gcd_hook_t *, void *, bitfld_t *);
+static void top_bits(const bitfld_t *, const bitfld_t *, size_t, bitfld_t [4]);
+
+static inline unsigned dbitfld_ctz(dbitfld_t);
+static inline bitfld_t div2(bitfld_t *, bitfld_t *, bitfld_t, bitfld_t);
+static inline void sub_dd(bitfld_t *, bitfld_t *, bitfld_t, bitfld_t);
+
+// Applies inverse of reduction matrix to cofactors
+void cofactor_mat(gcdext_ctx_t *ctx, const hmat_t *M, bitfld_t *tp) {
+    const size_t mn = M->n, un = ctx->un, rn = mn + un;
+    bitfld_t *t0 = tp, *t1 = tp + rn + 1, *t2 = t1 + rn + 1, *ts = t2 + rn;
+    size_t n0, n1;
+
+    // ux' = m11 ux + m01 uy, uy' = m10 ux + m00 uy
+    ln_mul(t0, M->p[1][1], mn, ctx->ux, un, ts);
+    ln_mul(t2, M->p[0][1], mn, ctx->uy, un, ts);
+    t0[rn] = ln_add_n(t0, t0, t2, rn);
+    ln_mul(t1, M->p[1][0], mn, ctx->ux, un, ts);
+    ln_mul(t2, M->p[0][0], mn, ctx->uy, un, ts);
+    t1[rn] = ln_add_n(t1, t1, t2, rn);
+    n0 = ln_norm(t0, rn + 1);
+    n1 = ln_norm(t1, rn + 1);
+    ctx->un = n0 > n1 ? n0 : n1;
+    memcpy(ctx->ux, t0, ctx->un * sizeof(bitfld_t));
+    memcpy(ctx->uy, t1, ctx->un * sizeof(bitfld_t));
+}
+
+// Applies inverse of single-bitfield reduction matrix to cofactors
+void cofactor_mat1(gcdext_ctx_t *ctx, const hmat1_t *M1, bitfld_t *tp) {
+    const size_t un = ctx->un;
+    bitfld_t hx, hy;
+
+    memcpy(tp, ctx->ux, un * sizeof(bitfld_t));
+    hx = ln_mul_1(ctx->ux, ctx->ux, un, M1->u[1][1]);
+    hx += ln_addmul_1(ctx->ux, ctx->uy, un, M1->u[0][1]);
+    hy = ln_mul_1(ctx->uy, ctx->uy, un, M1->u[0][0]);
+    hy += ln_addmul_1(ctx->uy, tp, un, M1->u[1][0]);
+    ctx->ux[un] = hx;
+    ctx->uy[un] = hy;
+    ctx->un += (hx | hy) != 0;
+}
+
+// Binary gcd of double-width operands
+dbitfld_t gcd_22(dbitfld_t u, dbitfld_t v) {
+    if (!u || !v)
+        return u | v;
+
+    const unsigned shift = dbitfld_ctz(u | v);
+    dbitfld_t tmp;
+
+    u >>= dbitfld_ctz(u);
+    do {
+        v >>= dbitfld_ctz(v);
+        if (u > v) {
+            tmp = u;
+            u = v;
+            v = tmp;
+        }
+        v -= u;
+    } while (v);
+    return u << shift;
+}
+
+// Records gcd
+void gcd_hook(void *p, const bitfld_t *gp, size_t gn, const bitfld_t *qp, size_t qn, int d, bitfld_t *tp) {
+    gcd_ctx_t *ctx = p;
+
+    (void) qp, (void) qn, (void) d, (void) tp;
+    if (gp) {
+        memcpy(ctx->gp, gp, gn * sizeof(bitfld_t));
+        ctx->gn = gn;
+    }
+}
+
+// Records gcd and its cofactor, or applies quotient to cofactors
+void gcdext_hook(void *p, const bitfld_t *gp, size_t gn, const bitfld_t *qp, size_t qn, int d, bitfld_t *tp) {
+    gcdext_ctx_t *ctx = p;
+
+    if (gp) {
+        memcpy(ctx->gp, gp, gn * sizeof(bitfld_t));
+        ctx->gn = gn;
+        if (d < 0)  // Either cofactor applies, so return the smaller one
+            d = ln_cmp(ctx->uy, ctx->ux, ctx->un) < 0;
+
+        const bitfld_t *src = d ? ctx->uy : ctx->ux;
+
+        *ctx->sn = ln_norm(src, ctx->un);
+        *ctx->sneg = d && *ctx->sn;
+        memcpy(ctx->sp, src, *ctx->sn * sizeof(bitfld_t));
+        return;
+    }
+
+    // First operand reduced by q times second: ux += q uy; otherwise uy += q ux
+    bitfld_t *dst = d ? ctx->ux : ctx->uy, carry;
+    const bitfld_t *src = d ? ctx->uy : ctx->ux;
+    const size_t un = ctx->un, srcn = ln_norm(src, un);
+    size_t len;
+
+    qn = ln_norm(qp, qn);
+    if (!qn || !srcn)   // Quotient may be zero after correction in `subdiv_step()'
+        return;
+    if (qn == 1) {
+        carry = ln_addmul_1(dst, src, srcn, qp[0]);
+        carry = ln_add_1(dst + srcn, dst + srcn, un - srcn, carry);
+        len = un;
+    } else {
+        len = qn + srcn;
+        ln_mul(tp, src, srcn, qp, qn, tp + len);
+        if (len >= un)
+            carry = ln_add(dst, tp, len, dst, un);
+        else {
+            carry = ln_add(dst, dst, un, tp, len);
+            len = un;
+        }
+    }
+    dst[len] = carry;
+    len += carry != 0;
+    ctx->un = len > un ? len : un;
+}
+
+/* Computes half-gcd of a and b, which have n bitfields
+ * Reduces both operands until they are just above n/2 + 1 bitfields,
+ * accumulating the reduction in M. Returns new size, or 0 if no reduction
+ * was possible, in which case a and b are unchanged */
+size_t hgcd(bitfld_t *ap, bitfld_t *bp, size_t n, hmat_t *M, bitfld_t *tp) {
+    const size_t s = n / 2 + 1;
+    size_t nn;
+    bool success = false;
+
+    if (n <= s)
+        return 0;
+    if (n >= HGCD_THRESHOLD) {
+        const size_t n2 = 3 * n / 4 + 1;
+        size_t p = n / 2;
+
+        // Reduce top half, then apply to full operands
+        if ((nn = hgcd(ap + p, bp + p, n - p, M, tp))) {
+            n = mat_adjust(M, p + nn, ap, bp, p, tp);
+            success = true;
+        }
+        while (n > n2) {
+            if (!(nn = hgcd_step(n, ap, bp, s, M, tp)))
+                return success ? n : 0;
+            n = nn;
+            success = true;
+        }
+        if (n > s + 2) {    // Reduce remaining top part
+            hmat_t M1;
+
+            p = 2 * s - n + 1;
+
+            const size_t scratch = MAT_ITCH(n - p);
+
+            mat_init(&M1, n - p, tp);
+            if ((nn = hgcd(ap + p, bp + p, n - p, &M1, tp + scratch))) {
+                n = mat_adjust(&M1, p + nn, ap, bp, p, tp + scratch);
+                mat_mul(M, &M1, tp + scratch);
+                success = true;
+            }
+        }
+    }
+    for (;;) {
+        if (!(nn = hgcd_step(n, ap, bp, s, M, tp)))
+            return success ? n : 0;
+        n = nn;
+        success = true;
+    }
+}
+
+/* Reduces two-bitfield approximations of a and b, stopping while both
+ * remainders are above one bitfield so the quotients remain exact
+ * Returns false if no reduction is possible
+ * Requires most significant bit of larger operand to be set */
+bool hgcd2(bitfld_t ah, bitfld_t al, bitfld_t bh, bitfld_t bl, hmat1_t *M) {
+    const bitfld_t half = (bitfld_t) 1 << BITFLD_BITS / 2,
+      lim = (bitfld_t) 1 << (BITFLD_BITS / 2 + 1);
+    bitfld_t u00, u01, u10, u11, q;
+
+    if (ah < 2 || bh < 2)
+        return false;
+    if (ah > bh || (ah == bh && al > bl)) {
+        sub_dd(&ah, &al, bh, bl);
+        if (ah < 2)
+            return false;
+        u00 = u01 = u11 = 1;
+        u10 = 0;
+    } else {
+        sub_dd(&bh, &bl, ah, al);
+        if (bh < 2)
+            return false;
+        u00 = u10 = u11 = 1;
+        u01 = 0;
+    }
+    if (ah < bh)
+        goto subtract_a;
+
+    // Double precision, until high bitfield of either operand falls below half
+    for (;;) {
+        if (ah == bh)
+            goto done;
+        if (ah < half) {
+            ah = ah << BITFLD_BITS / 2 | al >> BITFLD_BITS / 2;
+            bh = bh << BITFLD_BITS / 2 | bl >> BITFLD_BITS / 2;
+            break;
+        }
+
+        // a -= q b, so M *= (1 q; 0 1)
+        sub_dd(&ah, &al, bh, bl);
+        if (ah < 2)
+            goto done;
+        if (ah <= bh) {
+            u01 += u00;
+            u11 += u10;
+        } else {
+            q = div2(&ah, &al, bh, bl);
+            if (ah < 2) {   // Remainder too small, but q is exact
+                u01 += q * u00;
+                u11 += q * u10;
+                goto done;
+            }
+            ++q;
+            u01 += q * u00;
+            u11 += q * u10;
+        }
+    subtract_a:
+        if (ah == bh)
+            goto done;
+        if (bh < half) {
+            ah = ah << BITFLD_BITS / 2 | al >> BITFLD_BITS / 2;
+            bh = bh << BITFLD_BITS / 2 | bl >> BITFLD_BITS / 2;
+            goto subtract_a1;
+        }
+
+        // b -= q a, so M *= (1 0; q 1)
+        sub_dd(&bh, &bl, ah, al);
+        if (bh < 2)
+            goto done;
+        if (ah >= bh) {
+            u00 += u01;
+            u10 += u11;
+        } else {
+            q = div2(&bh, &bl, ah, al);
+            if (bh < 2) {
+                u00 += q * u01;
+                u10 += q * u11;
+                goto done;
+            }
+            ++q;
+            u00 += q * u01;
+            u10 += q * u11;
+        }
+    }
+
+    // Single precision, on top 1.5 bitfields of each operand
+    for (;;) {
+        ah -= bh;
+        if (ah < lim)
+            break;
+        if (ah <= bh) {
+            u01 += u00;
+            u11 += u10;
+        } else {
+            q = ah / bh;
+            ah %= bh;
+            if (ah < lim) {
+                u01 += q * u00;
+                u11 += q * u10;
+                break;
+            }
+            ++q;
+            u01 += q * u00;
+            u11 += q * u10;
+        }
+    subtract_a1:
+        bh -= ah;
+        if (bh < lim)
+            break;
+        if (ah >= bh) {
+            u00 += u01;
+            u10 += u11;
+        } else {
+            q = bh / ah;
+            bh %= ah;
+            if (bh < lim) {
+                u00 += q * u01;
+                u10 += q * u11;
+                break;
+            }
+            ++q;
+            u00 += q * u01;
+            u10 += q * u11;
+        }
+    }
+done:
+    M->u[0][0] = u00, M->u[0][1] = u01;
+    M->u[1][0] = u10, M->u[1][1] = u11;
+    return true;
+}
+
+// Applies quotient to reduction matrix
+void hgcd_hook(void *p, const bitfld_t *gp, size_t gn, const bitfld_t *qp, size_t qn, int d, bitfld_t *tp) {
+    (void) gp, (void) gn;   // Never called with gcd, as hgcd() stops early
+    if ((qn = ln_norm(qp, qn)))
+        mat_update_q(p, qp, qn, d, tp);
+}
+
+// Temporary space for `hgcd()' on operands of n bitfields
+size_t hgcd_itch(size_t n) {
+    if (n < HGCD_THRESHOLD)
+        return step_itch(n);
+
+    const size_t m = n - n / 2, alloc = (n + 1) / 2 + 1;
+    size_t itch = step_itch(n), tmp;
+
+    if ((tmp = hgcd_itch(m)) > itch)
+        itch = tmp;
+    if ((tmp = 2 * (n + alloc) + ln_mul_itch(n, alloc)) > itch)    // mat_adjust()
+        itch = tmp;
+    if ((tmp = 6 * alloc + ln_mul_itch(alloc, alloc)) > itch)       // mat_mul()
+        itch = tmp;
+    return MAT_ITCH(m) + itch;
+}
+
+/* Performs one Lehmer step, or one division step if that fails
+ * Returns new size, or 0 if reduction would leave either operand at s
+ * or fewer bitfields */
+size_t hgcd_step(size_t n, bitfld_t *ap, bitfld_t *bp, size_t s, hmat_t *M, bitfld_t *tp) {
+    bitfld_t top[4];
+    hmat1_t M1;
+
+    if (n == s + 1) {
+        if ((ap[n - 1] | bp[n - 1]) < 4)
+            goto subtract;
+        top[0] = ap[n - 1], top[1] = ap[n - 2];
+        top[2] = bp[n - 1], top[3] = bp[n - 2];
+    } else
+        top_bits(ap, bp, n, top);
+    if (hgcd2(top[0], top[1], top[2], top[3], &M1)) {
+        mat_mul_1(M, &M1, tp);
+        memcpy(tp, ap, n * sizeof(bitfld_t));
+        return mul1_inverse_vector(&M1, ap, tp, bp, n);
+    }
+subtract:
+    return subdiv_step(ap, bp, n, s, hgcd_hook, M, tp);
+}
+
+/* Applies reduction of top parts of a and b to their low p bitfields
+ * Top n - p bitfields of each operand hold the reduced top parts
+ * Returns new size; a and b each hold one spare bitfield */
+size_t mat_adjust(const hmat_t *M, size_t n, bitfld_t *ap, bitfld_t *bp, size_t p, bitfld_t *tp) {
+    const size_t mn = M->n;
+    bitfld_t *t0 = tp, *t1 = tp + p + mn, *ts = t1 + p + mn, ah, bh;
+
+    // (a; b) = (m11 a - m01 b; m00 b - m10 a), computing terms of a first
+    ln_mul(t0, M->p[1][1], mn, ap, p, ts);
+    ln_mul(t1, M->p[1][0], mn, ap, p, ts);
+    memcpy(ap, t0, p * sizeof(bitfld_t));
+    ah = ln_add(ap + p, ap + p, n - p, t0 + p, mn);
+    ln_mul(t0, M->p[0][1], mn, bp, p, ts);
+    ah -= ln_sub(ap, ap, n, t0, p + mn);
+    ln_mul(t0, M->p[0][0], mn, bp, p, ts);
+    memcpy(bp, t0, p * sizeof(bitfld_t));
+    bh = ln_add(bp + p, bp + p, n - p, t0 + p, mn);
+    bh -= ln_sub(bp, bp, n, t1, p + mn);
+    if (ah | bh) {
+        ap[n] = ah;
+        bp[n] = bh;
+        return n + 1;
+    }
+    while (!(ap[n - 1] | bp[n - 1]))
+        --n;
+    return n;
+}
+
+// Initializes identity matrix for operands of n bitfields
+void mat_init(hmat_t *M, size_t n, bitfld_t *p) {
+    const size_t alloc = (n + 1) / 2 + 1;
+
+    memset(p, 0, 4 * alloc * sizeof(bitfld_t));
+    M->alloc = alloc;
+    M->n = 1;
+    M->p[0][0] = p;
+    M->p[0][1] = p + alloc;
+    M->p[1][0] = p + 2 * alloc;
+    M->p[1][1] = p + 3 * alloc;
+    M->p[0][0][0] = M->p[1][1][0] = 1;
+}
+
+// Multiplies M by M1 from the right
+void mat_mul(hmat_t *M, const hmat_t *M1, bitfld_t *tp) {
+    const size_t an = M->n, bn = M1->n, rn = an + bn;
+    bitfld_t *x = tp, *y = tp + rn, *z = tp + 2 * rn, *ts = tp + 3 * rn, c0, c1;
+    size_t n = rn + 1;
+
+    for (unsigned row = 0; row < 2; ++row) {
+        ln_mul(x, M->p[row][0], an, M1->p[0][0], bn, ts);
+        ln_mul(y, M->p[row][1], an, M1->p[1][0], bn, ts);
+        c0 = ln_add_n(x, x, y, rn);
+        ln_mul(y, M->p[row][0], an, M1->p[0][1], bn, ts);
+        ln_mul(z, M->p[row][1], an, M1->p[1][1], bn, ts);
+        c1 = ln_add_n(y, y, z, rn);
+        memcpy(M->p[row][0], x, rn * sizeof(bitfld_t));
+        memcpy(M->p[row][1], y, rn * sizeof(bitfld_t));
+        M->p[row][0][rn] = c0;
+        M->p[row][1][rn] = c1;
+    }
+    while (n > 1 && !(M->p[0][0][n - 1] | M->p[0][1][n - 1] | M->p[1][0][n - 1] | M->p[1][1][n - 1]))
+        --n;
+    M->n = n;
+}
+
+// Multiplies M by single-bitfield M1 from the right
+void mat_mul_1(hmat_t *M, const hmat1_t *M1, bitfld_t *tp) {
+    size_t n0, n1;
+
+    memcpy(tp, M->p[0][0], M->n * sizeof(bitfld_t));
+    n0 = mul_mat1_vector(M1, M->p[0][0], tp, M->p[0][1], M->n);
+    memcpy(tp, M->p[1][0], M->n * sizeof(bitfld_t));
+    n1 = mul_mat1_vector(M1, M->p[1][0], tp, M->p[1][1], M->n);
+    M->n = n0 > n1 ? n0 : n1;
+}
+
+// Adds q times column 1 - col of matrix to column col
+void mat_update_q(hmat_t *M, const bitfld_t *qp, size_t qn, unsigned col, bitfld_t *tp) {
+    bitfld_t carry[2];
+    size_t n = M->n;
+
+    if (qn == 1) {
+        carry[0] = ln_addmul_1(M->p[0][col], M->p[0][1 - col], n, qp[0]);
+        carry[1] = ln_addmul_1(M->p[1][col], M->p[1][1 - col], n, qp[0]);
+        M->p[0][col][n] = carry[0];
+        M->p[1][col][n] = carry[1];
+        M->n += (carry[0] | carry[1]) != 0;
+        return;
+    }
+
+    // Entries need not grow by qn, so normalize to stay within allocation
+    while (n + qn > M->n && !(M->p[0][1 - col][n - 1] | M->p[1][1 - col][n - 1]))
+        --n;
+    for (unsigned row = 0; row < 2; ++row) {
+        ln_mul(tp, M->p[row][1 - col], n, qp, qn, tp + n + qn);
+        carry[row] = ln_add(M->p[row][col], tp, n + qn, M->p[row][col], M->n);
+    }
+    n += qn;
+    if (carry[0] | carry[1]) {
+        M->p[0][col][n] = carry[0];
+        M->p[1][col][n] = carry[1];
+        ++n;
+    } else
+        n -= !(M->p[0][col][n - 1] | M->p[1][col][n - 1]);
+    M->n = n;
+}
+
+/* Stores (u11 a - u01 b) in rp and (u00 b - u10 a) in bp
+ * Returns new size of both */
+size_t mul1_inverse_vector(const hmat1_t *M1, bitfld_t *rp, const bitfld_t *ap, bitfld_t *bp, size_t n) {
+    ln_mul_1(rp, ap, n, M1->u[1][1]);
+    ln_submul_1(rp, bp, n, M1->u[0][1]);
+    ln_mul_1(bp, bp, n, M1->u[0][0]);
+    ln_submul_1(bp, ap, n, M1->u[1][0]);
+    while (n > 1 && !(rp[n - 1] | bp[n - 1]))
+        --n;
+    return n;
+}
+
+/* Stores (u00 a + u10 b) in rp and (u01 a + u11 b) in bp
+ * Returns new size of both */
+size_t mul_mat1_vector(const hmat1_t *M1, bitfld_t *rp, const bitfld_t *ap, bitfld_t *bp, size_t n) {
+    bitfld_t ah, bh;
+
+    ah = ln_mul_1(rp, ap, n, M1->u[0][0]);
+    ah += ln_addmul_1(rp, bp, n, M1->u[1][0]);
+    bh = ln_mul_1(bp, bp, n, M1->u[1][1]);
+    bh += ln_addmul_1(bp, ap, n, M1->u[0][1]);
+    rp[n] = ah;
+    bp[n] = bh;
+    return n + ((ah | bh) != 0);
+}
+
+/* Temporary space for one reduction step on operands of n bitfields
+ * Covers quotient, division, and cofactor update */
+size_t step_itch(size_t n) {
+    return 3 * n + 4 + ln_mul_itch(n + 2, n + 2);
+}
+
+/* Reduces larger of a and b by one subtraction, then by one division
+ * With s > 0, returns 0 without changing either operand if reduction would
+ * leave one at s or fewer bitfields. With s = 0, reports gcd through hook
+ * and returns 0 once found. Otherwise, returns new size */
+size_t subdiv_step(bitfld_t *ap, bitfld_t *bp, size_t n, size_t s, gcd_hook_t *hook, void *ctx, bitfld_t *tp) {
+    static const bitfld_t one = 1;
+    size_t an = ln_norm(ap, n), bn = ln_norm(bp, n), tmpn;
+    bitfld_t *tmp, carry;
+    int cmpval, swapped = 0;
+
+    // Arrange so that a < b
+    if (an == bn) {
+        if (!(cmpval = ln_cmp(ap, bp, an))) {
+            if (!s)
+                hook(ctx, ap, an, NULL, 0, -1, tp);
+            return 0;
+        }
+        if (cmpval > 0)
+            goto swap1;
+    } else if (an > bn) {
+    swap1:
+        tmp = ap, ap = bp, bp = tmp;
+        tmpn = an, an = bn, bn = tmpn;
+        swapped ^= 1;
+    }
+    if (an <= s) {
+        if (!s)
+            hook(ctx, bp, bn, NULL, 0, swapped ^ 1, tp);
+        return 0;
+    }
+    ln_sub(bp, bp, bn, ap, an);
+    bn = ln_norm(bp, bn);
+    if (bn <= s) {  // Undo subtraction
+        if ((carry = ln_add(bp, ap, an, bp, bn)))
+            bp[an] = carry;
+        return 0;
+    }
+
+    // Arrange so that a < b again
+    if (an == bn) {
+        if (!(cmpval = ln_cmp(ap, bp, an))) {
+            if (s)  // Record subtraction, leaving equal operands
+                hook(ctx, NULL, 0, &one, 1, swapped, tp);
+            else
+                hook(ctx, bp, bn, NULL, 0, swapped, tp);
+            return s ? an : 0;
+        }
+        hook(ctx, NULL, 0, &one, 1, swapped, tp);
+        if (cmpval > 0)
+            goto swap2;
+    } else {
+        hook(ctx, NULL, 0, &one, 1, swapped, tp);
+        if (an > bn) {
+        swap2:
+            tmp = ap, ap = bp, bp = tmp;
+            tmpn = an, an = bn, bn = tmpn;
+            swapped ^= 1;
+        }
+    }
+
+    const size_t qn = bn - an + 1;
+
+    ln_divrem(tp, bp, bn, ap, an, tp + n);
+    bn = ln_norm(bp, an);
+    if (bn <= s) {
+        if (!s) {
+            hook(ctx, ap, an, tp, qn, swapped, tp + n);
+            return 0;
+        }
+
+        // Quotient is one too large, so decrement it and add back a
+        if (bn) {
+            if ((carry = ln_add(bp, ap, an, bp, bn)))
+                bp[an++] = carry;
+        } else
+            memcpy(bp, ap, an * sizeof(bitfld_t));
+        ln_sub_1(tp, tp, qn, 1);
+    }
+    hook(ctx, NULL, 0, tp, qn, swapped, tp + n);
+    return an;
+}
+
+/* Stores top two bitfields of a and b in `top', shifted so the most
+ * significant bit of the larger operand is set */
+void top_bits(const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t top[4]) {
+    const bitfld_t mask = ap[n - 1] | bp[n - 1];
+    const unsigned shift = bitfld_clz(mask);
+
+    if (!shift) {
+        top[0] = ap[n - 1], top[1] = ap[n - 2];
+        top[2] = bp[n - 1], top[3] = bp[n - 2];
+        return;
+    }
+
+    const unsigned tnc = BITFLD_BITS - shift;
+    const bitfld_t a0 = n > 2 ? ap[n - 3] : 0, b0 = n > 2 ? bp[n - 3] : 0;
+
+    top[0] = ap[n - 1] << shift | ap[n - 2] >> tnc;
+    top[1] = ap[n - 2] << shift | a0 >> tnc;
+    top[2] = bp[n - 1] << shift | bp[n - 2] >> tnc;
+    top[3] = bp[n - 2] << shift | b0 >> tnc;
+}
+
+// Returns # of trailing zero bits in nonzero double-width bitfield
+unsigned dbitfld_ctz(dbitfld_t bits) {
+    return (bitfld_t) bits ? bitfld_ctz((bitfld_t) bits) : BITFLD_BITS + bitfld_ctz((bitfld_t) (bits >> BITFLD_BITS));
+}
+
+/* Divides two-bitfield numerator by two-bitfield denominator in place,
+ * leaving remainder; returns quotient, which must fit one bitfield */
+bitfld_t div2(bitfld_t *nh, bitfld_t *nl, bitfld_t dh, bitfld_t dl) {
+    const dbitfld_t num = (dbitfld_t) *nh << BITFLD_BITS | *nl,
+      denom = (dbitfld_t) dh << BITFLD_BITS | dl, rem = num % denom;
+
+    *nh = (bitfld_t) (rem >> BITFLD_BITS);
+    *nl = (bitfld_t) rem;
+    return (bitfld_t) (num / denom);
+}
+
+// Subtracts two-bitfield value in place
+void sub_dd(bitfld_t *h, bitfld_t *l, bitfld_t bh, bitfld_t bl) {
+    const bitfld_t tmp = *l;
+
+    *l = tmp - bl;
+    *h = *h - bh - (tmp < bl);
+}
+
+// ---- Limb Kernels ----
+
+size_t ln_gcd_itch(size_t an, size_t bn) {
+    const size_t n = an < bn ? an : bn, max = an < bn ? bn : an;
+    size_t itch = step_itch(n), tmp;
+
+    if ((tmp = max - n + 1 + ln_divrem_itch(max, n)) > itch)
+        itch = tmp;
+    if (n >= GCD_DC_THRESHOLD) {
+        const size_t m = n - 2 * n / 3, alloc = (m + 1) / 2 + 1;
+
+        tmp = hgcd_itch(m);
+        if (2 * (n + alloc) + ln_mul_itch(n, alloc) > tmp)
+            tmp = 2 * (n + alloc) + ln_mul_itch(n, alloc);
+        if ((tmp += MAT_ITCH(m)) > itch)
+            itch = tmp;
+    }
+    return itch;
+}
+size_t ln_gcd(bitfld_t *gp, bitfld_t *ap, size_t an, bitfld_t *bp, size_t bn, bitfld_t *tp) {
+    gcd_ctx_t ctx = {gp, 0};
+    bitfld_t top[4];
+    hmat1_t M1;
+    size_t n, nn;
+
+    if (an < bn) {
+        bitfld_t *swp = ap;
+
+        ap = bp, bp = swp;
+        n = an, an = bn, bn = n;
+    }
+    if (an > bn) {
+        ln_divrem(tp, ap, an, bp, bn, tp + an - bn + 1);
+        if (!ln_norm(ap, bn)) {
+            memcpy(gp, bp, bn * sizeof(bitfld_t));
+            return bn;
+        }
+    }
+    n = bn;
+    while (n >= GCD_DC_THRESHOLD) {
+        const size_t p = 2 * n / 3, scratch = MAT_ITCH(n - p);
+        hmat_t M;
+
+        mat_init(&M, n - p, tp);
+        if ((nn = hgcd(ap + p, bp + p, n - p, &M, tp + scratch)))
+            n = mat_adjust(&M, p + nn, ap, bp, p, tp + scratch);
+        else if (!(n = subdiv_step(ap, bp, n, 0, gcd_hook, &ctx, tp)))
+            return ctx.gn;
+    }
+    while (n > 2) {
+        top_bits(ap, bp, n, top);
+        if (hgcd2(top[0], top[1], top[2], top[3], &M1)) {
+            memcpy(tp, ap, n * sizeof(bitfld_t));
+            n = mul1_inverse_vector(&M1, ap, tp, bp, n);
+        } else if (!(n = subdiv_step(ap, bp, n, 0, gcd_hook, &ctx, tp)))
+            return ctx.gn;
+    }
+
+    const dbitfld_t g = gcd_22(
+        (n > 1 ? (dbitfld_t) ap[1] << BITFLD_BITS : 0) | ap[0],
+        (n > 1 ? (dbitfld_t) bp[1] << BITFLD_BITS : 0) | bp[0]
+    );
+
+    gp[0] = (bitfld_t) g;
+    gp[1] = (bitfld_t) (g >> BITFLD_BITS);
+    return gp[1] ? 2 : 1;
+}
+size_t ln_gcdext_itch(size_t an, size_t bn) {
+    const size_t max = an < bn ? bn : an, n = an < bn ? an : bn, size = max + 2;
+    size_t itch = step_itch(max), tmp;
+
+    if ((tmp = max - n + 1 + ln_divrem_itch(max, n)) > itch)
+        itch = tmp;
+    if (n >= GCDEXT_DC_THRESHOLD) {
+        const size_t m = n - 2 * n / 3, alloc = (m + 1) / 2 + 1;
+
+        tmp = hgcd_itch(m);
+        if (2 * (n + alloc) + ln_mul_itch(n, alloc) > tmp)
+            tmp = 2 * (n + alloc) + ln_mul_itch(n, alloc);
+        if (3 * (alloc + size + 1) + ln_mul_itch(alloc, size) > tmp)   // cofactor_mat()
+            tmp = 3 * (alloc + size + 1) + ln_mul_itch(alloc, size);
+        if ((tmp += MAT_ITCH(m)) > itch)
+            itch = tmp;
+    }
+    return 2 * size + itch;
+}
+size_t ln_gcdext(bitfld_t *gp, bitfld_t *sp, size_t *sn, bool *sneg,
+  bitfld_t *ap, size_t an, bitfld_t *bp, size_t bn, bitfld_t *tp) {
+    const size_t size = (an < bn ? bn : an) + 2;
+    gcdext_ctx_t ctx = {gp, tp, tp + size, sp, 0, 1, sn, sneg};
+    bitfld_t top[4];
+    hmat1_t M1;
+    size_t n, nn;
+
+    memset(tp, 0, 2 * size * sizeof(bitfld_t));
+    ctx.ux[0] = 1;
+    tp += 2 * size;
+    if (an > bn) {  // Quotient is multiplied by uy = 0, so discard it
+        ln_divrem(tp, ap, an, bp, bn, tp + an - bn + 1);
+        if (!ln_norm(ap, bn)) {
+            memcpy(gp, bp, bn * sizeof(bitfld_t));
+            *sn = 0;
+            *sneg = false;
+            return bn;
+        }
+        n = bn;
+    } else if (an < bn) {   // uy = q ux = q
+        ln_divrem(tp, bp, bn, ap, an, tp + bn - an + 1);
+        if (!ln_norm(bp, an)) {
+            memcpy(gp, ap, an * sizeof(bitfld_t));
+            sp[0] = 1;
+            *sn = 1;
+            *sneg = false;
+            return an;
+        }
+        ctx.un = ln_norm(tp, bn - an + 1);
+        memcpy(ctx.uy, tp, ctx.un * sizeof(bitfld_t));
+        n = an;
+    } else
+        n = an;
+    while (n >= GCDEXT_DC_THRESHOLD) {
+        const size_t p = 2 * n / 3, scratch = MAT_ITCH(n - p);
+        hmat_t M;
+
+        mat_init(&M, n - p, tp);
+        if ((nn = hgcd(ap + p, bp + p, n - p, &M, tp + scratch))) {
+            n = mat_adjust(&M, p + nn, ap, bp, p, tp + scratch);
+            cofactor_mat(&ctx, &M, tp + scratch);
+        } else if (!(n = subdiv_step(ap, bp, n, 0, gcdext_hook, &ctx, tp)))
+            return ctx.gn;
+    }
+    for (;;) {
+        if (n > 1) {
+            top_bits(ap, bp, n, top);
+            if (hgcd2(top[0], top[1], top[2], top[3], &M1)) {
+                memcpy(tp, ap, n * sizeof(bitfld_t));
+                n = mul1_inverse_vector(&M1, ap, tp, bp, n);
+                cofactor_mat1(&ctx, &M1, tp);
+                continue;
+            }
+        }
+        if (!(n = subdiv_step(ap, bp, n, 0, gcdext_hook, &ctx, tp)))
+            return ctx.gn;
+    }
+}
+
+// ---- Number Theory ----
+
+export dwhl_t *dwhl_gcdeq(dwhl_t *tar, const dwhl_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+
+    const size_t asize = tar->size, bsize = val->size, gsize = (asize < bsize ? bsize : asize) + 2;
+    bitfld_t *ap = malloc((asize + bsize + 2 + gsize + ln_gcd_itch(asize, bsize)) * sizeof(bitfld_t)),
+      *bp = ap + asize + 1, *gp = bp + bsize + 1;
+    dwhl_t *tmp;
+
+    if (!ap)
+        return NULL;
+
+    size_t an = get_abs(ap, tar), bn = get_abs(bp, val), gn;
+
+    if (!an)
+        tmp = set_abs(tar, bp, bn, false);
+    else if (!bn)
+        tmp = set_abs(tar, ap, an, false);
+    else {
+        gn = ln_gcd(gp, ap, an, bp, bn, gp + gsize);
+        tmp = set_abs(tar, gp, gn, false);
+    }
+    free(ap);
+    return tmp;
+}
+export dwhl_t *dwhl_gcdext(dwhl_t *g, dwhl_t *s, dwhl_t *t, const dwhl_t *a, const dwhl_t *b) {
+    if (!a || !b || !g || !s) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(g);
+    assert_lval(s);
+    if (t)
+        assert_lval(t);
+
+    const bool a_sign = last_fld(a) & SIGN_BIT, b_sign = last_fld(b) & SIGN_BIT;
+    const size_t asize = a->size, bsize = b->size, size = (asize < bsize ? bsize : asize) + 2,
+      tsize = 2 * size + asize + 2,
+      tmpsize = ln_gcdext_itch(asize, bsize) > 3 * tsize + ln_mul_itch(size, asize) ?
+        ln_gcdext_itch(asize, bsize) : 3 * tsize + ln_mul_itch(size, asize);
+    bitfld_t *ap = malloc((2 * (asize + bsize + 1) + 2 * size + tmpsize) * sizeof(bitfld_t)),
+      *bp = ap + asize + 1, *a0 = bp + bsize + 1, *b0 = a0 + asize,
+      *gp = b0 + bsize, *sp = gp + size, *tp = sp + size;
+    size_t an, bn, gn, sn;
+    bool sneg;
+    dwhl_t *tmp = g;
+
+    if (!ap)
+        return NULL;
+    an = get_abs(a0, a);
+    bn = get_abs(b0, b);
+    memcpy(ap, a0, an * sizeof(bitfld_t));
+    memcpy(bp, b0, bn * sizeof(bitfld_t));
+    if (!bn) {  // gcd(a, 0) = |a| = sgn(a) a
+        gn = an;
+        memcpy(gp, a0, an * sizeof(bitfld_t));
+        sp[0] = 1;
+        sn = an != 0;
+        sneg = false;
+    } else if (!an) {
+        gn = bn;
+        memcpy(gp, b0, bn * sizeof(bitfld_t));
+        sn = 0;
+        sneg = false;
+    } else
+        gn = ln_gcdext(gp, sp, &sn, &sneg, ap, an, bp, bn, tp);
+    if (t) {
+        // t = (g - s|a|) / |b|, exact
+        bitfld_t *prod = tp, *quot = tp + tsize, *ts = quot + tsize;
+        size_t pn = gn, qn = 0;
+
+        if (sn) {
+            ln_mul(prod, sp, sn, a0, an, ts);
+            pn = ln_norm(prod, sn + an);
+            if (pn < gn) {
+                memset(prod + pn, 0, (gn - pn) * sizeof(bitfld_t));
+                pn = gn;
+            }
+            if (sneg) {     // g + |s||a|
+                prod[pn] = ln_add(prod, prod, pn, gp, gn);
+                ++pn;
+            } else          // |s||a| - g, giving -t
+                ln_sub(prod, prod, pn, gp, gn);
+            pn = ln_norm(prod, pn);
+        } else
+            memcpy(prod, gp, gn * sizeof(bitfld_t));
+        if (bn && pn >= bn) {
+            ln_divrem(quot, prod, pn, b0, bn, ts);
+            qn = pn - bn + 1;
+        }
+        if (!set_abs(t, quot, qn, (!sneg && sn) ^ b_sign))
+            tmp = NULL;
+    }
+    if (!set_abs(s, sp, sn, sneg ^ a_sign) || !set_abs(g, gp, gn, false))
+        tmp = NULL;
+    free(ap);
+    return tmp;
+}
+export dwhl_t *dwhl_inverteq(dwhl_t *tar, const dwhl_t *mod) {
+    if (!tar || !mod) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+
+    const size_t asize = tar->size, msize = mod->size, size = (asize < msize ? msize : asize) + 2;
+    bitfld_t *ap = malloc((4 * size + 2 * msize + ln_gcdext_itch(asize, msize)) * sizeof(bitfld_t)),
+      *mp = ap + size, *m0 = mp + msize + 1, *gp = m0 + msize, *sp = gp + size, *tp = sp + size;
+    size_t an, mn, gn, sn;
+    bool sneg;
+    dwhl_t *tmp = NULL;
+
+    if (!ap)
+        return NULL;
+    an = get_abs(ap, tar);
+    mn = get_abs(m0, mod);
+    if (!mn) {
+        errno = EDOM;
+        goto cleanup;
+    }
+    if (mn == 1 && m0[0] == 1) {    // Every residue is 0
+        tmp = set_abs(tar, NULL, 0, false);
+        goto cleanup;
+    }
+
+    // Reduce to least nonnegative residue
+    if (an >= mn) {
+        ln_divrem(tp, ap, an, m0, mn, tp + an - mn + 1);
+        an = ln_norm(ap, mn);
+    }
+    if (an && dwhl_isneg(tar)) {
+        ln_sub(ap, m0, mn, ap, an);
+        an = ln_norm(ap, mn);
+    }
+    if (!an) {
+        errno = EDOM;
+        goto cleanup;
+    }
+    memcpy(mp, m0, mn * sizeof(bitfld_t));
+    gn = ln_gcdext(gp, sp, &sn, &sneg, ap, an, mp, mn, tp);
+    if (gn != 1 || gp[0] != 1) {
+        errno = EDOM;
+        goto cleanup;
+    }
+    if (sn >= mn) {
+        ln_divrem(tp, sp, sn, m0, mn, tp + sn - mn + 1);
+        sn = ln_norm(sp, mn);
+    }
+    if (sneg && sn) {
+        ln_sub(sp, m0, mn, sp, sn);
+        sn = mn;
+    }
+    tmp = set_abs(tar, sp, sn, false);
+cleanup:
+    free(ap);
+    return tmp;
+}
+
+export dwhl_t *dwhl_invert(const dwhl_t *val, const dwhl_t *mod) { BUILD_BINARY(invert, val, mod); }
+export dwhl_t *dwhl_gcd(const dwhl_t *lhs, const dwhl_t *rhs)     { BUILD_BINARY(gcd, lhs, rhs);    }
+
+export dwhl_t *dwhl_gcdeq_take(dwhl_t *tar, dwhl_t *val)    { BUILD_EQ_TAKE(gcd, tar, val);        }
+export dwhl_t *dwhl_inverteq_take(dwhl_t *tar, dwhl_t *mod) { BUILD_EQ_TAKE(invert, tar, mod);     }
+export dwhl_t *dwhl_invert_take(dwhl_t *val, dwhl_t *mod)   { BUILD_BINARY_TAKE(invert, val, mod); }
+export dwhl_t *dwhl_gcd_take(dwhl_t *lhs, dwhl_t *rhs)      { BUILD_COMMUT_TAKE(gcd, lhs, rhs);    }
@@ -0,0 +1,549 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+// ---- Constants ----
+
+/* Temporary space needed by balanced Karatsuba of n bitfields
+ * Each level uses at most 3n + 4 bitfields; recursion depth never exceeds 64 */
+#define KARA_ITCH(n)    (6 * (n) + 8 * 64)
+
+// Thresholds in effect outside of contexts
+const dwhl_tune_t ln_tune = {MUL_KARATSUBA_THRESHOLD, SQR_KARATSUBA_THRESHOLD, POWM_WINDOW_MAX};
+
+// ---- Helper Functions ----
+
+static void kara_mul_n(bitfld_t *, const bitfld_t *, const bitfld_t *, size_t, bitfld_t *, size_t);
+static void kara_mulhi_n(bitfld_t *, const bitfld_t *, const bitfld_t *, size_t, bitfld_t *, size_t);
+static void kara_mullo_n(bitfld_t *, const bitfld_t *, const bitfld_t *, size_t, bitfld_t *, size_t);
+static void kara_sqr_n(bitfld_t *, const bitfld_t *, size_t, bitfld_t *, size_t);
+static inline size_t kara_thresh(size_t);
+static void mul_basecase(bitfld_t *, const bitfld_t *, size_t, const bitfld_t *, size_t);
+static void mulhi_basecase(bitfld_t *, const bitfld_t *, const bitfld_t *, size_t, bitfld_t *);
+static size_t mulhi_bound(size_t, size_t);
+static void mullo_basecase(bitfld_t *, const bitfld_t *, const bitfld_t *, size_t);
+static void sqr_basecase(bitfld_t *, const bitfld_t *, size_t);
+
+/* Balanced Karatsuba multiplication, stores 2n bitfields in rp
+ * Operands below `thresh' bitfields are multiplied by schoolbook
+ * With a = a1*B^l + a0, b = b1*B^l + b0:
+ *  ab = a0b0 + (a0b0 + a1b1 - (a0 - a1)(b0 - b1))*B^l + a1b1*B^2l */
+void kara_mul_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp, size_t thresh) {
+    if (n < thresh) {
+        mul_basecase(rp, ap, n, bp, n);
+        return;
+    }
+
+    const size_t h = n / 2, l = n - h;
+    bitfld_t *da = tp, *db = tp + l, *z1 = tp + 2 * l, *mid = tp + 4 * l, *ts = mid + 2 * l + 1;
+    const bool neg = ln_absdiff(da, ap, l, ap + l, h) ^ ln_absdiff(db, bp, l, bp + l, h);
+
+    kara_mul_n(z1, da, db, l, ts, thresh);
+    kara_mul_n(rp, ap, bp, l, ts, thresh);
+    kara_mul_n(rp + 2 * l, ap + l, bp + l, h, ts, thresh);
+    mid[2 * l] = ln_add(mid, rp, 2 * l, rp + 2 * l, 2 * h);
+    if (neg)
+        ln_add(mid, mid, 2 * l + 1, z1, 2 * l);
+    else
+        ln_sub(mid, mid, 2 * l + 1, z1, 2 * l);
+
+    // Middle term is below 2B^(l + h), so its high bitfields past l + 2h are zero
+    ln_add(rp + l, rp + l, l + 2 * h, mid, l + h + 1);
+}
+
+/* Mulders' short product, stores high n bitfields of ab in rp, short by less than `mulhi_bound()'
+ * With a = a1*B^m + a0, b = b1*B^m + b0 for m = n/2, and a1 = at*B^(k - m) + am for k = n - m:
+ *  ab/B^n = a1b1/B^(n - 2m) + at*b0/B^m + a0*bt/B^m + am*b0/B^(n - m) + a0*bm/B^(n - m) + a0b0/B^n
+ * a1b1 is a full product; the high m bitfields of at*b0 and a0*bt are short products;
+ * each of the last three terms, and the truncation of the first, is below 1 */
+void kara_mulhi_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp, size_t thresh) {
+    if (n < thresh) {
+        mulhi_basecase(rp, ap, bp, n, tp);
+        return;
+    }
+
+    const size_t m = n / 2, k = n - m;
+
+    kara_mul_n(tp, ap + m, bp + m, k, tp + 2 * k, thresh);
+    memcpy(rp, tp + (n - 2 * m), n * sizeof(bitfld_t));
+
+    // Sum of lower bounds stays below B^n
+    kara_mulhi_n(tp, ap + k, bp, m, tp + m, thresh);
+    ln_add(rp, rp, n, tp, m);
+    kara_mulhi_n(tp, ap, bp + k, m, tp + m, thresh);
+    ln_add(rp, rp, n, tp, m);
+}
+
+/* Karatsuba short product, stores low n bitfields of ab in rp
+ * With a = a1*B^l + a0, b = b1*B^l + b0:
+ *  ab mod B^n = a0b0 + ((a1b0 + a0b1) mod B^h)*B^l, where the cross products are short products */
+void kara_mullo_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp, size_t thresh) {
+    if (n < thresh) {
+        mullo_basecase(rp, ap, bp, n);
+        return;
+    }
+
+    const size_t h = n / 2, l = n - h;
+
+    kara_mul_n(tp, ap, bp, l, tp + 2 * l, thresh);
+    memcpy(rp, tp, n * sizeof(bitfld_t));
+    kara_mullo_n(tp, ap + l, bp, h, tp + h, thresh);
+    ln_add_n(rp + l, rp + l, tp, h);
+    kara_mullo_n(tp, ap, bp + l, h, tp + h, thresh);
+    ln_add_n(rp + l, rp + l, tp, h);
+}
+
+// Balanced Karatsuba squaring, stores 2n bitfields in rp
+void kara_sqr_n(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t *tp, size_t thresh) {
+    if (n < thresh) {
+        sqr_basecase(rp, ap, n);
+        return;
+    }
+
+    const size_t h = n / 2, l = n - h;
+    bitfld_t *da = tp, *z1 = tp + 2 * l, *mid = tp + 4 * l, *ts = mid + 2 * l + 1;
+
+    ln_absdiff(da, ap, l, ap + l, h);
+    kara_sqr_n(z1, da, l, ts, thresh);
+    kara_sqr_n(rp, ap, l, ts, thresh);
+    kara_sqr_n(rp + 2 * l, ap + l, h, ts, thresh);
+    mid[2 * l] = ln_add(mid, rp, 2 * l, rp + 2 * l, 2 * h);
+    ln_sub(mid, mid, 2 * l + 1, z1, 2 * l);
+    ln_add(rp + l, rp + l, l + 2 * h, mid, l + h + 1);
+}
+
+/* Returns Karatsuba threshold no lower than 2
+ * Splitting a single bitfield would recurse without end */
+size_t kara_thresh(size_t thresh) {
+    return thresh < 2 ? 2 : thresh;
+}
+
+// Schoolbook multiplication, stores an + bn bitfields in rp
+void mul_basecase(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn) {
+    rp[an] = ln_mul_1(rp, ap, an, bp[0]);
+    for (size_t i = 1; i < bn; ++i)
+        rp[an + i] = ln_addmul_1(rp + i, ap, an, bp[i]);
+}
+
+/* Schoolbook short product, stores high n bitfields of ab in rp
+ * Only products reaching column n - 1 are summed, in tp, which holds n + 1 bitfields; those left out
+ * sum to less than (n - 1)*B^n, so the result is short by less than n */
+void mulhi_basecase(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp) {
+    tp[1] = ln_mul_1(tp, ap + n - 1, 1, bp[0]);
+    for (size_t i = 1; i < n; ++i)
+        tp[i + 1] = ln_addmul_1(tp, ap + n - 1 - i, i + 1, bp[i]);
+    memcpy(rp, tp + 1, n * sizeof(bitfld_t));
+}
+
+// Returns bound, exclusive, on shortfall of `kara_mulhi_n()' below ab/B^n
+size_t mulhi_bound(size_t n, size_t thresh) {
+    return n < thresh ? n : 4 + 2 * mulhi_bound(n / 2, thresh);
+}
+
+// Schoolbook short product, stores low n bitfields of ab in rp
+void mullo_basecase(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    ln_mul_1(rp, ap, n, bp[0]);
+    for (size_t i = 1; i < n; ++i)
+        ln_addmul_1(rp + i, ap, n - i, bp[i]);
+}
+
+/* Schoolbook squaring, stores 2n bitfields in rp
+ * Cross products are summed once and doubled */
+void sqr_basecase(bitfld_t *rp, const bitfld_t *ap, size_t n) {
+    dbitfld_t prod;
+
+    if (n == 1) {
+        prod = (dbitfld_t) ap[0] * ap[0];
+        rp[0] = (bitfld_t) prod;
+        rp[1] = (bitfld_t) (prod >> BITFLD_BITS);
+        return;
+    }
+    rp[0] = 0;
+    rp[n] = ln_mul_1(rp + 1, ap + 1, n - 1, ap[0]);
+    for (size_t i = 1; i < n - 1; ++i)
+        rp[n + i] = ln_addmul_1(rp + 2 * i + 1, ap + i + 1, n - i - 1, ap[i]);
+    rp[2 * n - 1] = ln_lshift(rp + 1, rp + 1, 2 * n - 2, 1);
+
+    bitfld_t carry = 0;
+    dbitfld_t sum;
+
+    for (size_t i = 0; i < n; ++i) {
+        prod = (dbitfld_t) ap[i] * ap[i];
+        sum = (dbitfld_t) rp[2 * i] + (bitfld_t) prod + carry;
+        rp[2 * i] = (bitfld_t) sum;
+        sum = (dbitfld_t) rp[2 * i + 1] + (bitfld_t) (prod >> BITFLD_BITS) + (bitfld_t) (sum >> BITFLD_BITS);
+        rp[2 * i + 1] = (bitfld_t) sum;
+        carry = (bitfld_t) (sum >> BITFLD_BITS);
+    }
+}
+
+// ---- Limb Kernels ----
+
+bitfld_t ln_add_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    bitfld_t sum;
+    bool carry = false, tmp;
+
+    for (size_t i = 0; i < n; ++i) {
+        tmp = __builtin_add_overflow(ap[i], bp[i], &sum);
+        carry = __builtin_add_overflow(sum, (bitfld_t) carry, &rp[i]) | tmp;
+    }
+    return carry;
+}
+bitfld_t ln_sub_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    bitfld_t diff;
+    bool borrow = false, tmp;
+
+    for (size_t i = 0; i < n; ++i) {
+        tmp = __builtin_sub_overflow(ap[i], bp[i], &diff);
+        borrow = __builtin_sub_overflow(diff, (bitfld_t) borrow, &rp[i]) | tmp;
+    }
+    return borrow;
+}
+bitfld_t ln_add(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn) {
+    return ln_add_1(rp + bn, ap + bn, an - bn, ln_add_n(rp, ap, bp, bn));
+}
+bitfld_t ln_sub(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn) {
+    return ln_sub_1(rp + bn, ap + bn, an - bn, ln_sub_n(rp, ap, bp, bn));
+}
+bitfld_t ln_add_1(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b) {
+    size_t i = 0;
+
+    for (; b && i < n; ++i)
+        b = __builtin_add_overflow(ap[i], b, &rp[i]);
+    if (rp != ap)
+        memmove(rp + i, ap + i, (n - i) * sizeof(bitfld_t));
+    return b;
+}
+bitfld_t ln_sub_1(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b) {
+    size_t i = 0;
+
+    for (; b && i < n; ++i)
+        b = __builtin_sub_overflow(ap[i], b, &rp[i]);
+    if (rp != ap)
+        memmove(rp + i, ap + i, (n - i) * sizeof(bitfld_t));
+    return b;
+}
+bitfld_t ln_lshift(bitfld_t *rp, const bitfld_t *ap, size_t n, unsigned cnt) {
+    const unsigned tnc = BITFLD_BITS - cnt;
+    bitfld_t high = ap[n - 1], low;
+    const bitfld_t out = high >> tnc;
+
+    for (size_t i = n - 1; i; --i) {
+        low = ap[i - 1];
+        rp[i] = high << cnt | low >> tnc;
+        high = low;
+    }
+    rp[0] = high << cnt;
+    return out;
+}
+bitfld_t ln_rshift(bitfld_t *rp, const bitfld_t *ap, size_t n, unsigned cnt) {
+    const unsigned tnc = BITFLD_BITS - cnt;
+    bitfld_t low = ap[0], high;
+    const bitfld_t out = low << tnc;
+
+    for (size_t i = 0; i < n - 1; ++i) {
+        high = ap[i + 1];
+        rp[i] = low >> cnt | high << tnc;
+        low = high;
+    }
+    rp[n - 1] = low >> cnt;
+    return out;
+}
+bool ln_absdiff(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn) {
+    if (ln_norm(ap + bn, an - bn) || ln_cmp(ap, bp, bn) >= 0) {
+        ln_sub(rp, ap, an, bp, bn);
+        return false;
+    }
+    ln_sub_n(rp, bp, ap, bn);
+    memset(rp + bn, 0, (an - bn) * sizeof(bitfld_t));
+    return true;
+}
+
+/* Unbalanced operands are cut into chunks the size of the smaller one
+ * A trailing chunk large enough for Karatsuba is zero-padded to full size */
+size_t ln_mul_itch(size_t an, size_t bn) {
+    return ln_mul_tuned_itch(an, bn, &ln_tune);
+}
+void ln_mul(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn, bitfld_t *tp) {
+    ln_mul_tuned(rp, ap, an, bp, bn, tp, &ln_tune);
+}
+size_t ln_mul_tuned_itch(size_t an, size_t bn, const dwhl_tune_t *tune) {
+    const size_t n = an < bn ? an : bn;
+
+    return n < kara_thresh(tune->mul_karatsuba) ? 0 : 3 * n + KARA_ITCH(n);
+}
+void ln_mul_tuned(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn, bitfld_t *tp,
+  const dwhl_tune_t *tune) {
+    const size_t thresh = kara_thresh(tune->mul_karatsuba);
+
+    if (an < bn) {
+        const bitfld_t *swp = ap;
+        const size_t swpn = an;
+
+        ap = bp, an = bn;
+        bp = swp, bn = swpn;
+    }
+    if (bn < thresh) {
+        mul_basecase(rp, ap, an, bp, bn);
+        return;
+    }
+    kara_mul_n(rp, ap, bp, bn, tp, thresh);
+
+    bitfld_t *prod = tp, *pad = tp + 2 * bn, *ts = pad + bn, carry;
+    size_t i = bn, rem;
+
+    for (; an - i >= bn; i += bn) {
+        kara_mul_n(prod, ap + i, bp, bn, ts, thresh);
+        carry = ln_add_n(rp + i, rp + i, prod, bn);
+        ln_add_1(rp + i + bn, prod + bn, bn, carry);
+    }
+    if ((rem = an - i)) {
+        if (rem < thresh)
+            mul_basecase(prod, bp, bn, ap + i, rem);
+        else {
+            memcpy(pad, ap + i, rem * sizeof(bitfld_t));
+            memset(pad + rem, 0, (bn - rem) * sizeof(bitfld_t));
+            kara_mul_n(prod, pad, bp, bn, ts, thresh);
+        }
+        carry = ln_add_n(rp + i, rp + i, prod, bn);
+        ln_add_1(rp + i + bn, prod + bn, rem, carry);
+    }
+}
+
+/* Each level holds a full product of half size, or one short product while the next level runs
+ * Both fit 2n + 2 bitfields beyond the space of a full Karatsuba product of n */
+size_t ln_mulhi_itch(size_t n) {
+    return n < kara_thresh(ln_tune.mul_karatsuba) ? n + 1 : 2 * n + 2 + KARA_ITCH(n);
+}
+void ln_mulhi(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp) {
+    kara_mulhi_n(rp, ap, bp, n, tp, kara_thresh(ln_tune.mul_karatsuba));
+}
+size_t ln_mulhi_err(size_t n) {
+    return n ? mulhi_bound(n, kara_thresh(ln_tune.mul_karatsuba)) - 1 : 0;
+}
+size_t ln_mullo_itch(size_t n) {
+    return n < kara_thresh(ln_tune.mul_karatsuba) ? 0 : 2 * n + 2 + KARA_ITCH(n);
+}
+void ln_mullo(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp) {
+    kara_mullo_n(rp, ap, bp, n, tp, kara_thresh(ln_tune.mul_karatsuba));
+}
+size_t ln_sqr_itch(size_t n) {
+    return ln_sqr_tuned_itch(n, &ln_tune);
+}
+void ln_sqr(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t *tp) {
+    ln_sqr_tuned(rp, ap, n, tp, &ln_tune);
+}
+size_t ln_sqr_tuned_itch(size_t n, const dwhl_tune_t *tune) {
+    return n < kara_thresh(tune->sqr_karatsuba) ? 0 : KARA_ITCH(n);
+}
+void ln_sqr_tuned(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t *tp, const dwhl_tune_t *tune) {
+    kara_sqr_n(rp, ap, n, tp, kara_thresh(tune->sqr_karatsuba));
+}
+bitfld_t ln_divrem_1(bitfld_t *qp, const bitfld_t *ap, size_t n, bitfld_t d) {
+    const unsigned shift = bitfld_clz(d);
+    bitfld_t rem = 0, cur, next;
+
+    if (!shift) {
+        while (n--)
+            qp[n] = bitfld_div(rem, ap[n], d, &rem);
+        return rem;
+    }
+
+    // Normalize divisor so quotient estimates stay within one bitfield
+    d <<= shift;
+    next = ap[n - 1];
+    rem = next >> (BITFLD_BITS - shift);
+    while (--n) {
+        cur = next;
+        next = ap[n - 1];
+        qp[n] = bitfld_div(rem, cur << shift | next >> (BITFLD_BITS - shift), d, &rem);
+    }
+    qp[0] = bitfld_div(rem, next << shift, d, &rem);
+    return rem >> shift;
+}
+
+bitfld_t ln_mod_1(const bitfld_t *ap, size_t n, bitfld_t d) {
+    bitfld_t rem = 0;
+
+    while (n--)
+        bitfld_div(rem, ap[n], d, &rem);
+    return rem;
+}
+
+/* Knuth's Algorithm D; each quotient bitfield is estimated from the top
+ * three bitfields of the running remainder and corrected at most twice */
+size_t ln_divrem_itch(size_t nn, size_t dn) {
+    return nn + 1 + dn;
+}
+void ln_divrem(bitfld_t *qp, bitfld_t *np, size_t nn, const bitfld_t *dp, size_t dn, bitfld_t *tp) {
+    if (dn == 1) {
+        np[0] = ln_divrem_1(qp, np, nn, dp[0]);
+        return;
+    }
+
+    const unsigned shift = bitfld_clz(dp[dn - 1]);
+    bitfld_t *un = tp, *vn = tp + nn + 1;
+
+    if (shift) {
+        ln_lshift(vn, dp, dn, shift);
+        un[nn] = ln_lshift(un, np, nn, shift);
+    } else {
+        memcpy(vn, dp, dn * sizeof(bitfld_t));
+        memcpy(un, np, nn * sizeof(bitfld_t));
+        un[nn] = 0;
+    }
+
+    const bitfld_t d1 = vn[dn - 1], d0 = vn[dn - 2];
+    bitfld_t qhat, rhat, n2, n1, n0, top, borrow;
+
+    for (size_t j = nn - dn + 1; j--;) {
+        n2 = un[j + dn], n1 = un[j + dn - 1], n0 = un[j + dn - 2];
+        if (n2 >= d1) {
+            qhat = BITFLD_MAX;
+            rhat = n1 + d1;
+            if (rhat < d1)  // Remainder estimate overflows, qhat cannot be refined
+                goto mulsub;
+        } else
+            qhat = bitfld_div(n2, n1, d1, &rhat);
+        while ((dbitfld_t) qhat * d0 > ((dbitfld_t) rhat << BITFLD_BITS | n0)) {
+            --qhat;
+            if ((rhat += d1) < d1)
+                break;
+        }
+    mulsub:
+        borrow = ln_submul_1(un + j, vn, dn, qhat);
+        top = un[j + dn];
+        un[j + dn] = top - borrow;
+        if (top < borrow) {     // Estimate too large, add back divisor
+            do
+                --qhat;
+            while (!(ln_add_n(un + j, un + j, vn, dn) && !++un[j + dn]));
+        }
+        qp[j] = qhat;
+    }
+    if (shift)
+        ln_rshift(np, un, dn, shift);
+    else
+        memcpy(np, un, dn * sizeof(bitfld_t));
+}
+
+/* Hensel division, after Jebelean; quotient bitfields are found from the bottom, each as the
+ * low bitfield of the running remainder times the inverse of d modulo 2^BITFLD_BITS, so
+ * none is estimated or corrected, and only the low nn - dn + 1 bitfields of n are read */
+void ln_divexact_1(bitfld_t *qp, const bitfld_t *ap, size_t n, bitfld_t d) {
+    const unsigned shift = bitfld_ctz(d);
+    const bitfld_t inv = bitfld_binvert(d >>= shift);
+    bitfld_t borrow = 0, cur, q;
+    bool under;
+
+    for (size_t i = 0; i < n; ++i) {
+        cur = ap[i] >> shift;
+        if (shift && i + 1 < n)
+            cur |= ap[i + 1] << (BITFLD_BITS - shift);
+        under = cur < borrow;
+        qp[i] = q = (cur - borrow) * inv;
+        borrow = (bitfld_t) ((dbitfld_t) q * d >> BITFLD_BITS) + under;
+    }
+}
+
+size_t ln_divexact_itch(size_t nn, size_t dn) {
+    (void) nn;
+    return dn;
+}
+void ln_divexact(bitfld_t *qp, bitfld_t *np, size_t nn, const bitfld_t *dp, size_t dn, bitfld_t *tp) {
+    const size_t qn = nn - dn + 1;
+    unsigned shift;
+
+    // Low zero bitfields of d are also those of n
+    for (; !dp[0]; --nn, --dn)
+        ++dp, ++np;
+    if (dn == 1) {
+        ln_divexact_1(qp, np, qn, dp[0]);
+        return;
+    }
+    if ((shift = bitfld_ctz(dp[0]))) {
+        ln_rshift(tp, dp, dn, shift);
+        ln_rshift(np, np, nn, shift);
+        dp = tp;
+        dn -= !tp[dn - 1];
+    }
+
+    const bitfld_t inv = bitfld_binvert(dp[0]);
+
+    for (size_t i = 0; i < qn; ++i) {
+        const bitfld_t q = qp[i] = np[i] * inv;
+        const size_t m = dn < qn - i ? dn : qn - i;
+        const bitfld_t borrow = ln_submul_1(np + i, dp, m, q);
+
+        ln_sub_1(np + i + m, np + i + m, qn - i - m, borrow);
+    }
+}
+
+// ---- Low-level Interface ----
+
+export bitfld_t dwhl_ln_add_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    return ln_add_n(rp, ap, bp, n);
+}
+export bitfld_t dwhl_ln_sub_n(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    return ln_sub_n(rp, ap, bp, n);
+}
+
+export size_t dwhl_ln_mul_itch(size_t an, size_t bn) {
+    return ln_mul_itch(an, bn);
+}
+export void dwhl_ln_mul(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn, bitfld_t *tp) {
+    ln_mul(rp, ap, an, bp, bn, tp);
+}
+export size_t dwhl_ln_mulhi_itch(size_t n) {
+    return ln_mulhi_itch(n);
+}
+export void dwhl_ln_mulhi(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp) {
+    ln_mulhi(rp, ap, bp, n, tp);
+}
+export size_t dwhl_ln_mulhi_err(size_t n) {
+    return ln_mulhi_err(n);
+}
+export size_t dwhl_ln_mullo_itch(size_t n) {
+    return ln_mullo_itch(n);
+}
+export void dwhl_ln_mullo(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n, bitfld_t *tp) {
+    ln_mullo(rp, ap, bp, n, tp);
+}
+export size_t dwhl_ln_sqr_itch(size_t n) {
+    return ln_sqr_itch(n);
+}
+export void dwhl_ln_sqr(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t *tp) {
+    ln_sqr(rp, ap, n, tp);
+}
+
+export size_t dwhl_ln_divexact_itch(size_t nn, size_t dn) {
+    return ln_divexact_itch(nn, dn);
+}
+export void dwhl_ln_divexact(bitfld_t *qp, bitfld_t *np, size_t nn, const bitfld_t *dp, size_t dn, bitfld_t *tp) {
+    ln_divexact(qp, np, nn, dp, dn, tp);
+}
+export size_t dwhl_ln_divrem_itch(size_t nn, size_t dn) {
+    return ln_divrem_itch(nn, dn);
+}
+export void dwhl_ln_divrem(bitfld_t *qp, bitfld_t *np, size_t nn, const bitfld_t *dp, size_t dn, bitfld_t *tp) {
+    ln_divrem(qp, np, nn, dp, dn, tp);
+}
+
+export bitfld_t dwhl_ln_lshift(bitfld_t *rp, const bitfld_t *ap, size_t n, unsigned cnt) {
+    return ln_lshift(rp, ap, n, cnt);
+}
+export bitfld_t dwhl_ln_rshift(bitfld_t *rp, const bitfld_t *ap, size_t n, unsigned cnt) {
+    return ln_rshift(rp, ap, n, cnt);
+}
+
+export int dwhl_ln_cmp(const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    return ln_cmp(ap, bp, n);
+}
+export size_t dwhl_ln_norm(const bitfld_t *ap, size_t n) {
+    return ln_norm(ap, n);
+}
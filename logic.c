@@ -0,0 +1,234 @@
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Bitwise logic and comparison kernels
+ *
+ * Bitsets of millions of bits spend nearly all their time in these loops,
+ * so each kernel is built three times: portably, for AVX2 (4 bitfields per
+ * step), and for AVX-512 (8 bitfields per step). On x86-64 ELF targets, the
+ * widest variant the processor supports is bound once, at load time, through
+ * an indirect function (ifunc); elsewhere, the portable variant is called
+ * directly. Resolvers run during relocation, before any sanitizer runtime
+ * is ready, so they are never instrumented.
+ *
+ * Comparison scans down from the most significant end, testing a whole
+ * vector of bitfields for equality per step, and only inspects individual
+ * bitfields once the vector containing the highest difference is found. */
+
+// ---- Types ----
+
+typedef void (*logic_fn)(bitfld_t *, const bitfld_t *, const bitfld_t *, size_t);
+typedef void (*com_fn)(bitfld_t *, const bitfld_t *, size_t);
+typedef int (*cmp_fn)(const bitfld_t *, const bitfld_t *, size_t);
+
+// ---- Helper Functions ----
+
+/* Defines portable and, where available, AVX2 and AVX-512 variants of bitwise kernel
+ * Each variant applies `op' to corresponding bitfields of ap and bp */
+#if defined(ARBITRARY_IFUNC)
+#define BUILD_LOGIC(id, op, op256, op512)                                                       \
+    static void id##_c(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n) {       \
+        for (size_t i = 0; i < n; ++i)                                                          \
+            rp[i] = ap[i] op bp[i];                                                             \
+    }                                                                                           \
+    __attribute__((target("avx2")))                                                             \
+    static void id##_avx2(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n) {    \
+        size_t i = 0;                                                                           \
+                                                                                                \
+        for (; i + 4 <= n; i += 4) {                                                            \
+            _mm256_storeu_si256((__m256i *) (rp + i), op256(                                   \
+                _mm256_loadu_si256((const __m256i *) (ap + i)),                                 \
+                _mm256_loadu_si256((const __m256i *) (bp + i))                                  \
+            ));                                                                                 \
+        }                                                                                       \
+        for (; i < n; ++i)                                                                      \
+            rp[i] = ap[i] op bp[i];                                                             \
+    }                                                                                           \
+    __attribute__((target("avx512f")))                                                          \
+    static void id##_avx512(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n) {  \
+        size_t i = 0;                                                                           \
+                                                                                                \
+        for (; i + 8 <= n; i += 8)                                                              \
+            _mm512_storeu_si512(rp + i, op512(_mm512_loadu_si512(ap + i), _mm512_loadu_si512(bp + i)));  \
+        if (i < n) {    /* Masked tail */                                                       \
+            const __mmask8 mask = (1u << (n - i)) - 1;                                          \
+                                                                                                \
+            _mm512_mask_storeu_epi64(rp + i, mask, op512(                                       \
+                _mm512_maskz_loadu_epi64(mask, ap + i), _mm512_maskz_loadu_epi64(mask, bp + i)  \
+            ));                                                                                 \
+        }                                                                                       \
+    }                                                                                           \
+    __attribute__((no_sanitize_address))                                                        \
+    static logic_fn resolve_##id(void) {                                                        \
+        __builtin_cpu_init();                                                                   \
+        if (__builtin_cpu_supports("avx512f"))                                                  \
+            return id##_avx512;                                                                 \
+        return __builtin_cpu_supports("avx2") ? id##_avx2 : id##_c;                             \
+    }                                                                                           \
+    void ln_##id(bitfld_t *, const bitfld_t *, const bitfld_t *, size_t) __attribute__((ifunc("resolve_" #id)));
+#else
+#define BUILD_LOGIC(id, op, op256, op512)                                                       \
+    void ln_##id(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, size_t n) {              \
+        for (size_t i = 0; i < n; ++i)                                                          \
+            rp[i] = ap[i] op bp[i];                                                             \
+    }
+#endif
+
+static int cmp_n_c(const bitfld_t *, const bitfld_t *, size_t);
+static void com_c(bitfld_t *, const bitfld_t *, size_t);
+
+static inline int cmp_1(bitfld_t, bitfld_t);
+
+// Returns -1, 0, or 1 as bitfield a is less than, equal to, or greater than b
+int cmp_1(bitfld_t a, bitfld_t b) {
+    return (a > b) - (a < b);
+}
+
+// Compares buffers of equal size, one bitfield at a time
+int cmp_n_c(const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    while (n--) {
+        if (ap[n] != bp[n])
+            return cmp_1(ap[n], bp[n]);
+    }
+    return 0;
+}
+
+// Complements buffer, one bitfield at a time
+void com_c(bitfld_t *rp, const bitfld_t *ap, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        rp[i] = ~ap[i];
+}
+
+#if defined(ARBITRARY_IFUNC)
+static int cmp_n_avx2(const bitfld_t *, const bitfld_t *, size_t);
+static int cmp_n_avx512(const bitfld_t *, const bitfld_t *, size_t);
+static void com_avx2(bitfld_t *, const bitfld_t *, size_t);
+static void com_avx512(bitfld_t *, const bitfld_t *, size_t);
+static cmp_fn resolve_cmp(void);
+static com_fn resolve_com(void);
+
+/* Compares buffers of equal size, 4 bitfields at a time
+ * Requires AVX2 */
+__attribute__((target("avx2")))
+int cmp_n_avx2(const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    // Bitfields above largest multiple of 4 are compared first
+    for (; n % 4; --n) {
+        if (ap[n - 1] != bp[n - 1])
+            return cmp_1(ap[n - 1], bp[n - 1]);
+    }
+    while (n) {
+        n -= 4;
+
+        const __m256i eq = _mm256_cmpeq_epi64(
+            _mm256_loadu_si256((const __m256i *) (ap + n)),
+            _mm256_loadu_si256((const __m256i *) (bp + n))
+        );
+        const unsigned neq = ~_mm256_movemask_pd(_mm256_castsi256_pd(eq)) & 0xf;
+
+        if (neq) {
+            const size_t at = n + 31 - __builtin_clz(neq);
+
+            return cmp_1(ap[at], bp[at]);
+        }
+    }
+    return 0;
+}
+
+/* Compares buffers of equal size, 8 bitfields at a time
+ * Requires AVX-512F */
+__attribute__((target("avx512f")))
+int cmp_n_avx512(const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    for (; n % 8; --n) {
+        if (ap[n - 1] != bp[n - 1])
+            return cmp_1(ap[n - 1], bp[n - 1]);
+    }
+    while (n) {
+        n -= 8;
+
+        const unsigned neq = _mm512_cmpneq_epu64_mask(_mm512_loadu_si512(ap + n), _mm512_loadu_si512(bp + n));
+
+        if (neq) {
+            const size_t at = n + 31 - __builtin_clz(neq);
+
+            return cmp_1(ap[at], bp[at]);
+        }
+    }
+    return 0;
+}
+
+/* Complements buffer, 4 bitfields at a time
+ * Requires AVX2 */
+__attribute__((target("avx2")))
+void com_avx2(bitfld_t *rp, const bitfld_t *ap, size_t n) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_si256((__m256i *) (rp + i),
+          _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (ap + i)), ones));
+    }
+    for (; i < n; ++i)
+        rp[i] = ~ap[i];
+}
+
+/* Complements buffer, 8 bitfields at a time
+ * Requires AVX-512F */
+__attribute__((target("avx512f")))
+void com_avx512(bitfld_t *rp, const bitfld_t *ap, size_t n) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_si512(rp + i, _mm512_xor_si512(_mm512_loadu_si512(ap + i), ones));
+    if (i < n) {
+        const __mmask8 mask = (1u << (n - i)) - 1;
+
+        _mm512_mask_storeu_epi64(rp + i, mask, _mm512_xor_si512(_mm512_maskz_loadu_epi64(mask, ap + i), ones));
+    }
+}
+
+// Binds `ln_cmp()' to widest variant supported by processor
+__attribute__((no_sanitize_address))
+cmp_fn resolve_cmp(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return cmp_n_avx512;
+    return __builtin_cpu_supports("avx2") ? cmp_n_avx2 : cmp_n_c;
+}
+
+// Binds `ln_com()' to widest variant supported by processor
+__attribute__((no_sanitize_address))
+com_fn resolve_com(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return com_avx512;
+    return __builtin_cpu_supports("avx2") ? com_avx2 : com_c;
+}
+#endif
+
+// ---- Limb Kernels ----
+
+BUILD_LOGIC(and_n, &, _mm256_and_si256, _mm512_and_si512)
+BUILD_LOGIC(ior_n, |, _mm256_or_si256, _mm512_or_si512)
+BUILD_LOGIC(xor_n, ^, _mm256_xor_si256, _mm512_xor_si512)
+
+#if defined(ARBITRARY_IFUNC)
+int ln_cmp(const bitfld_t *, const bitfld_t *, size_t) __attribute__((ifunc("resolve_cmp")));
+void ln_com(bitfld_t *, const bitfld_t *, size_t) __attribute__((ifunc("resolve_com")));
+#else
+int ln_cmp(const bitfld_t *ap, const bitfld_t *bp, size_t n) {
+    return cmp_n_c(ap, bp, n);
+}
+void ln_com(bitfld_t *rp, const bitfld_t *ap, size_t n) {
+    com_c(rp, ap, n);
+}
+#endif
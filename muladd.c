@@ -0,0 +1,235 @@
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+/* Multiply-accumulate kernels
+ *
+ * Schoolbook multiplication and squaring, Montgomery reduction, and
+ * division all reduce to multiplying a buffer by one bitfield. Portably,
+ * each step carries through a double-width product, serializing on one
+ * carry chain. With BMI2 and ADX, `mulx' multiplies without touching flags,
+ * and `adcx'/`adox' keep two independent carry chains (CF and OF): one adds
+ * the high half of the previous product, the other adds or subtracts the
+ * bitfield already in place. Loop control uses `lea' and `jrcxz', which
+ * leave both flags intact, and two bitfields are handled per step.
+ *
+ * Kernels are bound at load time like those of logic.c, falling back to
+ * the portable versions where BMI2 or ADX are missing. */
+
+// ---- Types ----
+
+typedef bitfld_t (*muladd_fn)(bitfld_t *, const bitfld_t *, size_t, bitfld_t);
+
+// ---- Helper Functions ----
+
+static bitfld_t addmul_1_c(bitfld_t *, const bitfld_t *, size_t, bitfld_t);
+static bitfld_t mul_1_c(bitfld_t *, const bitfld_t *, size_t, bitfld_t);
+static bitfld_t submul_1_c(bitfld_t *, const bitfld_t *, size_t, bitfld_t);
+
+// Adds product of buffer and bitfield to rp, one bitfield at a time
+bitfld_t addmul_1_c(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b) {
+    bitfld_t carry = 0;
+    dbitfld_t prod;
+
+    for (size_t i = 0; i < n; ++i) {
+        prod = (dbitfld_t) ap[i] * b + rp[i] + carry;
+        rp[i] = (bitfld_t) prod;
+        carry = (bitfld_t) (prod >> BITFLD_BITS);
+    }
+    return carry;
+}
+
+// Stores product of buffer and bitfield in rp, one bitfield at a time
+bitfld_t mul_1_c(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b) {
+    bitfld_t carry = 0;
+    dbitfld_t prod;
+
+    for (size_t i = 0; i < n; ++i) {
+        prod = (dbitfld_t) ap[i] * b + carry;
+        rp[i] = (bitfld_t) prod;
+        carry = (bitfld_t) (prod >> BITFLD_BITS);
+    }
+    return carry;
+}
+
+// Subtracts product of buffer and bitfield from rp, one bitfield at a time
+bitfld_t submul_1_c(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b) {
+    bitfld_t carry = 0, low;
+    dbitfld_t prod;
+
+    for (size_t i = 0; i < n; ++i) {
+        prod = (dbitfld_t) ap[i] * b + carry;
+        low = (bitfld_t) prod;
+        carry = (bitfld_t) (prod >> BITFLD_BITS) + (rp[i] < low);
+        rp[i] -= low;
+    }
+    return carry;
+}
+
+#if defined(ARBITRARY_IFUNC)
+static bitfld_t addmul_1_adx(bitfld_t *, const bitfld_t *, size_t, bitfld_t);
+static bitfld_t mul_1_mulx(bitfld_t *, const bitfld_t *, size_t, bitfld_t);
+static bitfld_t submul_1_adx(bitfld_t *, const bitfld_t *, size_t, bitfld_t);
+static muladd_fn resolve_addmul_1(void);
+static muladd_fn resolve_mul_1(void);
+static muladd_fn resolve_submul_1(void);
+
+/* Adds product of buffer and bitfield to rp, two bitfields at a time
+ * Requires BMI2 and ADX */
+bitfld_t addmul_1_adx(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b) {
+    bitfld_t carry = 0, lo, hi;
+    size_t pairs = n / 2;
+
+    if (n & 1) {    // Odd bitfield is handled first, its carry entering the loop
+        carry = addmul_1_c(rp++, ap++, 1, b);
+    }
+
+    // CF: high halves of products; OF: bitfields of rp
+    __asm__(
+        "xor    %k[lo], %k[lo]\n\t"
+        "1:\n\t"
+        "jrcxz  2f\n\t"
+        "mulx   (%[ap]), %[lo], %[hi]\n\t"
+        "adcx   %[carry], %[lo]\n\t"
+        "adox   (%[rp]), %[lo]\n\t"
+        "mov    %[lo], (%[rp])\n\t"
+        "mulx   8(%[ap]), %[lo], %[carry]\n\t"
+        "adcx   %[hi], %[lo]\n\t"
+        "adox   8(%[rp]), %[lo]\n\t"
+        "mov    %[lo], 8(%[rp])\n\t"
+        "lea    16(%[ap]), %[ap]\n\t"
+        "lea    16(%[rp]), %[rp]\n\t"
+        "lea    -1(%[pairs]), %[pairs]\n\t"
+        "jmp    1b\n\t"
+        "2:\n\t"
+        "mov    $0, %k[lo]\n\t"
+        "adcx   %[lo], %[carry]\n\t"
+        "adox   %[lo], %[carry]"
+        : [rp] "+&r" (rp), [ap] "+&r" (ap), [pairs] "+&c" (pairs), [carry] "+&r" (carry),
+          [lo] "=&r" (lo), [hi] "=&r" (hi)
+        : "d" (b)
+        : "cc", "memory"
+    );
+    return carry;
+}
+
+/* Stores product of buffer and bitfield in rp, two bitfields at a time
+ * Requires BMI2 */
+bitfld_t mul_1_mulx(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b) {
+    bitfld_t carry = 0, lo, hi;
+    size_t pairs = n / 2;
+
+    if (n & 1) {
+        carry = mul_1_c(rp++, ap++, 1, b);
+    }
+    __asm__(
+        "xor    %k[lo], %k[lo]\n\t"
+        "1:\n\t"
+        "jrcxz  2f\n\t"
+        "mulx   (%[ap]), %[lo], %[hi]\n\t"
+        "adc    %[carry], %[lo]\n\t"
+        "mov    %[lo], (%[rp])\n\t"
+        "mulx   8(%[ap]), %[lo], %[carry]\n\t"
+        "adc    %[hi], %[lo]\n\t"
+        "mov    %[lo], 8(%[rp])\n\t"
+        "lea    16(%[ap]), %[ap]\n\t"
+        "lea    16(%[rp]), %[rp]\n\t"
+        "lea    -1(%[pairs]), %[pairs]\n\t"
+        "jmp    1b\n\t"
+        "2:\n\t"
+        "adc    $0, %[carry]"
+        : [rp] "+&r" (rp), [ap] "+&r" (ap), [pairs] "+&c" (pairs), [carry] "+&r" (carry),
+          [lo] "=&r" (lo), [hi] "=&r" (hi)
+        : "d" (b)
+        : "cc", "memory"
+    );
+    return carry;
+}
+
+/* Subtracts product of buffer and bitfield from rp, two bitfields at a time
+ * Requires BMI2 and ADX */
+bitfld_t submul_1_adx(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b) {
+    bitfld_t carry = 0, lo, hi;
+    size_t pairs = n / 2;
+
+    if (n & 1) {
+        carry = submul_1_c(rp++, ap++, 1, b);
+    }
+
+    /* OF: high halves of products; CF: rp + ~product, starting at 1
+     * CF of 0 marks a borrow */
+    __asm__(
+        "xor    %k[lo], %k[lo]\n\t"
+        "stc\n\t"
+        "1:\n\t"
+        "jrcxz  2f\n\t"
+        "mulx   (%[ap]), %[lo], %[hi]\n\t"
+        "adox   %[carry], %[lo]\n\t"
+        "not    %[lo]\n\t"
+        "adcx   (%[rp]), %[lo]\n\t"
+        "mov    %[lo], (%[rp])\n\t"
+        "mulx   8(%[ap]), %[lo], %[carry]\n\t"
+        "adox   %[hi], %[lo]\n\t"
+        "not    %[lo]\n\t"
+        "adcx   8(%[rp]), %[lo]\n\t"
+        "mov    %[lo], 8(%[rp])\n\t"
+        "lea    16(%[ap]), %[ap]\n\t"
+        "lea    16(%[rp]), %[rp]\n\t"
+        "lea    -1(%[pairs]), %[pairs]\n\t"
+        "jmp    1b\n\t"
+        "2:\n\t"
+        "mov    $0, %k[lo]\n\t"
+        "adox   %[lo], %[carry]\n\t"
+        "cmc\n\t"
+        "adcx   %[lo], %[carry]"
+        : [rp] "+&r" (rp), [ap] "+&r" (ap), [pairs] "+&c" (pairs), [carry] "+&r" (carry),
+          [lo] "=&r" (lo), [hi] "=&r" (hi)
+        : "d" (b)
+        : "cc", "memory"
+    );
+    return carry;
+}
+
+// Binds `ln_addmul_1()' to ADX kernel if supported by processor
+__attribute__((no_sanitize_address))
+muladd_fn resolve_addmul_1(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx") ? addmul_1_adx : addmul_1_c;
+}
+
+// Binds `ln_mul_1()' to BMI2 kernel if supported by processor
+__attribute__((no_sanitize_address))
+muladd_fn resolve_mul_1(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2") ? mul_1_mulx : mul_1_c;
+}
+
+// Binds `ln_submul_1()' to ADX kernel if supported by processor
+__attribute__((no_sanitize_address))
+muladd_fn resolve_submul_1(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx") ? submul_1_adx : submul_1_c;
+}
+#endif
+
+// ---- Limb Kernels ----
+
+#if defined(ARBITRARY_IFUNC)
+bitfld_t ln_mul_1(bitfld_t *, const bitfld_t *, size_t, bitfld_t) __attribute__((ifunc("resolve_mul_1")));
+bitfld_t ln_addmul_1(bitfld_t *, const bitfld_t *, size_t, bitfld_t) __attribute__((ifunc("resolve_addmul_1")));
+bitfld_t ln_submul_1(bitfld_t *, const bitfld_t *, size_t, bitfld_t) __attribute__((ifunc("resolve_submul_1")));
+#else
+bitfld_t ln_mul_1(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b) {
+    return mul_1_c(rp, ap, n, b);
+}
+bitfld_t ln_addmul_1(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b) {
+    return addmul_1_c(rp, ap, n, b);
+}
+bitfld_t ln_submul_1(bitfld_t *rp, const bitfld_t *ap, size_t n, bitfld_t b) {
+    return submul_1_c(rp, ap, n, b);
+}
+#endif
@@ -0,0 +1,946 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#define PREFIX  dwhl
+
+/* Modular exponentiation
+ *
+ * Odd moduli are handled in Montgomery form, where residues x are stored as
+ * xR mod m for R = 2^(BITFLD_BITS n), so that each product is reduced by
+ * `ln_redc()' rather than by division. Exponents are scanned left to right
+ * in sliding windows over a table of odd powers of the base. Even moduli
+ * fall back to reduction by `ln_divrem()' after every product.
+ *
+ * Pseudo-Mersenne moduli m = 2^k - c, with c fitting one bitfield, take
+ * neither path. Since 2^k = c (mod m), the bits of a product above bit k
+ * are multiplied by c and added back onto the bits below it; each fold
+ * drops about k - BITFLD_BITS bits, so a product is reduced in a few
+ * passes of shifts, one multiplication by a single bitfield, and adds.
+ *
+ * Batches of exponentiations modulo odd moduli of one size run side by side,
+ * BATCH_LANES at a time, on processors with 52-bit multiply-add (AVX-512
+ * IFMA). Residues are split into 52-bit digits, digit j of every lane held in
+ * one vector, so each step of Montgomery multiplication is one instruction
+ * for all lanes. Digits are accumulated in 64-bit lanes without carrying,
+ * and carries are resolved once per product. With R = 2^(52 d) > 4m, every
+ * product of residues below 2m is again below 2m, so no product needs a final
+ * subtraction. Exponents of one batch differ, so they are scanned in fixed
+ * windows, each lane gathering its own power from a table of every power
+ * below 2^w. Elsewhere, the wider 32-bit multiplies of AVX2 do not outrun one
+ * 64-bit multiply per step, and batches run one exponentiation at a time. */
+
+// ---- Constants ----
+
+// # of exponentiations run side by side in batches, and fewest worth running so
+#define BATCH_LANES 8
+#define BATCH_MIN   3
+
+// Bits per digit of batched residues, and largest modulus batched, in bitfields, so that digits never overflow
+#define BATCH_DIGIT_BITS    52
+#define BATCH_DIGIT_MASK    (((uint64_t) 1 << BATCH_DIGIT_BITS) - 1)
+#define BATCH_BITFLDS_MAX   768
+
+// ---- Types ----
+
+// Modulus of exponentiation, reduced in Montgomery form (k = 0) or by folding
+typedef struct {
+    const bitfld_t *mp;
+    size_t n;
+    bitfld_t minv;  // -1/m (mod 2^BITFLD_BITS), in Montgomery form
+    shift_t k;      // m = 2^k - c, if folded
+    bitfld_t c;
+} modulus_t;
+
+// Exponentiation of batch, with size of its modulus
+typedef struct {
+    size_t mn, i;
+} batch_item_t;
+
+// ---- Helper Functions ----
+
+#if defined(__x86_64__)
+static void batch_amm(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *,
+  size_t, uint64_t *);
+static void batch_get(bitfld_t *, size_t, const uint64_t *, size_t, size_t);
+static void batch_in(bitfld_t *, const bitfld_t *, size_t, const bitfld_t *, size_t, size_t, bitfld_t *);
+static void batch_powm(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *,
+  const bitfld_t *const *, const size_t *, size_t, unsigned, uint64_t *);
+static void batch_put(uint64_t *, const bitfld_t *, size_t, size_t, size_t);
+static size_t batch_run(dwhl_t *const *, const dwhl_t *const *, const dwhl_t *const *, const dwhl_t *const *,
+  const batch_item_t *, size_t, int *, int *);
+#endif
+static int cmp_item(const void *, const void *);
+static unsigned exp_bits(const bitfld_t *, size_t, size_t, unsigned);
+static void mod_mul(bitfld_t *, const bitfld_t *, const bitfld_t *, const modulus_t *, bitfld_t *,
+  const dwhl_tune_t *);
+static dwhl_t *pmod_set(dwhl_t *, bitfld_t *, size_t, bool, const dwhl_pmod_t *);
+static size_t powm_div(bitfld_t *, const bitfld_t *, size_t, const bitfld_t *, size_t,
+  const bitfld_t *, size_t, bitfld_t *, const dwhl_tune_t *);
+static size_t powm_div_itch(size_t, const dwhl_tune_t *);
+static int powm_one(dwhl_t *, const dwhl_t *, const dwhl_t *, const dwhl_t *);
+static unsigned powm_window(size_t, unsigned);
+static void win_powm(bitfld_t *, const bitfld_t *, const bitfld_t *, size_t, const modulus_t *, bitfld_t *,
+  const dwhl_tune_t *);
+
+#if defined(__x86_64__)
+/* Stores Montgomery product of a and b, each d digits per lane and below 2m, in rp, which may equal either
+ * Result is below 2m, given R > 4m; tp holds 2d + 1 digits per lane
+ * Requires AVX-512 IFMA */
+__attribute__((target("avx512f,avx512ifma")))
+void batch_amm(uint64_t *rp, const uint64_t *ap, const uint64_t *bp, const uint64_t *mp, const uint64_t *minv,
+  size_t d, uint64_t *tp) {
+    const size_t step = d * BATCH_LANES;
+    const __m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(BATCH_DIGIT_MASK),
+      mi = _mm512_loadu_si512(minv), a0 = _mm512_loadu_si512(ap), m0 = _mm512_loadu_si512(mp);
+    __m512i carry = zero;
+
+    memset(tp, 0, (2 * d + 1) * BATCH_LANES * sizeof(uint64_t));
+    for (size_t i = 0; i < d; ++i) {
+        uint64_t *const t = tp + i * BATCH_LANES;
+        const __m512i bi = _mm512_loadu_si512(bp + i * BATCH_LANES);
+
+        // t += a b_i + q m, for q clearing the low digit; the high half of each product lands one digit up
+        __m512i v = _mm512_madd52lo_epu64(_mm512_loadu_si512(t), a0, bi);
+        const __m512i q = _mm512_madd52lo_epu64(zero, v, mi);
+
+        carry = _mm512_srli_epi64(_mm512_madd52lo_epu64(v, m0, q), BATCH_DIGIT_BITS);
+        for (size_t j = 1; j < d; ++j) {
+            const uint64_t *const aj = ap + j * BATCH_LANES, *const mj = mp + j * BATCH_LANES;
+
+            v = _mm512_madd52lo_epu64(_mm512_loadu_si512(t + j * BATCH_LANES), _mm512_loadu_si512(aj), bi);
+            v = _mm512_madd52lo_epu64(v, _mm512_loadu_si512(mj), q);
+            v = _mm512_madd52hi_epu64(v, _mm512_loadu_si512(aj - BATCH_LANES), bi);
+            v = _mm512_madd52hi_epu64(v, _mm512_loadu_si512(mj - BATCH_LANES), q);
+            if (j == 1)
+                v = _mm512_add_epi64(v, carry);
+            _mm512_storeu_si512(t + j * BATCH_LANES, v);
+        }
+        v = _mm512_madd52hi_epu64(_mm512_loadu_si512(t + step), _mm512_loadu_si512(ap + step - BATCH_LANES), bi);
+        v = _mm512_madd52hi_epu64(v, _mm512_loadu_si512(mp + step - BATCH_LANES), q);
+        if (d == 1)
+            v = _mm512_add_epi64(v, carry);
+        _mm512_storeu_si512(t + step, v);
+    }
+    carry = zero;
+    for (size_t j = 0; j < d; ++j) {
+        const __m512i v = _mm512_add_epi64(_mm512_loadu_si512(tp + (d + j) * BATCH_LANES), carry);
+
+        _mm512_storeu_si512(rp + j * BATCH_LANES, _mm512_and_si512(v, mask));
+        carry = _mm512_srli_epi64(v, BATCH_DIGIT_BITS);
+    }
+}
+
+// Stores lane l of d digits in rp, which holds n bitfields
+void batch_get(bitfld_t *rp, size_t n, const uint64_t *dp, size_t d, size_t l) {
+    memset(rp, 0, n * sizeof(bitfld_t));
+    for (size_t j = 0; j < d; ++j) {
+        const size_t at = j * BATCH_DIGIT_BITS / BITFLD_BITS;
+        const unsigned shift = j * BATCH_DIGIT_BITS % BITFLD_BITS;
+        const uint64_t dig = dp[j * BATCH_LANES + l];
+
+        if (at < n)
+            rp[at] |= dig << shift;
+        if (shift > BITFLD_BITS - BATCH_DIGIT_BITS && at + 1 < n)
+            rp[at + 1] |= dig >> (BITFLD_BITS - shift);
+    }
+}
+
+/* Stores a 2^shift modulo m in rp, which holds mn bitfields
+ * tp holds 2 (an + shift / BITFLD_BITS + 1) + ln_divrem_itch() bitfields; requires shift >= BITFLD_BITS mn */
+void batch_in(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *mp, size_t mn, size_t shift,
+  bitfld_t *tp) {
+    const size_t at = shift / BITFLD_BITS, nn = an + at + 1;
+    bitfld_t *const np = tp, *const qp = np + nn;
+
+    memset(np, 0, at * sizeof(bitfld_t));
+    if (shift % BITFLD_BITS)
+        np[nn - 1] = ln_lshift(np + at, ap, an, shift % BITFLD_BITS);
+    else {
+        memcpy(np + at, ap, an * sizeof(bitfld_t));
+        np[nn - 1] = 0;
+    }
+    ln_divrem(qp, np, nn, mp, mn, qp + nn - mn + 1);
+    memcpy(rp, np, mn * sizeof(bitfld_t));
+}
+
+/* Stores b^e_l in rp for each lane l, where b and one are d digits per lane, in Montgomery form
+ * Result leaves Montgomery form, below m + 1; tp holds (2^w + 3) d + 1 digits per lane, for window width w
+ * Requires AVX-512 IFMA */
+__attribute__((target("avx512f,avx512ifma")))
+void batch_powm(uint64_t *rp, const uint64_t *bp, const uint64_t *one, const uint64_t *mp, const uint64_t *minv,
+  const bitfld_t *const *ep, const size_t *en, size_t d, unsigned w, uint64_t *tp) {
+    const size_t tabn = (size_t) 1 << w, step = d * BATCH_LANES;
+    uint64_t *const tab = tp, *const gp = tab + tabn * step, *const ts = gp + step;
+    long long idx[BATCH_LANES];
+    size_t bits = 0;
+
+    // Every power b^0, ..., b^(2^w - 1)
+    memcpy(tab, one, step * sizeof(uint64_t));
+    memcpy(tab + step, bp, step * sizeof(uint64_t));
+    for (size_t i = 2; i < tabn; ++i)
+        batch_amm(tab + i * step, tab + (i - 1) * step, bp, mp, minv, d, ts);
+    for (size_t l = 0; l < BATCH_LANES; ++l) {
+        const size_t b = en[l] ? en[l] * BITFLD_BITS - bitfld_clz(ep[l][en[l] - 1]) : 0;
+
+        if (b > bits)
+            bits = b;
+    }
+    memcpy(rp, one, step * sizeof(uint64_t));
+    for (size_t i = (bits + w - 1) / w; i--;) {
+        const size_t lo = i * w;
+
+        for (unsigned j = 0; j < w; ++j)
+            batch_amm(rp, rp, rp, mp, minv, d, ts);
+        for (size_t l = 0; l < BATCH_LANES; ++l)
+            idx[l] = (long long) ((lo / BITFLD_BITS < en[l] ? exp_bits(ep[l], en[l], lo, w) : 0) * step + l);
+
+        const __m512i vidx = _mm512_loadu_si512(idx);
+
+        for (size_t j = 0; j < d; ++j)
+            _mm512_storeu_si512(gp + j * BATCH_LANES, _mm512_i64gather_epi64(vidx, tab + j * BATCH_LANES, 8));
+        batch_amm(rp, rp, gp, mp, minv, d, ts);
+    }
+
+    // Montgomery product with 1 leaves Montgomery form
+    memset(gp, 0, step * sizeof(uint64_t));
+    for (size_t l = 0; l < BATCH_LANES; ++l)
+        gp[l] = 1;
+    batch_amm(rp, rp, gp, mp, minv, d, ts);
+}
+
+// Stores n bitfields in lane l of d digits
+void batch_put(uint64_t *dp, const bitfld_t *ap, size_t n, size_t d, size_t l) {
+    for (size_t j = 0; j < d; ++j) {
+        const size_t at = j * BATCH_DIGIT_BITS / BITFLD_BITS;
+        const unsigned shift = j * BATCH_DIGIT_BITS % BITFLD_BITS;
+        uint64_t dig = at < n ? ap[at] >> shift : 0;
+
+        if (shift > BITFLD_BITS - BATCH_DIGIT_BITS && at + 1 < n)
+            dig |= ap[at + 1] << (BITFLD_BITS - shift);
+        dp[j * BATCH_LANES + l] = dig & BATCH_DIGIT_MASK;
+    }
+}
+
+/* Assigns bases[i]^exps[i] modulo |mods[i]| to tars[i] for up to BATCH_LANES items, whose moduli are
+ * odd, above 1, and of one size, and whose exponents are nonnegative, storing errno of each in errs
+ * Returns # of items that failed, storing errno of the last in *last; requires AVX-512 IFMA */
+size_t batch_run(dwhl_t *const *tars, const dwhl_t *const *bases, const dwhl_t *const *exps,
+  const dwhl_t *const *mods, const batch_item_t *items, size_t ct, int *errs, int *last) {
+    const size_t mn = items[0].mn, d = (BITFLD_BITS * mn + 2 + BATCH_DIGIT_BITS - 1) / BATCH_DIGIT_BITS,
+      step = d * BATCH_LANES, shift = BATCH_DIGIT_BITS * d;
+    size_t bsize = 1, esize = 0, msize = 1, en[BATCH_LANES], fails = 0;
+    const bitfld_t *ep[BATCH_LANES];
+    uint64_t minv[BATCH_LANES];
+    unsigned w;
+
+    for (size_t l = 0; l < ct; ++l) {
+        const size_t i = items[l].i;
+
+        if (bases[i]->size > bsize)
+            bsize = bases[i]->size;
+        if (mods[i]->size > msize)
+            msize = mods[i]->size;
+        esize += exps[i]->size;
+    }
+    w = powm_window(esize * BITFLD_BITS / ct, ln_tune.powm_window);
+
+    const size_t nn = bsize + shift / BITFLD_BITS + 1, in = 2 * nn + ln_divrem_itch(nn, mn);
+    bitfld_t *const eb = malloc((esize + msize + bsize + mn + in) * sizeof(bitfld_t)),
+      *const mp = eb + esize, *const bt = mp + msize, *const xp = bt + bsize, *const ts = xp + mn;
+    uint64_t *const digs = malloc(((((size_t) 1 << w) + 7) * step + BATCH_LANES) * sizeof(uint64_t)),
+      *const md = digs, *const bd = md + step, *const one = bd + step, *const rd = one + step, *const tp = rd + step;
+
+    if (!eb || !digs) {
+        for (size_t l = 0; errs && l < ct; ++l)
+            errs[items[l].i] = ENOMEM;
+        *last = ENOMEM;
+        free(eb);
+        free(digs);
+        return ct;
+    }
+
+    // Idle lanes repeat the first item
+    for (size_t l = 0, off = 0; l < BATCH_LANES; ++l) {
+        const size_t k = items[l < ct ? l : 0].i;
+        const bitfld_t unit = 1;
+        size_t bn;
+
+        if (l < ct) {
+            ep[l] = eb + off;
+            en[l] = get_abs(eb + off, exps[k]);
+            off += exps[k]->size;
+        } else {
+            ep[l] = ep[0];
+            en[l] = en[0];
+        }
+        get_abs(mp, mods[k]);
+        minv[l] = -bitfld_binvert(mp[0]) & BATCH_DIGIT_MASK;
+        batch_put(md, mp, mn, d, l);
+
+        // Base, then 1, in Montgomery form; -b is m - b
+        bn = get_abs(bt, bases[k]);
+        if (bn) {
+            batch_in(xp, bt, bn, mp, mn, shift, ts);
+            if (last_fld(bases[k]) & SIGN_BIT && ln_norm(xp, mn))
+                ln_sub_n(xp, mp, xp, mn);
+        } else
+            memset(xp, 0, mn * sizeof(bitfld_t));
+        batch_put(bd, xp, mn, d, l);
+        batch_in(xp, &unit, 1, mp, mn, shift, ts);
+        batch_put(one, xp, mn, d, l);
+    }
+    batch_powm(rd, bd, one, md, minv, ep, en, d, w, tp);
+
+    // Every operand is read before any result is written
+    for (size_t l = 0; l < ct; ++l) {
+        const size_t i = items[l].i;
+        int err = 0;
+
+        get_abs(mp, mods[i]);
+        batch_get(xp, mn, rd, d, l);
+        if (ln_cmp(xp, mp, mn) >= 0)
+            ln_sub_n(xp, xp, mp, mn);
+        if (!set_abs(tars[i], xp, ln_norm(xp, mn), false)) {
+            err = errno ? errno : ENOMEM;
+            *last = err;
+            ++fails;
+        }
+        if (errs)
+            errs[i] = err;
+    }
+    free(eb);
+    free(digs);
+    return fails;
+}
+#endif
+
+// Orders items of batches by size of modulus, then by position
+int cmp_item(const void *lhs, const void *rhs) {
+    const batch_item_t *const a = lhs, *const b = rhs;
+
+    if (a->mn != b->mn)
+        return a->mn < b->mn ? -1 : 1;
+    return a->i < b->i ? -1 : a->i > b->i;
+}
+
+// Returns cnt <= BITFLD_BITS bits of exponent, starting from bit lo
+unsigned exp_bits(const bitfld_t *ep, size_t en, size_t lo, unsigned cnt) {
+    const size_t at = lo / BITFLD_BITS;
+    const unsigned shift = lo % BITFLD_BITS;
+    bitfld_t bits = ep[at] >> shift;
+
+    if (shift && at + 1 < en)
+        bits |= ep[at + 1] << (BITFLD_BITS - shift);
+    return bits & (((bitfld_t) 1 << cnt) - 1);
+}
+
+// Stores product of a and b, each n bitfields and reduced, modulo m in rp, which may equal either
+void mod_mul(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, const modulus_t *mod, bitfld_t *tp,
+  const dwhl_tune_t *tune) {
+    if (mod->k)
+        ln_pmod_mul(rp, ap, bp, mod->k, mod->c, mod->n, tp, tune);
+    else
+        ln_mont_mul(rp, ap, bp, mod->mp, mod->n, mod->minv, tp, tune);
+}
+
+/* Assigns signed x mod m to integer, in range [0, m), where x is xn bitfields of magnitude
+ * x is destroyed, and xp holds one spare bitfield
+ * Returns NULL and sets errno on internal error */
+dwhl_t *pmod_set(dwhl_t *tar, bitfld_t *xp, size_t xn, bool neg, const dwhl_pmod_t *pm) {
+    const shdiv_t result = sh_div(pm->k, BITFLD_BITS);
+    const size_t n = result.quot + (result.rem != 0);
+    bitfld_t *const rp = malloc((n + ln_pmod_red_itch(xn)) * sizeof(bitfld_t));
+    dwhl_t *tmp;
+
+    if (!rp)
+        return NULL;
+    ln_pmod_red(rp, xp, xn, pm->k, pm->c, rp + n);
+
+    // -x = m - x = (2^k - 1 - x) - (c - 1)
+    if (neg && ln_norm(rp, n)) {
+        ln_com(rp, rp, n);
+        if (result.rem)
+            rp[n - 1] &= BITFLD_MAX >> (BITFLD_BITS - result.rem);
+        if (pm->c)
+            ln_sub_1(rp, rp, n, pm->c - 1);
+        else
+            ln_add_1(rp, rp, n, 1);
+    }
+    tmp = set_abs(tar, rp, n, false);
+    free(rp);
+    return tmp;
+}
+
+/* Stores b^e mod m in rp, which holds mn bitfields, returning its size
+ * Reduces by division after each product; requires b < m and e nonzero */
+size_t powm_div(bitfld_t *rp, const bitfld_t *bp, size_t bn, const bitfld_t *ep, size_t en,
+  const bitfld_t *mp, size_t mn, bitfld_t *tp, const dwhl_tune_t *tune) {
+    bitfld_t *pp = tp, *qp = pp + 3 * mn, *dq = qp + 3 * mn, *ts = dq + 2 * mn + 1, *swp;
+    size_t n = bn, pn;
+
+    memcpy(rp, bp, bn * sizeof(bitfld_t));
+    for (size_t bit = en * BITFLD_BITS - bitfld_clz(ep[en - 1]) - 1; bit-- && n;) {
+        ln_sqr_tuned(pp, rp, n, ts, tune);
+        pn = ln_norm(pp, 2 * n);
+        if (ep[bit / BITFLD_BITS] >> bit % BITFLD_BITS & 1) {
+            ln_mul_tuned(qp, pp, pn, bp, bn, ts, tune);
+            pn = ln_norm(qp, pn + bn);
+            swp = pp, pp = qp, qp = swp;
+        }
+        if (pn >= mn) {
+            ln_divrem(dq, pp, pn, mp, mn, ts);
+            pn = ln_norm(pp, mn);
+        }
+        memcpy(rp, pp, pn * sizeof(bitfld_t));
+        n = pn;
+    }
+    return n;
+}
+
+// Temporary space for `powm_div()' with modulus of mn bitfields
+size_t powm_div_itch(size_t mn, const dwhl_tune_t *tune) {
+    const size_t mul = ln_mul_tuned_itch(2 * mn, mn, tune), sqr = ln_sqr_tuned_itch(mn, tune), div = ln_divrem_itch(3 * mn, mn);
+    size_t itch = mul > sqr ? mul : sqr;
+
+    return 8 * mn + 1 + (div > itch ? div : itch);
+}
+
+// Assigns base^exp modulo |mod| to tar, returning errno, or 0 on success
+int powm_one(dwhl_t *tar, const dwhl_t *base, const dwhl_t *exp, const dwhl_t *mod) {
+    dwhl_t tmp;
+    int err = 0;
+
+    if (!dwhl_initi(&tmp, base))
+        return errno ? errno : ENOMEM;
+    if (!dwhl_powmeq(&tmp, exp, mod) || !dwhl_eq(tar, &tmp))
+        err = errno ? errno : ENOMEM;
+    dwhl_clr(&tmp);
+    return err;
+}
+
+// Returns window width for exponent of given # of bits, at most max but no less than 1
+unsigned powm_window(size_t bits, unsigned max) {
+    const unsigned w = bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : bits > 7 ? 2 : 1;
+
+    return w <= max ? w : max ? max : 1;
+}
+
+/* Stores b^e in rp, where b and result are n bitfields reduced modulo m, scanning e in sliding windows
+ * tp holds 2^(w - 1) n + n bitfields, for window width w, followed by those of products */
+void win_powm(bitfld_t *rp, const bitfld_t *bp, const bitfld_t *ep, size_t en, const modulus_t *mod,
+  bitfld_t *tp, const dwhl_tune_t *tune) {
+    const size_t n = mod->n, bits = en * BITFLD_BITS - bitfld_clz(ep[en - 1]);
+    const unsigned w = powm_window(bits, tune->powm_window);
+    const size_t tabn = (size_t) 1 << (w - 1);
+    bitfld_t *tab = tp, *b2 = tab + tabn * n, *ts = b2 + n;
+    bool started = false;
+
+    // Odd powers b, b^3, ..., b^(2^w - 1)
+    memcpy(tab, bp, n * sizeof(bitfld_t));
+    if (tabn > 1) {
+        mod_mul(b2, bp, bp, mod, ts, tune);
+        for (size_t i = 1; i < tabn; ++i)
+            mod_mul(tab + i * n, tab + (i - 1) * n, b2, mod, ts, tune);
+    }
+    for (size_t i = bits; i--;) {
+        if (!(ep[i / BITFLD_BITS] >> i % BITFLD_BITS & 1)) {
+            mod_mul(rp, rp, rp, mod, ts, tune);
+            continue;
+        }
+
+        // Widest window ending in a set bit
+        size_t lo = i + 1 >= w ? i + 1 - w : 0;
+
+        while (!(ep[lo / BITFLD_BITS] >> lo % BITFLD_BITS & 1))
+            ++lo;
+
+        const unsigned cnt = i - lo + 1, win = exp_bits(ep, en, lo, cnt);
+
+        if (started) {
+            for (unsigned j = 0; j < cnt; ++j)
+                mod_mul(rp, rp, rp, mod, ts, tune);
+            mod_mul(rp, rp, tab + (win >> 1) * n, mod, ts, tune);
+        } else {
+            memcpy(rp, tab + (win >> 1) * n, n * sizeof(bitfld_t));
+            started = true;
+        }
+        i = lo;
+    }
+}
+
+// ---- Limb Kernels ----
+
+void ln_redc(bitfld_t *rp, bitfld_t *tp, const bitfld_t *mp, size_t n, bitfld_t minv) {
+    // Carry out of each row is parked in the bitfield that row cleared
+    for (size_t i = 0; i < n; ++i)
+        tp[i] = ln_addmul_1(tp + i, mp, n, tp[i] * minv);
+    if (ln_add_n(rp, tp + n, tp, n) || ln_cmp(rp, mp, n) >= 0)
+        ln_sub_n(rp, rp, mp, n);
+}
+
+size_t ln_mont_mul_itch(size_t n, const dwhl_tune_t *tune) {
+    const size_t mul = ln_mul_tuned_itch(n, n, tune), sqr = ln_sqr_tuned_itch(n, tune);
+
+    return 2 * n + (mul > sqr ? mul : sqr);
+}
+void ln_mont_mul(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, const bitfld_t *mp, size_t n,
+  bitfld_t minv, bitfld_t *tp, const dwhl_tune_t *tune) {
+    if (ap == bp)
+        ln_sqr_tuned(tp, ap, n, tp + 2 * n, tune);
+    else
+        ln_mul_tuned(tp, ap, n, bp, n, tp + 2 * n, tune);
+    ln_redc(rp, tp, mp, n, minv);
+}
+
+size_t ln_mont_in_itch(size_t an, size_t n) {
+    return 2 * an + n + 1 + ln_divrem_itch(an + n, n);
+}
+void ln_mont_in(bitfld_t *rp, const bitfld_t *ap, size_t an, const bitfld_t *mp, size_t n, bitfld_t *tp) {
+    bitfld_t *np = tp, *qp = np + an + n;
+
+    memset(np, 0, n * sizeof(bitfld_t));
+    memcpy(np + n, ap, an * sizeof(bitfld_t));
+    ln_divrem(qp, np, an + n, mp, n, qp + an + 1);
+    memcpy(rp, np, n * sizeof(bitfld_t));
+}
+
+void ln_mont_out(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *mp, size_t n, bitfld_t minv, bitfld_t *tp) {
+    memcpy(tp, ap, n * sizeof(bitfld_t));
+    memset(tp + n, 0, n * sizeof(bitfld_t));
+    ln_redc(rp, tp, mp, n, minv);
+}
+
+size_t ln_mont_powm_itch(size_t n, size_t en, const dwhl_tune_t *tune) {
+    const size_t bits = en * BITFLD_BITS;
+
+    return ((size_t) 1 << (powm_window(bits, tune->powm_window) - 1)) * n + n + ln_mont_mul_itch(n, tune);
+}
+void ln_mont_powm(bitfld_t *rp, const bitfld_t *bp, const bitfld_t *ep, size_t en,
+  const bitfld_t *mp, size_t n, bitfld_t minv, bitfld_t *tp, const dwhl_tune_t *tune) {
+    const modulus_t mod = {mp, n, minv, 0, 0};
+
+    win_powm(rp, bp, ep, en, &mod, tp, tune);
+}
+
+bool ln_pmod_form(const bitfld_t *mp, size_t mn, shift_t *k, bitfld_t *c) {
+    const unsigned top = bitfld_sig(mp[mn - 1]);
+    const bitfld_t ones = BITFLD_MAX >> (BITFLD_BITS - top);
+    size_t i = 0;
+
+    if (mn < 2)
+        return false;
+
+    // Powers of 2 are 2^k - 0
+    while (i < mn - 1 && !mp[i])
+        ++i;
+    if (i == mn - 1 && !(mp[mn - 1] & (mp[mn - 1] - 1))) {
+        *k = (shift_t) (mn - 1) * BITFLD_BITS + top - 1;
+        *c = 0;
+        return *k >= 2 * BITFLD_BITS;
+    }
+
+    // Otherwise, every bit above the low bitfield is set, and c = 2^BITFLD_BITS - m[0]
+    for (i = 1; i < mn - 1 && mp[i] == BITFLD_MAX; ++i)
+        ;
+    *k = (shift_t) (mn - 1) * BITFLD_BITS + top;
+    *c = -mp[0];
+    return i == mn - 1 && mp[mn - 1] == ones && mp[0] && *k >= 2 * BITFLD_BITS;
+}
+
+size_t ln_pmod_red_itch(size_t xn) {
+    return xn + 1;
+}
+void ln_pmod_red(bitfld_t *rp, bitfld_t *xp, size_t xn, shift_t k, bitfld_t c, bitfld_t *tp) {
+    const shdiv_t result = sh_div(k, BITFLD_BITS);
+    const size_t q = result.quot, n = q + (result.rem != 0);
+    const unsigned r = result.rem;
+
+    // x = hi 2^k + lo = hi c + lo (mod m), until x < 2^k
+    xn = ln_norm(xp, xn);
+    while (xn > q && (xn > n || xp[q] >> r)) {
+        size_t hn = xn - q, ln = n;
+
+        if (r) {
+            ln_rshift(tp, xp + q, hn, r);
+            xp[q] &= BITFLD_MAX >> (BITFLD_BITS - r);
+        } else
+            memcpy(tp, xp + q, hn * sizeof(bitfld_t));
+        hn = ln_norm(tp, hn);
+        tp[hn] = ln_mul_1(tp, tp, hn, c);
+        ++hn;
+        ln = ln_norm(xp, ln);
+        if (hn >= ln) {
+            xp[hn] = ln_add(xp, tp, hn, xp, ln);
+            xn = ln_norm(xp, hn + 1);
+        } else {
+            xp[ln] = ln_add(xp, xp, ln, tp, hn);
+            xn = ln_norm(xp, ln + 1);
+        }
+    }
+
+    // x < 2^k < 2m, so x - m = x + c - 2^k is taken at most once
+    memcpy(rp, xp, xn * sizeof(bitfld_t));
+    memset(rp + xn, 0, (n - xn) * sizeof(bitfld_t));
+    if (!c)
+        return;
+    if (ln_add_1(rp, rp, n, c) || (r && rp[q] >> r)) {
+        if (r)
+            rp[q] &= BITFLD_MAX >> (BITFLD_BITS - r);
+    } else
+        ln_sub_1(rp, rp, n, c);
+}
+
+size_t ln_pmod_mul_itch(size_t n, const dwhl_tune_t *tune) {
+    const size_t mul = ln_mul_tuned_itch(n, n, tune), sqr = ln_sqr_tuned_itch(n, tune), red = ln_pmod_red_itch(2 * n);
+    size_t itch = mul > sqr ? mul : sqr;
+
+    return 2 * n + 1 + (red > itch ? red : itch);
+}
+void ln_pmod_mul(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, shift_t k, bitfld_t c, size_t n,
+  bitfld_t *tp, const dwhl_tune_t *tune) {
+    if (ap == bp)
+        ln_sqr_tuned(tp, ap, n, tp + 2 * n + 1, tune);
+    else
+        ln_mul_tuned(tp, ap, n, bp, n, tp + 2 * n + 1, tune);
+    ln_pmod_red(rp, tp, 2 * n, k, c, tp + 2 * n + 1);
+}
+
+size_t ln_pmod_powm_itch(size_t n, size_t en, const dwhl_tune_t *tune) {
+    const size_t bits = en * BITFLD_BITS;
+
+    return ((size_t) 1 << (powm_window(bits, tune->powm_window) - 1)) * n + n + ln_pmod_mul_itch(n, tune);
+}
+void ln_pmod_powm(bitfld_t *rp, const bitfld_t *bp, const bitfld_t *ep, size_t en, shift_t k, bitfld_t c,
+  size_t n, bitfld_t *tp, const dwhl_tune_t *tune) {
+    const modulus_t mod = {NULL, n, 0, k, c};
+
+    win_powm(rp, bp, ep, en, &mod, tp, tune);
+}
+
+size_t ln_powm_itch(size_t bn, size_t en, size_t n, const dwhl_tune_t *tune) {
+    const size_t in = ln_mont_in_itch(bn, n), pow = ln_mont_powm_itch(n, en, tune),
+      div = powm_div_itch(n, tune), red = bn + 1 + ln_pmod_red_itch(bn), fold = ln_pmod_powm_itch(n, en, tune);
+    size_t itch = in > pow ? in : pow;
+
+    if (div > itch)
+        itch = div;
+    if (red > itch)
+        itch = red;
+    if (fold > itch)
+        itch = fold;
+    return n + itch;
+}
+size_t ln_powm(bitfld_t *rp, const bitfld_t *bp, size_t bn, const bitfld_t *ep, size_t en,
+  const bitfld_t *mp, size_t n, bitfld_t *tp, const dwhl_tune_t *tune) {
+    bitfld_t *xp = tp, *ts = xp + n, c;
+    shift_t k;
+
+    if (ln_pmod_form(mp, n, &k, &c)) {
+        const size_t pn = (k + BITFLD_BITS - 1) / BITFLD_BITS;    // n - 1 for powers of 2
+
+        memcpy(ts, bp, bn * sizeof(bitfld_t));
+        ln_pmod_red(xp, ts, bn, k, c, ts + bn + 1);
+        ln_pmod_powm(rp, xp, ep, en, k, c, pn, ts, tune);
+        return ln_norm(rp, pn);
+    }
+    if (!(mp[0] & 1)) {
+        bitfld_t *np = ts, *qp = np + bn;
+
+        // powm_div() requires base below modulus
+        memcpy(np, bp, bn * sizeof(bitfld_t));
+        if (bn >= n) {
+            ln_divrem(qp, np, bn, mp, n, qp + bn - n + 1);
+            bn = ln_norm(np, n);
+        }
+        memcpy(xp, np, bn * sizeof(bitfld_t));
+        return bn ? powm_div(rp, xp, bn, ep, en, mp, n, ts, tune) : 0;
+    }
+
+    const bitfld_t minv = -bitfld_binvert(mp[0]);
+
+    ln_mont_in(xp, bp, bn, mp, n, ts);
+    ln_mont_powm(rp, xp, ep, en, mp, n, minv, ts, tune);
+    ln_mont_out(rp, rp, mp, n, minv, ts);
+    return ln_norm(rp, n);
+}
+
+// ---- dwhl_t Internals ----
+
+// Returns scratch space, in bitfields, needed by `do_powm()'
+size_t powm_itch(const dwhl_t *tar, const dwhl_t *exp, const dwhl_t *mod, const dwhl_tune_t *tune) {
+    const size_t esize = exp->size, msize = mod->size, size = (tar->size < msize ? msize : tar->size) + 2;
+
+    return 5 * size + esize + ln_powm_itch(size, esize, msize, tune) + ln_gcdext_itch(size, msize);
+}
+
+/* Assigns tar^exp modulo |mod| to tar
+ * Reads exp and mod only once, before any result is stored */
+dwhl_t *do_powm(dwhl_t *tar, const dwhl_t *exp, const dwhl_t *mod, bitfld_t *tp, const dwhl_tune_t *tune) {
+    const bool eneg = last_fld(exp) & SIGN_BIT;
+    const size_t esize = exp->size, msize = mod->size, size = (tar->size < msize ? msize : tar->size) + 2;
+    bitfld_t *const bp = tp, *const mp = bp + size, *const ep = mp + size, *const rp = ep + esize,
+      *const sp = rp + size, *const ts = sp + size;
+    size_t bn = get_abs(bp, tar), rn = 0;
+    const size_t en = get_abs(ep, exp), mn = get_abs(mp, mod);
+
+    if (!mn) {
+        errno = EDOM;
+        return NULL;
+    }
+    if (mn == 1 && mp[0] == 1)      // Every residue is 0
+        return set_abs(tar, rp, 0, false);
+
+    // Reduce base to least nonnegative residue
+    if (bn >= mn) {
+        ln_divrem(ts, bp, bn, mp, mn, ts + bn - mn + 1);
+        bn = ln_norm(bp, mn);
+    }
+    if (bn && last_fld(tar) & SIGN_BIT) {
+        ln_sub(bp, mp, mn, bp, bn);
+        bn = ln_norm(bp, mn);
+    }
+
+    // b^-e = (b^-1)^e
+    if (eneg) {
+        bitfld_t *m0 = rp, *gp = ts;
+        size_t gn, sn;
+        bool sneg;
+
+        if (!bn) {
+            errno = EDOM;
+            return NULL;
+        }
+        memcpy(m0, mp, mn * sizeof(bitfld_t));
+        gn = ln_gcdext(gp, sp, &sn, &sneg, bp, bn, m0, mn, ts + size);
+        if (gn != 1 || gp[0] != 1) {
+            errno = EDOM;
+            return NULL;
+        }
+        if (sn >= mn) {
+            ln_divrem(ts, sp, sn, mp, mn, ts + sn - mn + 1);
+            sn = ln_norm(sp, mn);
+        }
+        if (sneg && sn) {
+            ln_sub(sp, mp, mn, sp, sn);
+            sn = ln_norm(sp, mn);
+        }
+        memcpy(bp, sp, sn * sizeof(bitfld_t));
+        bn = sn;
+    }
+    if (!en) {
+        rp[0] = 1;
+        rn = 1;
+    } else if (bn)
+        rn = ln_powm(rp, bp, bn, ep, en, mp, mn, ts, tune);
+    return set_abs(tar, rp, rn, false);
+}
+
+// ---- Number Theory ----
+
+export dwhl_t *dwhl_powmeq(dwhl_t *tar, const dwhl_t *exp, const dwhl_t *mod) {
+    if (!tar || !exp || !mod) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+
+    bitfld_t *const tp = malloc(powm_itch(tar, exp, mod, &ln_tune) * sizeof(bitfld_t));
+    dwhl_t *const tmp = tp ? do_powm(tar, exp, mod, tp, &ln_tune) : NULL;
+
+    free(tp);
+    return tmp;
+}
+
+export size_t dwhl_powm_batch(dwhl_t *const *tars, const dwhl_t *const *bases, const dwhl_t *const *exps,
+  const dwhl_t *const *mods, size_t n, int *errs) {
+    if (n && (!tars || !bases || !exps || !mods)) {
+        errno = EINVAL;
+        return n;
+    }
+
+    batch_item_t *const items = malloc(n * sizeof(batch_item_t));
+    size_t msize = 1, ct = 0, fails = 0;
+    bitfld_t *mp = NULL;
+    int last = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (mods[i] && mods[i]->size > msize)
+            msize = mods[i]->size;
+    }
+    if (!items || !(mp = malloc(msize * sizeof(bitfld_t)))) {
+        for (size_t i = 0; errs && i < n; ++i)
+            errs[i] = ENOMEM;
+        free(items);
+        errno = ENOMEM;
+        return n;
+    }
+
+    // Odd moduli above 1 with nonnegative exponents are batched where supported; the rest run alone
+#if defined(__x86_64__)
+    const bool ifma = __builtin_cpu_supports("avx512ifma");
+#else
+    const bool ifma = false;
+#endif
+
+    for (size_t i = 0; i < n; ++i) {
+        int err;
+
+        if (!tars[i] || !bases[i] || !exps[i] || !mods[i])
+            err = EINVAL;
+        else {
+            const size_t mn = ifma ? get_abs(mp, mods[i]) : 0;
+
+            if (mn && mn <= BATCH_BITFLDS_MAX && mp[0] & 1 && (mn > 1 || mp[0] > 1)
+              && !(last_fld(exps[i]) & SIGN_BIT)) {
+                items[ct++] = (batch_item_t) {mn, i};
+                continue;
+            }
+            err = powm_one(tars[i], bases[i], exps[i], mods[i]);
+        }
+        if (errs)
+            errs[i] = err;
+        if (err) {
+            last = err;
+            ++fails;
+        }
+    }
+    free(mp);
+    qsort(items, ct, sizeof(batch_item_t), cmp_item);
+    for (size_t lo = 0, hi; lo < ct; lo = hi) {
+        for (hi = lo + 1; hi < ct && hi - lo < BATCH_LANES && items[hi].mn == items[lo].mn; ++hi)
+            ;
+#if defined(__x86_64__)
+        if (hi - lo >= BATCH_MIN) {
+            fails += batch_run(tars, bases, exps, mods, items + lo, hi - lo, errs, &last);
+            continue;
+        }
+#endif
+        for (size_t k = lo; k < hi; ++k) {
+            const size_t i = items[k].i;
+            const int err = powm_one(tars[i], bases[i], exps[i], mods[i]);
+
+            if (errs)
+                errs[i] = err;
+            if (err) {
+                last = err;
+                ++fails;
+            }
+        }
+    }
+    free(items);
+    if (fails)
+        errno = last;
+    return fails;
+}
+
+export dwhl_pmod_t *dwhl_pmod_init(dwhl_pmod_t *pm, const dwhl_t *mod) {
+    if (!pm || !mod) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    bitfld_t *const mp = malloc(mod->size * sizeof(bitfld_t));
+    size_t mn;
+    bool form;
+
+    if (!mp)
+        return NULL;
+    mn = get_abs(mp, mod);
+    form = mn && ln_pmod_form(mp, mn, &pm->k, &pm->c);
+    free(mp);
+    if (!form) {
+        errno = EDOM;
+        return NULL;
+    }
+    return pm;
+}
+export dwhl_t *dwhl_pmod_muleq(const dwhl_pmod_t *pm, dwhl_t *tar, const dwhl_t *val) {
+    if (!pm || !tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+
+    const bool neg = (last_fld(tar) ^ last_fld(val)) & SIGN_BIT;
+    const size_t rn = tar->size + val->size;
+    bitfld_t *const ap = malloc((2 * rn + 1 + ln_mul_itch(tar->size, val->size)) * sizeof(bitfld_t)),
+      *const bp = ap + tar->size, *const rp = bp + val->size;
+    size_t an, bn;
+    dwhl_t *tmp;
+
+    if (!ap)
+        return NULL;
+    an = get_abs(ap, tar);
+    bn = get_abs(bp, val);
+    if (an && bn)
+        ln_mul(rp, ap, an, bp, bn, rp + rn + 1);
+    tmp = pmod_set(tar, rp, an && bn ? an + bn : 0, neg, pm);
+    free(ap);
+    return tmp;
+}
+export dwhl_t *dwhl_pmod_redeq(const dwhl_pmod_t *pm, dwhl_t *tar) {
+    if (!pm || !tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+
+    bitfld_t *const xp = malloc((tar->size + 1) * sizeof(bitfld_t));
+    dwhl_t *tmp;
+
+    if (!xp)
+        return NULL;
+    tmp = pmod_set(tar, xp, get_abs(xp, tar), last_fld(tar) & SIGN_BIT, pm);
+    free(xp);
+    return tmp;
+}
+
+export dwhl_t *dwhl_powmeq_take(dwhl_t *tar, dwhl_t *exp, dwhl_t *mod) {
+    dwhl_t *const tmp = dwhl_powmeq(tar, exp, mod);
+
+    dwhl_drop(exp);
+    if (mod != exp)
+        dwhl_drop(mod);
+    return tmp;
+}
+
+export dwhl_t *dwhl_powm(const dwhl_t *base, const dwhl_t *exp, const dwhl_t *mod) {
+    if (!exp || !mod) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    dwhl_t *const cpy = dwhl_tmp(base);
+
+    if (!cpy)
+        return NULL;
+    cpy->rval = false;
+    return ret_rval(cpy, dwhl_powmeq(cpy, exp, mod));
+}
+export dwhl_t *dwhl_powm_take(dwhl_t *base, dwhl_t *exp, dwhl_t *mod) {
+    dwhl_t *tmp;
+
+    if (!base || !base->rval)
+        tmp = dwhl_powm(base, exp, mod);
+    else {
+        base->rval = false;
+        tmp = ret_rval(base, dwhl_powmeq(base, exp, mod));
+    }
+    if (exp != base)
+        dwhl_drop(exp);
+    if (mod != base && mod != exp)
+        dwhl_drop(mod);
+    return tmp;
+}
@@ -0,0 +1,507 @@
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#if ARBITRARY_THREADS > 1
+#include <pthread.h>
+#endif
+
+#define PREFIX  dwhl
+
+/* Primality
+ *
+ * Candidates first have their gcd taken with the product of all odd primes
+ * below TRIAL_PRIME_MAX, which removes most composites for the cost of one
+ * division. Survivors undergo the Baillie-PSW test: a Miller-Rabin round to
+ * base 2 followed by a strong Lucas test with Selfridge's parameters, which
+ * together have no known counterexample, and none below 2^64. Further
+ * Miller-Rabin rounds to pseudorandom bases are independent, and are spread
+ * across ARBITRARY_THREADS threads for large candidates.
+ *
+ * All arithmetic modulo the candidate is done in Montgomery form. */
+
+// ---- Constants ----
+
+// Bound of odd primes whose product is tested against each candidate
+#define TRIAL_PRIME_MAX 1024
+
+// Product of odd primes below TRIAL_PRIME_MAX
+#define PRIMORIAL_SIZE  23
+static const bitfld_t primorial[PRIMORIAL_SIZE] = {
+    0x91e8435d05cc9e19, 0x7c4d5c424516cca4, 0xb88a672998fd4853,
+    0xc4463f61cf3cd9d6, 0x0f02f7086fdeb47c, 0xfc4d8f6d690298ab,
+    0xc9cead20bf5a8668, 0x8726c3f7541b2cbe, 0xcb01ec26a013eaf2,
+    0xf4ff5aab5642e59f, 0xd87c125e7d2b4db0, 0xfc0a73d470bb8c26,
+    0x4aa0297675ef2063, 0x3fb0128f184dc653, 0xf6d872eee1575aa9,
+    0xddf957dea3af6eb4, 0x186ead068ab1275b, 0xf9903efdd8d42357,
+    0x9eb85c874fa94871, 0x9cd2c922dffdefb4, 0x30478a67ff52857e,
+    0x8bcb40df053d0867, 0x00000000000005be,
+};
+
+/* Bound of primes sieved out of candidates by `dwhl_nextprimeeq()',
+ * and # of odd candidates sieved at once */
+#define SIEVE_PRIME_MAX 16384
+#define SIEVE_WINDOW    4096
+
+// ---- Types ----
+
+/* Montgomery arithmetic modulo odd candidate, of n bitfields
+ * Holds R mod m (`one'), and m - 1 = d 2^s for Miller-Rabin */
+typedef struct {
+    const bitfld_t *mp, *one, *dp;
+    size_t n, dn, s;
+    bitfld_t minv;
+} mont_t;
+
+// Share of Miller-Rabin rounds run by one thread
+typedef struct {
+    const mont_t *mt;
+    const bitfld_t *bases;
+    size_t first, step, ct;
+    bitfld_t *tp;
+    atomic_bool *failed;
+} mr_job_t;
+
+// ---- Helper Functions ----
+
+static void add_mod(bitfld_t *, const bitfld_t *, const bitfld_t *, const mont_t *);
+static size_t bpsw_itch(size_t);
+static int bpsw(const bitfld_t *, size_t, unsigned long, bitfld_t *);
+static void half_mod(bitfld_t *, const mont_t *);
+static int jacobi(const bitfld_t *, size_t, long);
+static int jacobi_1(bitfld_t, bitfld_t);
+static bool lucas(const mont_t *, bitfld_t *);
+static size_t lucas_itch(size_t);
+static void mont_init(mont_t *, const bitfld_t *, size_t, bitfld_t *);
+static void mont_small(bitfld_t *, long, const mont_t *, bitfld_t *);
+static bool mr_round(const mont_t *, bitfld_t, bitfld_t *);
+static size_t mr_itch(size_t);
+static bool mr_rounds(const mont_t *, const bitfld_t *, size_t, bitfld_t *);
+static void *mr_worker(void *);
+static void sub_mod(bitfld_t *, const bitfld_t *, const bitfld_t *, const mont_t *);
+static int trial(const bitfld_t *, size_t, bitfld_t *);
+static size_t trial_itch(size_t);
+
+// Stores a + b mod m in rp
+void add_mod(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, const mont_t *mt) {
+    if (ln_add_n(rp, ap, bp, mt->n) || ln_cmp(rp, mt->mp, mt->n) >= 0)
+        ln_sub_n(rp, rp, mt->mp, mt->n);
+}
+
+/* Temporary space for `bpsw()' on candidate of n bitfields, excluding
+ * space for Miller-Rabin rounds beyond the first */
+size_t bpsw_itch(size_t n) {
+    const size_t mr = mr_itch(n), luc = lucas_itch(n);
+
+    return 2 * n + 2 + (mr > luc ? mr : luc);
+}
+
+/* Returns 2 if odd a > 2 is prime, 1 if probably prime, or 0 if composite
+ * Performs Baillie-PSW test, then `reps' further Miller-Rabin rounds */
+int bpsw(const bitfld_t *ap, size_t an, unsigned long reps, bitfld_t *tp) {
+    bitfld_t *ts = tp + 2 * an + 2;
+    mont_t mt;
+
+    mont_init(&mt, ap, an, tp);
+    if (!mr_round(&mt, 2, ts) || !lucas(&mt, ts))
+        return 0;
+    if (an == 1)    // No Baillie-PSW pseudoprimes exist below 2^64
+        return 2;
+    if (!reps)
+        return 1;
+
+    /* Bases are fixed per candidate, so results do not depend on thread count
+     * Space for bases and for each thread follows that of the first round */
+    bitfld_t *bases = ts + mr_itch(an), seed = ap[0] ^ an;
+
+    for (unsigned long i = 0; i < reps; ++i) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        bases[i] = seed % (BITFLD_MAX - 3) + 3;     // an > 1, so every base is below a
+    }
+    return mr_rounds(&mt, bases, reps, bases + reps);
+}
+
+// Halves residue modulo odd m in place
+void half_mod(bitfld_t *ap, const mont_t *mt) {
+    bitfld_t carry = 0;
+
+    if (ap[0] & 1)
+        carry = ln_add_n(ap, ap, mt->mp, mt->n);
+    ln_rshift(ap, ap, mt->n, 1);
+    ap[mt->n - 1] |= carry << (BITFLD_BITS - 1);
+}
+
+// Returns Jacobi symbol (d/a) for odd a > |d|
+int jacobi(const bitfld_t *ap, size_t an, long d) {
+    bitfld_t q = d < 0 ? -(bitfld_t) d : (bitfld_t) d;
+    const bitfld_t a8 = ap[0] & 7;
+    const unsigned twos = bitfld_ctz(q);
+    int j = 1;
+
+    if (d < 0 && (a8 & 3) == 3)                     // (-1/a)
+        j = -j;
+    if (twos & 1 && (a8 == 3 || a8 == 5))           // (2/a)
+        j = -j;
+    q >>= twos;
+    if ((q & 3) == 3 && (a8 & 3) == 3)              // Reciprocity
+        j = -j;
+    return j * jacobi_1(ln_mod_1(ap, an, q), q);
+}
+
+// Returns Jacobi symbol (a/b) for odd b
+int jacobi_1(bitfld_t a, bitfld_t b) {
+    int j = 1;
+
+    while (a) {
+        const unsigned twos = bitfld_ctz(a);
+        bitfld_t r;
+
+        a >>= twos;
+        if (twos & 1 && ((b & 7) == 3 || (b & 7) == 5))
+            j = -j;
+        if ((a & 3) == 3 && (b & 3) == 3)
+            j = -j;
+        r = b % a;
+        b = a;
+        a = r;
+    }
+    return b == 1 ? j : 0;
+}
+
+/* Returns false if candidate fails strong Lucas test with P = 1, Q = (1 - D)/4,
+ * for first D in 5, -7, 9, -11, ... with Jacobi symbol (D/m) = -1 */
+bool lucas(const mont_t *mt, bitfld_t *tp) {
+    const size_t n = mt->n;
+    bitfld_t *up = tp, *vp = up + n, *qk = vp + n, *qm = qk + n, *dm = qm + n, *t = dm + n,
+      *ep = t + n, *ts = ep + n + 1;
+    size_t en, s = 0, bit;
+    long d = 5;
+    int j;
+
+    // Squares have no such D
+    while ((j = jacobi(mt->mp, n, d)) == 1) {
+        if (d == 17) {
+            size_t remn;
+
+            ln_rootrem(ts, ts + n / 2 + 3, &remn, mt->mp, n, 2, ts + n / 2 + 3 + n);
+            if (!remn)
+                return false;
+        }
+        d = d < 0 ? 2 - d : -2 - d;
+    }
+    if (!j)     // Shares factor |D| < m
+        return false;
+    mont_small(dm, d, mt, ts);
+    mont_small(qm, (1 - d) / 4, mt, ts);
+
+    // m + 1 = e 2^s, with e odd
+    memcpy(ep, mt->mp, n * sizeof(bitfld_t));
+    ep[n] = ln_add_1(ep, ep, n, 1);
+    en = ln_norm(ep, n + 1);
+    while (!ep[s / BITFLD_BITS])
+        s += BITFLD_BITS;
+    s += bitfld_ctz(ep[s / BITFLD_BITS]);
+    if (s / BITFLD_BITS) {
+        memmove(ep, ep + s / BITFLD_BITS, (en - s / BITFLD_BITS) * sizeof(bitfld_t));
+        en -= s / BITFLD_BITS;
+    }
+    if (s % BITFLD_BITS)
+        ln_rshift(ep, ep, en, s % BITFLD_BITS);
+    en = ln_norm(ep, en);
+
+    // U_1 = 1, V_1 = P = 1, Q^1
+    memcpy(up, mt->one, n * sizeof(bitfld_t));
+    memcpy(vp, mt->one, n * sizeof(bitfld_t));
+    memcpy(qk, qm, n * sizeof(bitfld_t));
+    for (bit = en * BITFLD_BITS - bitfld_clz(ep[en - 1]) - 1; bit--;) {
+        // U_2k = U_k V_k, V_2k = V_k^2 - 2Q^k
+        ln_mont_mul(up, up, vp, mt->mp, n, mt->minv, ts, &ln_tune);
+        add_mod(t, qk, qk, mt);
+        ln_mont_mul(vp, vp, vp, mt->mp, n, mt->minv, ts, &ln_tune);
+        sub_mod(vp, vp, t, mt);
+        ln_mont_mul(qk, qk, qk, mt->mp, n, mt->minv, ts, &ln_tune);
+        if (ep[bit / BITFLD_BITS] >> bit % BITFLD_BITS & 1) {
+            // U_k+1 = (U_k + V_k)/2, V_k+1 = (D U_k + V_k)/2
+            ln_mont_mul(t, dm, up, mt->mp, n, mt->minv, ts, &ln_tune);
+            add_mod(up, up, vp, mt);
+            half_mod(up, mt);
+            add_mod(vp, vp, t, mt);
+            half_mod(vp, mt);
+            ln_mont_mul(qk, qk, qm, mt->mp, n, mt->minv, ts, &ln_tune);
+        }
+    }
+    if (!ln_norm(up, n) || !ln_norm(vp, n))
+        return true;
+    while (--s) {
+        add_mod(t, qk, qk, mt);
+        ln_mont_mul(vp, vp, vp, mt->mp, n, mt->minv, ts, &ln_tune);
+        sub_mod(vp, vp, t, mt);
+        if (!ln_norm(vp, n))
+            return true;
+        ln_mont_mul(qk, qk, qk, mt->mp, n, mt->minv, ts, &ln_tune);
+    }
+    return false;
+}
+
+// Temporary space for `lucas()' on candidate of n bitfields
+size_t lucas_itch(size_t n) {
+    const size_t mul = ln_mont_mul_itch(n, &ln_tune), in = ln_mont_in_itch(1, n),
+      root = n / 2 + 3 + n + ln_rootrem_itch(n, 2);
+    size_t itch = mul > in ? mul : in;
+
+    return 7 * n + 1 + (root > itch ? root : itch);
+}
+
+/* Sets up Montgomery arithmetic modulo odd m > 2
+ * tp holds 2n + 2 bitfields, followed by `ln_mont_in()' temporary space */
+void mont_init(mont_t *mt, const bitfld_t *mp, size_t n, bitfld_t *tp) {
+    const bitfld_t unit = 1;
+    bitfld_t *one = tp, *dp = one + n;
+    size_t s = 0;
+
+    mt->mp = mp;
+    mt->n = n;
+    mt->minv = -bitfld_binvert(mp[0]);
+    ln_mont_in(one, &unit, 1, mp, n, dp + n + 2);
+    mt->one = one;
+
+    // m - 1 = d 2^s, with d odd
+    memcpy(dp, mp, n * sizeof(bitfld_t));
+    dp[0] &= ~(bitfld_t) 1;
+    while (!dp[s / BITFLD_BITS])
+        s += BITFLD_BITS;
+    s += bitfld_ctz(dp[s / BITFLD_BITS]);
+    mt->dn = n - s / BITFLD_BITS;
+    memmove(dp, dp + s / BITFLD_BITS, mt->dn * sizeof(bitfld_t));
+    if (s % BITFLD_BITS)
+        ln_rshift(dp, dp, mt->dn, s % BITFLD_BITS);
+    mt->dn = ln_norm(dp, mt->dn);
+    mt->dp = dp;
+    mt->s = s;
+}
+
+// Stores small signed integer in Montgomery form in rp
+void mont_small(bitfld_t *rp, long val, const mont_t *mt, bitfld_t *tp) {
+    const bitfld_t mag = val < 0 ? -(bitfld_t) val : (bitfld_t) val;
+
+    ln_mont_in(rp, &mag, 1, mt->mp, mt->n, tp);
+    if (val < 0 && ln_norm(rp, mt->n))
+        ln_sub_n(rp, mt->mp, rp, mt->n);
+}
+
+// Returns false if candidate fails Miller-Rabin round to base 1 < b < m
+bool mr_round(const mont_t *mt, bitfld_t b, bitfld_t *tp) {
+    const size_t n = mt->n;
+    bitfld_t *bm = tp, *xp = bm + n, *mone = xp + n, *ts = mone + n;
+
+    ln_mont_in(bm, &b, 1, mt->mp, n, ts);
+    ln_mont_powm(xp, bm, mt->dp, mt->dn, mt->mp, n, mt->minv, ts, &ln_tune);
+    ln_sub_n(mone, mt->mp, mt->one, n);
+    if (!ln_cmp(xp, mt->one, n) || !ln_cmp(xp, mone, n))
+        return true;
+    for (size_t i = 1; i < mt->s; ++i) {
+        ln_mont_mul(xp, xp, xp, mt->mp, n, mt->minv, ts, &ln_tune);
+        if (!ln_cmp(xp, mone, n))
+            return true;
+        if (!ln_cmp(xp, mt->one, n))
+            return false;
+    }
+    return false;
+}
+
+// Temporary space for `mr_round()' on candidate of n bitfields
+size_t mr_itch(size_t n) {
+    const size_t pow = ln_mont_powm_itch(n, n, &ln_tune), in = ln_mont_in_itch(1, n);
+
+    return 3 * n + (pow > in ? pow : in);
+}
+
+/* Returns false if candidate fails Miller-Rabin round to any of ct bases
+ * tp holds mr_itch(n) bitfields for each thread used */
+bool mr_rounds(const mont_t *mt, const bitfld_t *bases, size_t ct, bitfld_t *tp) {
+    atomic_bool failed = false;
+    mr_job_t jobs[ARBITRARY_THREADS];
+    size_t threads = 1;
+
+#if ARBITRARY_THREADS > 1
+    pthread_t ids[ARBITRARY_THREADS];
+
+    if (mt->n >= PRIME_THREAD_THRESHOLD)
+        threads = ct < ARBITRARY_THREADS ? ct : ARBITRARY_THREADS;
+#endif
+    for (size_t i = 0; i < threads; ++i)
+        jobs[i] = (mr_job_t) {mt, bases, i, threads, ct, tp + i * mr_itch(mt->n), &failed};
+#if ARBITRARY_THREADS > 1
+    // Any thread that cannot be started has its share run here instead
+    size_t started = 1;
+
+    for (; started < threads; ++started) {
+        if (pthread_create(&ids[started], NULL, mr_worker, &jobs[started]))
+            break;
+    }
+    for (size_t i = started; i < threads; ++i)
+        mr_worker(&jobs[i]);
+    mr_worker(&jobs[0]);
+    for (size_t i = 1; i < started; ++i)
+        pthread_join(ids[i], NULL);
+#else
+    mr_worker(&jobs[0]);
+#endif
+    return !atomic_load(&failed);
+}
+
+// Runs share of Miller-Rabin rounds, stopping early once any round fails
+void *mr_worker(void *arg) {
+    const mr_job_t *job = arg;
+
+    for (size_t i = job->first; i < job->ct && !atomic_load(job->failed); i += job->step) {
+        if (!mr_round(job->mt, job->bases[i], job->tp))
+            atomic_store(job->failed, true);
+    }
+    return NULL;
+}
+
+// Stores a - b mod m in rp
+void sub_mod(bitfld_t *rp, const bitfld_t *ap, const bitfld_t *bp, const mont_t *mt) {
+    if (ln_sub_n(rp, ap, bp, mt->n))
+        ln_add_n(rp, rp, mt->mp, mt->n);
+}
+
+/* Returns 2 if odd a > 2 is prime, 0 if it has a prime factor below TRIAL_PRIME_MAX,
+ * and 1 otherwise */
+int trial(const bitfld_t *ap, size_t an, bitfld_t *tp) {
+    bitfld_t *cp = tp, *pp = cp + an + 1, *gp = pp + PRIMORIAL_SIZE + 1, *ts = gp + PRIMORIAL_SIZE;
+
+    // Too small to have a factor above the bound
+    if (an == 1 && ap[0] < (bitfld_t) TRIAL_PRIME_MAX * TRIAL_PRIME_MAX) {
+        for (bitfld_t d = 3; d * d <= ap[0]; d += 2) {
+            if (!(ap[0] % d))
+                return 0;
+        }
+        return 2;
+    }
+    memcpy(cp, ap, an * sizeof(bitfld_t));
+    memcpy(pp, primorial, PRIMORIAL_SIZE * sizeof(bitfld_t));
+    return ln_gcd(gp, cp, an, pp, PRIMORIAL_SIZE, ts) == 1 && gp[0] == 1;
+}
+
+// Temporary space for `trial()' on candidate of an bitfields
+size_t trial_itch(size_t an) {
+    return an + 2 * PRIMORIAL_SIZE + 2 + ln_gcd_itch(an, PRIMORIAL_SIZE);
+}
+
+// ---- Number Theory ----
+
+export int dwhl_probab_prime(const dwhl_t *val, int reps) {
+    if (!val) {
+        errno = EINVAL;
+        return 0;
+    }
+
+    const size_t size = val->size, extra = reps > 0 ? (size_t) reps : 0,
+      itch = trial_itch(size) > bpsw_itch(size) ? trial_itch(size) : bpsw_itch(size);
+    bitfld_t *ap = malloc((size + itch + extra + ARBITRARY_THREADS * mr_itch(size)) * sizeof(bitfld_t));
+    size_t an;
+    int tmp = 0;
+
+    if (!ap)
+        return 0;
+    an = get_abs(ap, val);
+    if (!an || (an == 1 && ap[0] < 3))
+        tmp = an && ap[0] == 2 ? 2 : 0;
+    else if (ap[0] & 1 && (tmp = trial(ap, an, ap + size)) == 1)
+        tmp = bpsw(ap, an, extra, ap + size);
+    free(ap);
+    return tmp;
+}
+
+export dwhl_t *dwhl_nextprimeeq(dwhl_t *tar) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+
+    const size_t size = tar->size + 2, itch = bpsw_itch(size);
+    bitfld_t *cp = malloc((2 * size + itch) * sizeof(bitfld_t) + SIEVE_WINDOW
+      + SIEVE_PRIME_MAX / 2 + SIEVE_PRIME_MAX * sizeof(uint32_t)), *xp = cp + size, *tp = xp + size;
+    uint32_t *primes = (uint32_t *) (tp + itch), *offs;
+    unsigned char *sieve, *composite;
+    size_t cn, np = 0;
+    dwhl_t *tmp = NULL;
+
+    if (!cp)
+        return NULL;
+    offs = primes + SIEVE_PRIME_MAX / 2;
+    sieve = (unsigned char *) (offs + SIEVE_PRIME_MAX / 2);
+    composite = sieve + SIEVE_WINDOW;
+    cn = get_abs(cp, tar);
+    if (dwhl_isneg(tar) || !cn || (cn == 1 && cp[0] < 2)) {
+        cp[0] = 2;
+        tmp = set_abs(tar, cp, 1, false);
+        goto cleanup;
+    }
+
+    // First odd candidate above value
+    cp[cn] = 0;
+    ln_add_1(cp, cp, cn + 1, cp[0] & 1 ? 2 : 1);
+    cn = ln_norm(cp, cn + 1);
+
+    // Odd primes to sieve by, with index of first multiple among candidates c + 2i
+    memset(composite, 0, SIEVE_PRIME_MAX / 2);
+    for (uint32_t p = 3; p < SIEVE_PRIME_MAX; p += 2) {
+        if (composite[p / 2])
+            continue;
+        for (uint32_t q = p * p; q < SIEVE_PRIME_MAX; q += 2 * p)
+            composite[q / 2] = true;
+
+        // c + 2i = 0 (mod p), so i = -c/2 = (p - c mod p)(p + 1)/2
+        uint32_t off = (uint32_t) ((p - ln_mod_1(cp, cn, p)) % p * ((p + 1) / 2) % p);
+
+        if (cn == 1 && cp[0] + 2 * off == p)    // Never sieve out p itself
+            off += p;
+        primes[np] = p;
+        offs[np++] = off;
+    }
+    for (;;) {
+        memset(sieve, 0, SIEVE_WINDOW);
+        for (size_t i = 0; i < np; ++i) {
+            uint32_t off = offs[i];
+
+            for (; off < SIEVE_WINDOW; off += primes[i])
+                sieve[off] = true;
+            offs[i] = off - SIEVE_WINDOW;
+        }
+        for (size_t i = 0; i < SIEVE_WINDOW; ++i) {
+            if (sieve[i])
+                continue;
+            memcpy(xp, cp, cn * sizeof(bitfld_t));
+            xp[cn] = ln_add_1(xp, xp, cn, 2 * i);
+            const size_t xn = ln_norm(xp, cn + 1);
+
+            // Every prime up to the square root has been sieved out
+            if ((xn == 1 && xp[0] < (bitfld_t) SIEVE_PRIME_MAX * SIEVE_PRIME_MAX) || bpsw(xp, xn, 0, tp)) {
+                tmp = set_abs(tar, xp, xn, false);
+                goto cleanup;
+            }
+        }
+        cp[cn] = ln_add_1(cp, cp, cn, 2 * SIEVE_WINDOW);
+        cn = ln_norm(cp, cn + 1);
+    }
+cleanup:
+    free(cp);
+    return tmp;
+}
+
+export dwhl_t *dwhl_nextprime(const dwhl_t *val) { BUILD_UNARY(nextprime, val);      }
+export dwhl_t *dwhl_nextprime_take(dwhl_t *val)   { BUILD_UNARY_TAKE(nextprime, val); }
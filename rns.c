@@ -0,0 +1,621 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#define PREFIX  dwhl
+
+/* Residue number systems
+ *
+ * An integer is held as its residues modulo n primes below 2^31, and is exact
+ * modulo their product M. Sums and products act on each residue alone, so the
+ * loops over residues carry nothing from one to the next, and compilers turn
+ * them into vector instructions. Residues are kept in Montgomery form,
+ * x 2^32 mod p, so that products are reduced by multiplying 32-bit halves,
+ * each product fitting one bitfield, rather than by division.
+ *
+ * The primes are the leaves of a product tree, each node holding the product
+ * of its two children. Integers enter through a remainder tree, reduced modulo
+ * each node on the way down, until a remainder is short enough that the primes
+ * below it are divided into it directly. They leave by the Chinese remainder
+ * theorem, as the sum of c_i M/p_i for c_i = x_i (M/p_i)^-1 mod p_i, summed up
+ * the same tree: each node sums those of its children, each times the product
+ * of the other. The inverses are found once per basis, from the cofactors
+ * M/p_i, reduced modulo each node on the way down.
+ *
+ * Remainder trees also serve any list of moduli of one bitfield, such as the
+ * small primes of trial division. Consecutive moduli are packed into groups
+ * whose product fits one bitfield, and the groups are the leaves. Each group
+ * is divided into the remainder at its leaf, and the moduli of the group
+ * into that remainder of one bitfield, so n moduli cost a few divisions of
+ * large integers and about n divisions of single bitfields. */
+
+// ---- Constants ----
+
+// Size of remainder, in bitfields, at which leaves below it are divided into it directly
+#define LEAF_BITFLDS    16
+
+// Largest prime of bases chosen by size, and bits each prime of them holds, at least
+#define PRIME_MAX       0x7fffffffu
+#define PRIME_BITS      30
+
+// Largest # of primes in a basis
+#define PRIME_CT_MAX    ((size_t) 1 << 26)
+
+// ---- Types ----
+
+// Product tree, level by level from leaves, each one bitfield, to their product
+typedef struct {
+    dwhl_t *nodes;
+    size_t *lvl, levels;        // Offset of each level within nodes, ending in # of nodes
+} ptree_t;
+
+struct dwhl_rns_basis {
+    size_t n;
+    uint32_t *p, *pinv, *crt;   // Primes, -1/p mod 2^32, and (M/p)^-1 mod p
+    ptree_t tree;               // Product tree over primes, up to M
+};
+
+struct dwhl_mtree {
+    size_t n, groups;
+    bitfld_t *mods;
+    size_t *first;              // Index of first modulus of each group, ending in n
+    ptree_t tree;               // Product tree over products of groups
+};
+
+// ---- Helper Functions ----
+
+static dwhl_rns_basis_t *basis_new(const uint32_t *, size_t);
+static bool cof_tree(dwhl_rns_basis_t *, const dwhl_t *, size_t, size_t);
+static dwhl_t *crt_tree(const ptree_t *, const uint32_t *, size_t, size_t, dwhl_t *);
+static uint32_t inv_mod(uint32_t, uint32_t);
+static void ptree_clr(ptree_t *);
+static bool ptree_init(ptree_t *, const bitfld_t *, size_t);
+static size_t rem_itch(const ptree_t *, size_t);
+static void rem_tree(const ptree_t *, bitfld_t *, const bitfld_t *, size_t, size_t, size_t, bitfld_t *);
+
+static inline const dwhl_t *node(const ptree_t *, size_t, size_t);
+static inline size_t nodes(const ptree_t *, size_t);
+static inline const dwhl_t *root(const ptree_t *);
+static inline bool same_basis(const dwhl_rns_t *, const dwhl_rns_t *);
+static inline uint32_t to_mont(uint32_t, uint32_t);
+
+/* Returns basis of distinct odd primes below 2^31, building its product tree
+ * Returns NULL and sets errno on internal error */
+dwhl_rns_basis_t *basis_new(const uint32_t *primes, size_t n) {
+    dwhl_rns_basis_t *const basis = calloc(1, sizeof(dwhl_rns_basis_t));
+    bitfld_t *leaves = NULL;
+    bool ok;
+
+    if (!basis)
+        return NULL;
+    basis->n = n;
+    if (!(basis->p = malloc(3 * n * sizeof(uint32_t))) || !(leaves = calloc(n, sizeof(bitfld_t))))
+        goto fail;
+    basis->pinv = basis->p + n;
+    basis->crt = basis->pinv + n;
+    memcpy(basis->p, primes, n * sizeof(uint32_t));
+    for (size_t i = 0; i < n; ++i)
+        leaves[i] = primes[i];
+    ok = ptree_init(&basis->tree, leaves, n);
+    free(leaves);
+    if (!ok)
+        goto fail;
+
+    // Newton's method doubles correct low bits of inverse, from 3 bits for odd p
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t inv = primes[i];
+
+        for (int j = 0; j < 4; ++j)
+            inv *= 2 - primes[i] * inv;
+        basis->pinv[i] = -inv;
+    }
+    if (!cof_tree(basis, dwhl_one, basis->tree.levels - 1, 0))
+        goto fail;
+    return basis;
+fail:
+    dwhl_rns_basis_free(basis);
+    return NULL;
+}
+
+/* Stores (M/p)^-1 mod p for primes below node, given product of all other primes, reduced modulo node
+ * Returns false and sets errno on internal error */
+bool cof_tree(dwhl_rns_basis_t *basis, const dwhl_t *cof, size_t l, size_t k) {
+    if (!l) {
+        const uint32_t p = basis->p[k];
+
+        basis->crt[k] = inv_mod(ln_mod_1(cof->bits, cof->size, p), p);
+        return true;
+    }
+    const ptree_t *const tree = &basis->tree;
+
+    for (size_t c = 2 * k; c < 2 * k + 2 && c < nodes(tree, l - 1); ++c) {
+        const size_t sib = c ^ 1;
+        dwhl_t sub;
+        bool ok;
+
+        if (!dwhl_initi(&sub, cof))
+            return false;
+        ok = (sib >= nodes(tree, l - 1) || dwhl_muleq(&sub, node(tree, l - 1, sib)))
+          && dwhl_modeq(&sub, node(tree, l - 1, c)) && cof_tree(basis, &sub, l - 1, c);
+        dwhl_clr(&sub);
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+/* Assigns sum of c_i (product at node / p_i), for primes below node, to tar
+ * Returns NULL and sets errno on internal error */
+dwhl_t *crt_tree(const ptree_t *tree, const uint32_t *cp, size_t l, size_t k, dwhl_t *tar) {
+    if (!l)
+        return dwhl_equ(tar, cp[k]);
+    if (2 * k + 1 >= nodes(tree, l - 1))
+        return crt_tree(tree, cp, l - 1, 2 * k, tar);
+
+    dwhl_t rhs;
+    dwhl_t *tmp = NULL;
+
+    if (!dwhl_initu(&rhs, 0))
+        return NULL;
+    if (crt_tree(tree, cp, l - 1, 2 * k, tar) && crt_tree(tree, cp, l - 1, 2 * k + 1, &rhs)
+      && dwhl_muleq(tar, node(tree, l - 1, 2 * k + 1)))
+        tmp = dwhl_addmuleq(tar, &rhs, node(tree, l - 1, 2 * k));
+    dwhl_clr(&rhs);
+    return tmp;
+}
+
+// Returns inverse of a modulo prime p, by Fermat's little theorem; requires a coprime to p
+uint32_t inv_mod(uint32_t a, uint32_t p) {
+    uint64_t base = a % p, inv = 1;
+
+    for (uint32_t e = p - 2; e; e >>= 1) {
+        if (e & 1)
+            inv = inv * base % p;
+        base = base * base % p;
+    }
+    return (uint32_t) inv;
+}
+
+// Returns node k of level l of product tree
+const dwhl_t *node(const ptree_t *tree, size_t l, size_t k) {
+    return &tree->nodes[tree->lvl[l] + k];
+}
+
+// Returns # of nodes in level l of product tree
+size_t nodes(const ptree_t *tree, size_t l) {
+    return tree->lvl[l + 1] - tree->lvl[l];
+}
+
+// Frees product tree, whether or not it was fully built
+void ptree_clr(ptree_t *tree) {
+    if (tree->nodes) {
+        for (size_t i = 0; tree->lvl && i < tree->lvl[tree->levels]; ++i)
+            dwhl_clr(&tree->nodes[i]);
+    }
+    free(tree->nodes);
+    free(tree->lvl);
+}
+
+/* Builds product tree over n > 0 nonzero leaves
+ * Returns false and sets errno on internal error, leaving tree to be freed by `ptree_clr()' */
+bool ptree_init(ptree_t *tree, const bitfld_t *leaves, size_t n) {
+    size_t levels = 1, ct = n;
+
+    for (size_t m = n; m > 1; m = (m + 1) / 2, ct += m)
+        ++levels;
+    tree->levels = levels;
+    tree->lvl = NULL;
+    if (!(tree->nodes = calloc(ct, sizeof(dwhl_t))) || !(tree->lvl = malloc((levels + 1) * sizeof(size_t))))
+        return false;
+
+    // Each node is the product of the two below it, or a copy of the last if it has no sibling
+    tree->lvl[0] = 0;
+    for (size_t l = 0, m = n; l < levels; ++l, m = (m + 1) / 2)
+        tree->lvl[l + 1] = tree->lvl[l] + m;
+    for (size_t i = 0; i < n; ++i) {
+        if (!dwhl_initu(&tree->nodes[i], leaves[i]))
+            return false;
+    }
+    for (size_t l = 1; l < levels; ++l) {
+        for (size_t k = 0; k < nodes(tree, l); ++k) {
+            dwhl_t *const tar = &tree->nodes[tree->lvl[l] + k];
+
+            if (!dwhl_initi(tar, node(tree, l - 1, 2 * k)))
+                return false;
+            if (2 * k + 1 < nodes(tree, l - 1) && !dwhl_muleq(tar, node(tree, l - 1, 2 * k + 1)))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Temporary space for `rem_tree()' from root, on x of xn bitfields
+size_t rem_itch(const ptree_t *tree, size_t xn) {
+    const dwhl_t *const top = root(tree);
+
+    // Each level holds a remainder no longer than the node above it, halving on the way down
+    return 4 * (xn + 2 * top->size + tree->levels);
+}
+
+/* Stores x mod each leaf below node in rem, for x of xn bitfields, normalized
+ * tp holds `rem_itch()' bitfields */
+void rem_tree(const ptree_t *tree, bitfld_t *rem, const bitfld_t *xp, size_t xn, size_t l, size_t k, bitfld_t *tp) {
+    if (!l || xn <= LEAF_BITFLDS) {
+        const size_t lo = k << l, hi = (k + 1) << l < nodes(tree, 0) ? (k + 1) << l : nodes(tree, 0);
+
+        for (size_t i = lo; i < hi; ++i)
+            rem[i] = ln_mod_1(xp, xn, node(tree, 0, i)->bits[0]);
+        return;
+    }
+
+    // Quotient is dropped once the remainder is found, leaving its space to the levels below
+    for (size_t c = 2 * k; c < 2 * k + 2 && c < nodes(tree, l - 1); ++c) {
+        const dwhl_t *const div = node(tree, l - 1, c);
+        const size_t dn = ln_norm(div->bits, div->size);
+        bitfld_t *const np = tp, *const qp = np + xn;
+
+        if (xn < dn) {
+            rem_tree(tree, rem, xp, xn, l - 1, c, tp);
+            continue;
+        }
+        memcpy(np, xp, xn * sizeof(bitfld_t));
+        ln_divrem(qp, np, xn, div->bits, dn, qp + xn - dn + 1);
+        rem_tree(tree, rem, np, ln_norm(np, dn), l - 1, c, qp);
+    }
+}
+
+// Returns root of product tree, the product of its leaves
+const dwhl_t *root(const ptree_t *tree) {
+    return node(tree, tree->levels - 1, 0);
+}
+
+// Returns true if both residues are of one basis, otherwise setting errno to EINVAL
+bool same_basis(const dwhl_rns_t *lhs, const dwhl_rns_t *rhs) {
+    if (lhs->basis == rhs->basis)
+        return true;
+    errno = EINVAL;
+    return false;
+}
+
+// Returns x 2^32 mod p
+uint32_t to_mont(uint32_t x, uint32_t p) {
+    return (uint32_t) (((uint64_t) x << 32) % p);
+}
+
+// ---- Residue Number Systems ----
+
+export dwhl_rns_basis_t *dwhl_rns_basis_new(size_t bits) {
+    uint32_t *primes;
+    dwhl_rns_basis_t *tmp;
+    size_t n;
+
+    // Basis too large; bits is tested before the sum, which wraps at SIZE_MAX
+    if (bits / PRIME_BITS >= PRIME_CT_MAX || (n = (bits + 1) / PRIME_BITS + 1) > PRIME_CT_MAX) {
+        errno = ERANGE;
+        return NULL;
+    }
+    if (!(primes = malloc(n * sizeof(uint32_t))))
+        return NULL;
+
+    // Largest primes, each above 2^PRIME_BITS, so their product is above 2^(bits + 1)
+    for (size_t i = 0; i < n; ++i) {
+        bitfld_t cand = i ? primes[i - 1] - 2 : PRIME_MAX;
+
+        while (dwhl_probab_prime(&(const dwhl_t) {&cand, 1, false, NULL}, 0) != 2)
+            cand -= 2;
+
+        // Primes above 2^PRIME_BITS exhausted, about 5.07e7 of them
+        if (cand <= (bitfld_t) 1 << PRIME_BITS) {
+            free(primes);
+            errno = ERANGE;
+            return NULL;
+        }
+        primes[i] = (uint32_t) cand;
+    }
+    tmp = basis_new(primes, n);
+    free(primes);
+    return tmp;
+}
+export dwhl_rns_basis_t *dwhl_rns_basis_newp(const uint32_t *primes, size_t n) {
+    if (!primes || !n || n > PRIME_CT_MAX) {
+        errno = EINVAL;
+        return NULL;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        bitfld_t cand = primes[i];
+
+        if (cand > PRIME_MAX || !(cand & 1) || dwhl_probab_prime(&(const dwhl_t) {&cand, 1, false, NULL}, 0) != 2) {
+            errno = EDOM;
+            return NULL;
+        }
+    }
+
+    // Repeated primes share a factor with their cofactors, which then have no inverse
+    dwhl_rns_basis_t *const basis = basis_new(primes, n);
+
+    for (size_t i = 0; basis && i < n; ++i) {
+        if (!basis->crt[i]) {
+            dwhl_rns_basis_free(basis);
+            errno = EDOM;
+            return NULL;
+        }
+    }
+    return basis;
+}
+export void dwhl_rns_basis_free(dwhl_rns_basis_t *basis) {
+    if (!basis)
+        return;
+    ptree_clr(&basis->tree);
+    free(basis->p);
+    free(basis);
+}
+export const dwhl_t *dwhl_rns_basis_mod(const dwhl_rns_basis_t *basis) {
+    if (!basis) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return root(&basis->tree);
+}
+export size_t dwhl_rns_basis_size(const dwhl_rns_basis_t *basis) {
+    if (!basis) {
+        errno = EINVAL;
+        return 0;
+    }
+    return basis->n;
+}
+
+export dwhl_rns_t *dwhl_rns_init(dwhl_rns_t *tar, const dwhl_rns_basis_t *basis) {
+    if (!tar || !basis) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (!(tar->res = calloc(basis->n, sizeof(uint32_t))))
+        return NULL;
+    tar->basis = basis;
+    return tar;
+}
+export void dwhl_rns_clr(dwhl_rns_t *tar) {
+    if (tar)
+        free(tar->res);
+}
+
+export dwhl_rns_t *dwhl_rns_eqi(dwhl_rns_t *tar, const dwhl_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    const dwhl_rns_basis_t *const basis = tar->basis;
+    const dwhl_t *const mod = root(&basis->tree);
+    dwhl_t rem;
+    bitfld_t *rp = NULL;
+
+    // Least nonnegative residue modulo M
+    if (!dwhl_initi(&rem, val))
+        return NULL;
+    if (dwhl_modeq(&rem, mod) && (!dwhl_isneg(&rem) || dwhl_addeq(&rem, mod))
+      && (rp = malloc((basis->n + rem.size + rem_itch(&basis->tree, rem.size)) * sizeof(bitfld_t)))) {
+        bitfld_t *const xp = rp + basis->n;
+
+        rem_tree(&basis->tree, rp, xp, get_abs(xp, &rem), basis->tree.levels - 1, 0, xp + rem.size);
+        for (size_t i = 0; i < basis->n; ++i)
+            tar->res[i] = to_mont((uint32_t) rp[i], basis->p[i]);
+    }
+    dwhl_clr(&rem);
+    free(rp);
+    return rp ? tar : NULL;
+}
+export dwhl_t *dwhl_rns_get(dwhl_t *tar, const dwhl_rns_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+
+    const dwhl_rns_basis_t *const basis = val->basis;
+    const size_t n = basis->n;
+    uint32_t *const cp = malloc(n * sizeof(uint32_t));
+    dwhl_t *tmp;
+
+    if (!cp)
+        return NULL;
+
+    // Montgomery product of x_i 2^32 and (M/p)^-1 is c_i in ordinary form
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t t = (uint64_t) val->res[i] * basis->crt[i];
+        const uint32_t m = (uint32_t) t * basis->pinv[i], p = basis->p[i],
+          u = (uint32_t) ((t + (uint64_t) m * p) >> 32);
+
+        cp[i] = u >= p ? u - p : u;
+    }
+    tmp = crt_tree(&basis->tree, cp, basis->tree.levels - 1, 0, tar);
+    free(cp);
+    return tmp ? dwhl_modeq(tar, root(&basis->tree)) : NULL;
+}
+export dwhl_t *dwhl_rns_gets(dwhl_t *tar, const dwhl_rns_t *val) {
+    if (!dwhl_rns_get(tar, val))
+        return NULL;
+
+    // Residues above M/2 are read as negative
+    const dwhl_t *const mod = root(&val->basis->tree);
+    dwhl_t half;
+    dwhl_t *tmp = tar;
+
+    if (!dwhl_initi(&half, mod))
+        return NULL;
+    if (!dwhl_rshifteq(&half, 1))
+        tmp = NULL;
+    else if (dwhl_cmp(tar, &half) > 0)
+        tmp = dwhl_subeq(tar, mod);
+    dwhl_clr(&half);
+    return tmp;
+}
+
+export dwhl_rns_t *dwhl_rns_addeq(dwhl_rns_t *tar, const dwhl_rns_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (!same_basis(tar, val))
+        return NULL;
+
+    const uint32_t *const pp = tar->basis->p;
+
+    for (size_t i = 0, n = tar->basis->n; i < n; ++i) {
+        const uint32_t s = tar->res[i] + val->res[i];
+
+        tar->res[i] = s >= pp[i] ? s - pp[i] : s;
+    }
+    return tar;
+}
+export dwhl_rns_t *dwhl_rns_muleq(dwhl_rns_t *tar, const dwhl_rns_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (!same_basis(tar, val))
+        return NULL;
+
+    const uint32_t *const pp = tar->basis->p, *const pinv = tar->basis->pinv;
+
+    // t + mp < 2^62 + 2^63, and the reduced product is below 2p
+    for (size_t i = 0, n = tar->basis->n; i < n; ++i) {
+        const uint64_t t = (uint64_t) tar->res[i] * val->res[i];
+        const uint32_t m = (uint32_t) t * pinv[i], u = (uint32_t) ((t + (uint64_t) m * pp[i]) >> 32);
+
+        tar->res[i] = u >= pp[i] ? u - pp[i] : u;
+    }
+    return tar;
+}
+export dwhl_rns_t *dwhl_rns_negeq(dwhl_rns_t *tar) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    const uint32_t *const pp = tar->basis->p;
+
+    for (size_t i = 0, n = tar->basis->n; i < n; ++i)
+        tar->res[i] = tar->res[i] ? pp[i] - tar->res[i] : 0;
+    return tar;
+}
+export dwhl_rns_t *dwhl_rns_subeq(dwhl_rns_t *tar, const dwhl_rns_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (!same_basis(tar, val))
+        return NULL;
+
+    const uint32_t *const pp = tar->basis->p;
+
+    for (size_t i = 0, n = tar->basis->n; i < n; ++i) {
+        const uint32_t a = tar->res[i], b = val->res[i];
+
+        tar->res[i] = a - b + (a < b ? pp[i] : 0);
+    }
+    return tar;
+}
+
+// ---- Remainder Trees ----
+
+export dwhl_mtree_t *dwhl_mtree_new(const bitfld_t *moduli, size_t n) {
+    if (!moduli || !n) {
+        errno = EINVAL;
+        return NULL;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (!moduli[i]) {
+            errno = EDOM;
+            return NULL;
+        }
+    }
+
+    dwhl_mtree_t *const tree = calloc(1, sizeof(dwhl_mtree_t));
+    bitfld_t *leaves = NULL;
+    size_t g = 0;
+
+    if (!tree)
+        return NULL;
+    tree->n = n;
+    if (!(tree->mods = malloc(n * sizeof(bitfld_t))) || !(tree->first = malloc((n + 1) * sizeof(size_t)))
+      || !(leaves = malloc(n * sizeof(bitfld_t))))
+        goto fail;
+    memcpy(tree->mods, moduli, n * sizeof(bitfld_t));
+
+    // Each group takes moduli while their product fits one bitfield
+    for (size_t i = 0; i < n; ++g) {
+        dbitfld_t prod = moduli[i];
+
+        tree->first[g] = i;
+        while (++i < n && (prod * moduli[i]) >> BITFLD_BITS == 0)
+            prod *= moduli[i];
+        leaves[g] = (bitfld_t) prod;
+    }
+    tree->first[g] = n;
+    tree->groups = g;
+    if (!ptree_init(&tree->tree, leaves, g))
+        goto fail;
+    free(leaves);
+    return tree;
+fail:
+    free(leaves);
+    dwhl_mtree_free(tree);
+    return NULL;
+}
+export void dwhl_mtree_free(dwhl_mtree_t *tree) {
+    if (!tree)
+        return;
+    ptree_clr(&tree->tree);
+    free(tree->mods);
+    free(tree->first);
+    free(tree);
+}
+export bitfld_t *dwhl_mtree_mod(const dwhl_mtree_t *tree, const dwhl_t *val, bitfld_t *out) {
+    if (!tree || !val || !out) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    const bool neg = dwhl_isneg(val);
+    bitfld_t *const rp = malloc((tree->groups + val->size + rem_itch(&tree->tree, val->size)) * sizeof(bitfld_t)),
+      *const xp = rp + tree->groups;
+
+    if (!rp)
+        return NULL;
+
+    // Residues of |val| modulo each group, then each modulus; those of val < 0 are negated
+    rem_tree(&tree->tree, rp, xp, get_abs(xp, val), tree->tree.levels - 1, 0, xp + val->size);
+    for (size_t g = 0; g < tree->groups; ++g) {
+        for (size_t i = tree->first[g]; i < tree->first[g + 1]; ++i) {
+            const bitfld_t r = rp[g] % tree->mods[i];
+
+            out[i] = neg && r ? tree->mods[i] - r : r;
+        }
+    }
+    free(rp);
+    return out;
+}
+
+export bitfld_t *dwhl_mod_multi(const dwhl_t *val, const bitfld_t *moduli, size_t n, bitfld_t *out) {
+    if (!val || !out) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    dwhl_mtree_t *const tree = dwhl_mtree_new(moduli, n);
+    bitfld_t *tmp;
+
+    if (!tree)
+        return NULL;
+    tmp = dwhl_mtree_mod(tree, val, out);
+    dwhl_mtree_free(tree);
+    return tmp;
+}
@@ -0,0 +1,415 @@
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#define PREFIX  dwhl
+
+/* Integer roots
+ *
+ * The floor k-th root is found by Newton iteration from above, doubling
+ * precision at each level: the root of the top half of the operand, rounded
+ * up and scaled back, seeds Newton steps at full precision. Once the root
+ * fits within ROOT_SEED_BITS, a `floatp_t' estimate seeds the iteration
+ * instead. Each level costs about one division and two powers at its own
+ * precision, so the top level dominates. */
+
+// ---- Constants ----
+
+// Largest root, in bits, estimated directly in floating point
+#define ROOT_SEED_BITS  48
+
+// Quadratic residues modulo 64, 63, 65, and 11, as bitmasks
+#define SQ_RES_64   0x0202021202030213
+#define SQ_RES_63   0x0402483012450293
+#define SQ_RES_65   0x218a019866014613  // Residue 64 is omitted
+#define SQ_RES_11   0x23b
+
+// # of primes p = 1 (mod k) used to reject k-th powers
+#define POW_FILTER_PRIMES   3
+
+// ---- Helper Functions ----
+
+static size_t bit_len(const bitfld_t *, size_t);
+static int cmp_sz(const bitfld_t *, size_t, const bitfld_t *, size_t);
+static size_t level_itch(size_t);
+static size_t newton_step(bitfld_t *, const bitfld_t *, size_t, const bitfld_t *, size_t, unsigned long, size_t, bitfld_t *);
+static size_t pow_ui(bitfld_t *, const bitfld_t *, size_t, unsigned long, size_t, bitfld_t *);
+static size_t root_rec(bitfld_t *, const bitfld_t *, size_t, unsigned long, size_t *, bitfld_t *);
+static size_t root_seed(bitfld_t *, const bitfld_t *, size_t, unsigned long, size_t *, bitfld_t *);
+static size_t shl_bits(bitfld_t *, size_t, size_t);
+static size_t shr_bits(bitfld_t *, const bitfld_t *, size_t, size_t);
+static bool pow_filter(const bitfld_t *, size_t, unsigned long);
+static bool sq_filter(const bitfld_t *, size_t);
+
+// Returns # of significant bits in normalized, nonzero buffer
+size_t bit_len(const bitfld_t *ap, size_t an) {
+    return an * BITFLD_BITS - bitfld_clz(ap[an - 1]);
+}
+
+// Compares normalized buffers of any size, returning -1, 0, or 1
+int cmp_sz(const bitfld_t *ap, size_t an, const bitfld_t *bp, size_t bn) {
+    if (an != bn)
+        return an < bn ? -1 : 1;
+    return ln_cmp(ap, bp, an);
+}
+
+/* Temporary space for one level of `root_rec()' on operand of an bitfields
+ * Powers of roots near the true root never exceed 3an bitfields */
+size_t level_itch(size_t an) {
+    const size_t w = 3 * an + 8, mul = ln_mul_itch(w, w), sqr = ln_sqr_itch(w);
+
+    return 6 * w + (mul > sqr ? mul : sqr);
+}
+
+/* Stores one Newton step towards k-th root of a from x, floor(((k - 1)x + a/x^(k - 1))/k), in yp
+ * yp holds xn + 2 bitfields; powers hold up to w bitfields */
+size_t newton_step(bitfld_t *yp, const bitfld_t *xp, size_t xn, const bitfld_t *ap, size_t an,
+  unsigned long k, size_t w, bitfld_t *tp) {
+    bitfld_t *pp = tp, *qp = tp + w, *np = qp + w, *ts = np + w;
+    const bitfld_t *dp = xp;
+    size_t dn = xn, qn = 0, yn;
+
+    if (k > 2) {
+        dn = pow_ui(pp, xp, xn, k - 1, w, ts);
+        dp = pp;
+    }
+    if (an >= dn) {
+        memcpy(np, ap, an * sizeof(bitfld_t));
+        ln_divrem(qp, np, an, dp, dn, ts);
+        qn = ln_norm(qp, an - dn + 1);
+    }
+    yp[xn] = ln_mul_1(yp, xp, xn, k - 1);
+    yn = ln_norm(yp, xn + 1);
+    if (qn > yn) {
+        yp[qn] = ln_add(yp, qp, qn, yp, yn);
+        yn = qn + 1;
+    } else {
+        yp[yn] = ln_add(yp, yp, yn, qp, qn);
+        ++yn;
+    }
+    yn = ln_norm(yp, yn);
+    if (k == 2)
+        ln_rshift(yp, yp, yn, 1);
+    else
+        ln_divrem_1(yp, yp, yn, k);
+    return ln_norm(yp, yn);
+}
+
+/* Stores b^e in rp, returning its size; e must be nonzero
+ * rp and tp each hold w bitfields, with temporary space for multiplication following tp */
+size_t pow_ui(bitfld_t *rp, const bitfld_t *bp, size_t bn, unsigned long e, size_t w, bitfld_t *tp) {
+    bitfld_t *cur = rp, *next = tp, *swp, *ts = tp + w;
+    size_t n = bn;
+
+    memcpy(cur, bp, bn * sizeof(bitfld_t));
+    for (unsigned bit = sizeof(unsigned long) * 8 - 1 - __builtin_clzl(e); bit--;) {
+        ln_sqr(next, cur, n, ts);
+        n = ln_norm(next, 2 * n);
+        swp = cur, cur = next, next = swp;
+        if (e >> bit & 1) {
+            ln_mul(next, cur, n, bp, bn, ts);
+            n = ln_norm(next, n + bn);
+            swp = cur, cur = next, next = swp;
+        }
+    }
+    if (cur != rp)
+        memcpy(rp, cur, n * sizeof(bitfld_t));
+    return n;
+}
+
+/* Stores floor k-th root of a in rp, returning its size
+ * Leaves k-th power of root in first *pn bitfields of tp */
+size_t root_rec(bitfld_t *rp, const bitfld_t *ap, size_t an, unsigned long k, size_t *pn, bitfld_t *tp) {
+    const size_t b = bit_len(ap, an), R = (b - 1) / k + 1, w = 3 * an + 8;
+
+    if (R <= ROOT_SEED_BITS)
+        return root_seed(rp, ap, an, k, pn, tp);
+
+    /* Root of a / 2^kj is floor(root / 2^j), so rounding it up
+     * and scaling by 2^j gives a starting point above the root */
+    const size_t j = R - R / 2 - 1, sn = shr_bits(tp, ap, an, k * j);
+    bitfld_t *yp = tp + w, *ts = tp + 2 * w;
+    size_t rn = root_rec(rp, tp, sn, k, pn, tp + sn), yn;
+
+    rp[rn] = ln_add_1(rp, rp, rn, 1);
+    rn = shl_bits(rp, rn + 1, j);
+
+    // Newton iteration from above never passes the root, so stop at first x^k <= a
+    for (;;) {
+        yn = newton_step(yp, rp, rn, ap, an, k, w, ts);
+        memcpy(rp, yp, yn * sizeof(bitfld_t));
+        rn = yn;
+        *pn = pow_ui(tp, rp, rn, k, w, ts);
+        if (cmp_sz(tp, *pn, ap, an) <= 0)
+            return rn;
+    }
+}
+
+/* As above, for roots of at most ROOT_SEED_BITS bits
+ * Estimate from `floatp_t' is off by at most a few units */
+size_t root_seed(bitfld_t *rp, const bitfld_t *ap, size_t an, unsigned long k, size_t *pn, bitfld_t *tp) {
+    const size_t b = bit_len(ap, an), e = b > BITFLD_BITS ? b - BITFLD_BITS : 0,
+      at = e / BITFLD_BITS, w = 3 * an + 8;
+    const unsigned shift = e % BITFLD_BITS;
+    const bitfld_t top = ap[at] >> shift | (shift && at + 1 < an ? ap[at + 1] << (BITFLD_BITS - shift) : 0);
+    bitfld_t *pp = tp, *qp = tp + w, *ts = tp + 2 * w, x;
+    size_t qn;
+
+    // a^(1/k) = 2^(e/k) top^(1/k) = 2^floor(e/k) (top 2^(e mod k))^(1/k)
+    const floatp_t est = ldexpl(exp2l((log2l((floatp_t) top) + (floatp_t) (e % k)) / k), (int) (e / k));
+
+    x = est < 1 ? 1 : (bitfld_t) est;
+    *pn = pow_ui(pp, &x, 1, k, w, ts);
+    if (cmp_sz(pp, *pn, ap, an) > 0) {
+        do {
+            --x;
+            *pn = pow_ui(pp, &x, 1, k, w, ts);
+        } while (cmp_sz(pp, *pn, ap, an) > 0);
+    } else {
+        for (;;) {
+            ++x;
+            qn = pow_ui(qp, &x, 1, k, w, ts);
+            if (cmp_sz(qp, qn, ap, an) > 0)
+                break;
+            memcpy(pp, qp, qn * sizeof(bitfld_t));
+            *pn = qn;
+        }
+        --x;
+    }
+    rp[0] = x;
+    return 1;
+}
+
+/* Shifts buffer left in place by any # of bits, returning normalized size
+ * Buffer holds n + cnt/BITFLD_BITS + 1 bitfields */
+size_t shl_bits(bitfld_t *ap, size_t n, size_t cnt) {
+    const size_t limbs = cnt / BITFLD_BITS;
+    const unsigned bits = cnt % BITFLD_BITS;
+
+    if (bits) {
+        ap[n] = ln_lshift(ap, ap, n, bits);
+        ++n;
+    }
+    if (limbs) {
+        memmove(ap + limbs, ap, n * sizeof(bitfld_t));
+        memset(ap, 0, limbs * sizeof(bitfld_t));
+    }
+    return ln_norm(ap, n + limbs);
+}
+
+/* Stores buffer shifted right by any # of bits in dst, returning normalized size
+ * dst may equal src */
+size_t shr_bits(bitfld_t *dst, const bitfld_t *src, size_t n, size_t cnt) {
+    const size_t limbs = cnt / BITFLD_BITS;
+    const unsigned bits = cnt % BITFLD_BITS;
+
+    if (limbs >= n)
+        return 0;
+    n -= limbs;
+    if (bits)
+        ln_rshift(dst, src + limbs, n, bits);
+    else
+        memmove(dst, src + limbs, n * sizeof(bitfld_t));
+    return ln_norm(dst, n);
+}
+
+/* Returns false if buffer cannot be a k-th power, for odd prime k
+ * Modulo prime p = jk + 1, only one residue in k is a k-th power, so
+ * each such p rejects all but about 1/k of non-powers */
+bool pow_filter(const bitfld_t *ap, size_t an, unsigned long k) {
+    unsigned found = 0;
+
+    for (bitfld_t p = 2 * (bitfld_t) k + 1; p >> 32 == 0 && found < POW_FILTER_PRIMES; p += 2 * k) {
+        bool prime = true;
+
+        for (bitfld_t d = 3; d * d <= p && prime; d += 2)
+            prime = p % d;
+        if (!prime)
+            continue;
+        ++found;
+
+        // Euler's criterion, generalized: r is a k-th power iff r^((p - 1)/k) = 1
+        bitfld_t r = ln_mod_1(ap, an, p), x = 1;
+
+        if (!r)
+            continue;
+        for (bitfld_t e = (p - 1) / k; e; e >>= 1) {
+            if (e & 1)
+                x = x * r % p;
+            r = r * r % p;
+        }
+        if (x != 1)
+            return false;
+    }
+    return true;
+}
+
+// Returns false if buffer cannot be a perfect square, judging by small residues
+bool sq_filter(const bitfld_t *ap, size_t an) {
+    if (!(SQ_RES_64 >> (ap[0] % 64) & 1))
+        return false;
+
+    // 63 * 65 * 11 = 45045; reduce once, then test each factor
+    const bitfld_t r = ln_mod_1(ap, an, 45045), r65 = r % 65;
+
+    return SQ_RES_63 >> (r % 63) & 1 && (r65 == 64 || SQ_RES_65 >> r65 & 1) && SQ_RES_11 >> (r % 11) & 1;
+}
+
+// ---- Limb Kernels ----
+
+size_t ln_rootrem_itch(size_t an, unsigned long k) {
+    (void) k;
+    return level_itch(an) + 3 * an + 8;   // Shifted operands of deeper levels shrink geometrically
+}
+size_t ln_rootrem(bitfld_t *rp, bitfld_t *remp, size_t *remn, const bitfld_t *ap, size_t an,
+  unsigned long k, bitfld_t *tp) {
+    size_t rn, pn;
+
+    if (k >= bit_len(ap, an)) {     // 2^k > a, so root is 1
+        rp[0] = 1;
+        rn = 1;
+        pn = 1;
+        tp[0] = 1;
+    } else
+        rn = root_rec(rp, ap, an, k, &pn, tp);
+    if (remp) {
+        ln_sub(remp, ap, an, tp, pn);
+        *remn = ln_norm(remp, an);
+    }
+    return rn;
+}
+
+// ---- Roots ----
+
+export dwhl_t *dwhl_rootrem(dwhl_t *root, dwhl_t *rem, const dwhl_t *val, unsigned long n) {
+    if (!root || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(root);
+    if (rem)
+        assert_lval(rem);
+
+    const bool neg = last_fld(val) & SIGN_BIT;
+
+    if (!n || (neg && !(n & 1))) {
+        errno = EDOM;
+        return NULL;
+    }
+
+    const size_t size = val->size, rsize = size / n + 3;
+    bitfld_t *ap = malloc((2 * size + rsize + ln_rootrem_itch(size, n)) * sizeof(bitfld_t)),
+      *remp = ap + size, *rp = remp + size, *tp = rp + rsize;
+    size_t an, rn = 0, remn = 0;
+    dwhl_t *tmp = root;
+
+    if (!ap)
+        return NULL;
+    an = get_abs(ap, val);
+    if (an && n == 1) {
+        memcpy(rp, ap, an * sizeof(bitfld_t));
+        rn = an;
+    } else if (an)
+        rn = ln_rootrem(rp, remp, &remn, ap, an, n, tp);
+    if (rem && !set_abs(rem, remp, remn, neg))
+        tmp = NULL;
+    if (!set_abs(root, rp, rn, neg))
+        tmp = NULL;
+    free(ap);
+    return tmp;
+}
+export dwhl_t *dwhl_sqrtrem(dwhl_t *root, dwhl_t *rem, const dwhl_t *val) {
+    return dwhl_rootrem(root, rem, val, 2);
+}
+
+export dwhl_t *dwhl_rooteq(dwhl_t *tar, unsigned long n) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return dwhl_rootrem(tar, NULL, tar, n);
+}
+export dwhl_t *dwhl_sqrteq(dwhl_t *tar) {
+    return dwhl_rooteq(tar, 2);
+}
+
+export dwhl_t *dwhl_root(const dwhl_t *val, unsigned long n) { BUILD_SHIFT(root, val, n); }
+export dwhl_t *dwhl_sqrt(const dwhl_t *val)                 { BUILD_UNARY(sqrt, val);    }
+
+export dwhl_t *dwhl_root_take(dwhl_t *val, unsigned long n) { BUILD_SHIFT_TAKE(root, val, n); }
+export dwhl_t *dwhl_sqrt_take(dwhl_t *val)                  { BUILD_UNARY_TAKE(sqrt, val);    }
+
+export bool dwhl_issquare(const dwhl_t *val) {
+    if (!val) {
+        errno = EINVAL;
+        return false;
+    }
+
+    const size_t size = val->size, rsize = size / 2 + 3;
+    bitfld_t *ap;
+    size_t an, remn;
+    bool tmp = false;
+
+    if (last_fld(val) & SIGN_BIT)
+        goto cleanup;
+    if (!(ap = malloc((2 * size + rsize + ln_rootrem_itch(size, 2)) * sizeof(bitfld_t))))
+        goto cleanup;
+    if (!(an = get_abs(ap, val)))
+        tmp = true;
+    else if (sq_filter(ap, an)) {
+        ln_rootrem(ap + 2 * size, ap + size, &remn, ap, an, 2, ap + 2 * size + rsize);
+        tmp = !remn;
+    }
+    free(ap);
+cleanup:
+    return tmp;
+}
+export bool dwhl_isperfpow(const dwhl_t *val) {
+    if (!val) {
+        errno = EINVAL;
+        return false;
+    }
+
+    const bool neg = last_fld(val) & SIGN_BIT;
+    const size_t size = val->size, rsize = size / 2 + 3;
+    bitfld_t *ap = malloc((2 * size + rsize + ln_rootrem_itch(size, 2)) * sizeof(bitfld_t)),
+      *remp = ap + size, *rp = remp + size, *tp = rp + rsize;
+    size_t an, b, twos = 0, remn;
+    bool tmp = true;
+
+    if (!ap)
+        return false;
+    an = get_abs(ap, val);
+    if (!an || (an == 1 && ap[0] == 1))     // 0, 1, and -1 are powers of themselves
+        goto cleanup;
+
+    // A k-th power has a multiple of k trailing zeros, unless odd
+    while (!ap[twos / BITFLD_BITS])
+        twos += BITFLD_BITS;
+    twos += bitfld_ctz(ap[twos / BITFLD_BITS]);
+    b = bit_len(ap, an);
+
+    // Only prime exponents need testing, since a^(pq) = (a^p)^q
+    for (unsigned long k = neg ? 3 : 2; k <= b; ++k) {
+        bool prime = true;
+
+        for (unsigned long d = 2; d * d <= k && prime; ++d)
+            prime = k % d;
+        if (!prime || (twos && twos % k) || (k == 2 ? !sq_filter(ap, an) : !pow_filter(ap, an, k)))
+            continue;
+        ln_rootrem(rp, remp, &remn, ap, an, k, tp);
+        if (!remn)
+            goto cleanup;
+    }
+    tmp = false;
+cleanup:
+    free(ap);
+    return tmp;
+}
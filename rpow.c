@@ -0,0 +1,326 @@
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#define PREFIX  dwhl
+
+/* Radix powers
+ *
+ * Conversion and decimal scaling need base^k for many k. Every k is reached as
+ * base^(k mod d) times the powers base^(d 2^i) picked out by the bits of k / d,
+ * so a cache of one power per bit of k / d, each the square of the last,
+ * serves every exponent with O(log k) full multiplications.
+ *
+ * Powers are built outside the lock of their cache, then published under it;
+ * if two threads build the same power, the first to publish wins. A published
+ * power is never modified, and is freed only once it is evicted and its last
+ * reference is released, so readers need no lock while they hold one.
+ *
+ * The lock is a spinlock, held only to find, count, or unlink powers, so that
+ * threads need not link against pthreads. */
+
+// ---- Constants ----
+
+// Largest radix whose powers are cached
+#define RADIX_MAX   36
+
+// # of powers cached per radix; power i holds about 2^i bitfields
+#define RPOW_LEVELS (sizeof(size_t) * 8)
+
+// Cached power, reached through its value
+typedef struct {
+    dwhl_t val;                 // First, so references convert back to the power
+    dwhl_rpow_cache_t *cache;   // Cache holding power
+    size_t refs;                // # of references held by callers
+    uint_least64_t used;        // Tick of cache when last referenced
+    bool linked;                // Power is reachable through its cache
+} rpow_t;
+
+struct dwhl_rpow_cache {
+    atomic_flag lock;
+    rpow_t *slots[RADIX_MAX - 1][RPOW_LEVELS];
+    size_t bytes, limit;        // Memory held by powers, and limit on it
+    dwhl_rpow_policy_t policy;
+    uint_least64_t tick;        // Counts references, ordering powers by last use
+};
+
+// Cache used when none is given
+static dwhl_rpow_cache_t global = {ATOMIC_FLAG_INIT, {{NULL}}, 0, RPOW_LIMIT, RP_LRU, 0};
+
+// ---- Helper Functions ----
+
+static rpow_t *acquire(dwhl_rpow_cache_t *, unsigned, unsigned);
+static rpow_t *build(unsigned, unsigned, dwhl_rpow_cache_t *);
+static unsigned digits(unsigned, bitfld_t *);
+static void evict(dwhl_rpow_cache_t *, size_t);
+static void release(rpow_t *);
+
+static inline void lock(dwhl_rpow_cache_t *);
+static inline void unlock(dwhl_rpow_cache_t *);
+
+/* Returns power i of radix, counting a reference to it, building it if not cached
+ * Returns NULL and sets errno on internal error */
+rpow_t *acquire(dwhl_rpow_cache_t *cache, unsigned base, unsigned i) {
+    rpow_t **const slot = &cache->slots[base - 2][i], *pow, *tmp;
+
+    lock(cache);
+    if ((pow = *slot)) {
+        ++pow->refs;
+        pow->used = ++cache->tick;
+    }
+    unlock(cache);
+    if (pow || !(tmp = build(base, i, cache)))
+        return pow;
+
+    // Another thread may have published the same power meanwhile
+    const size_t bytes = tmp->val.size * sizeof(bitfld_t);
+
+    lock(cache);
+    if ((pow = *slot)) {
+        ++pow->refs;
+        pow->used = ++cache->tick;
+    } else {
+        if (cache->policy == RP_LRU)
+            evict(cache, bytes);
+        if (bytes <= cache->limit && cache->bytes <= cache->limit - bytes) {
+            *slot = tmp;
+            tmp->linked = true;
+            cache->bytes += bytes;
+        }
+        tmp->used = ++cache->tick;
+        pow = tmp;
+        tmp = NULL;
+    }
+    unlock(cache);
+    if (tmp) {
+        free(tmp->val.bits);
+        free(tmp);
+    }
+    return pow;
+}
+
+/* Returns unlinked power i of radix, holding one reference, squaring power below it
+ * Returns NULL and sets errno on internal error */
+rpow_t *build(unsigned base, unsigned i, dwhl_rpow_cache_t *cache) {
+    rpow_t *const pow = malloc(sizeof(rpow_t)), *below = NULL;
+    bitfld_t *rp = NULL, big;
+
+    if (!pow)
+        return NULL;
+    *pow = (rpow_t) {{NULL, 0, false, NULL}, cache, 1, 0, false};
+    digits(base, &big);
+    if (!i) {
+        if (!set_abs(&pow->val, &big, 1, false))
+            goto fail;
+        return pow;
+    }
+    if (!(below = acquire(cache, base, i - 1)))
+        goto fail;
+
+    const size_t n = ln_norm(below->val.bits, below->val.size);
+
+    if (2 * n > BITFLD_CT_MAX) {    // Integer too large
+        errno = ERANGE;
+        goto fail;
+    }
+    if (!(rp = malloc((2 * n + ln_sqr_itch(n)) * sizeof(bitfld_t))))
+        goto fail;
+    ln_sqr(rp, below->val.bits, n, rp + 2 * n);
+    if (!set_abs(&pow->val, rp, 2 * n, false))
+        goto fail;
+    free(rp);
+    release(below);
+    return pow;
+fail:
+    if (below)
+        release(below);
+    free(rp);
+    free(pow->val.bits);
+    free(pow);
+    return NULL;
+}
+
+/* Returns d, the # of digits of radix fitting one bitfield, storing base^d in *big
+ * Requires radix from 2 to 36 */
+unsigned digits(unsigned base, bitfld_t *big) {
+    unsigned d = 1;
+
+    for (*big = base; *big <= BITFLD_MAX / base; ++d)
+        *big *= base;
+    return d;
+}
+
+/* Frees least recently used powers no longer referenced, until `bytes' more fit the limit
+ * Requires lock of cache */
+void evict(dwhl_rpow_cache_t *cache, size_t bytes) {
+    while (bytes > cache->limit || cache->bytes > cache->limit - bytes) {
+        rpow_t **lru = NULL;
+
+        for (size_t b = 0; b < RADIX_MAX - 1; ++b) {
+            for (size_t i = 0; i < RPOW_LEVELS; ++i) {
+                rpow_t *const pow = cache->slots[b][i];
+
+                if (pow && !pow->refs && (!lru || pow->used < (*lru)->used))
+                    lru = &cache->slots[b][i];
+            }
+        }
+        if (!lru)
+            return;
+        cache->bytes -= (*lru)->val.size * sizeof(bitfld_t);
+        free((*lru)->val.bits);
+        free(*lru);
+        *lru = NULL;
+    }
+}
+
+// Acquires lock of cache
+void lock(dwhl_rpow_cache_t *cache) {
+    while (atomic_flag_test_and_set_explicit(&cache->lock, memory_order_acquire))
+        ;
+}
+
+// Releases reference to power, freeing it if evicted and no longer referenced
+void release(rpow_t *pow) {
+    dwhl_rpow_cache_t *const cache = pow->cache;
+    bool dead;
+
+    lock(cache);
+    dead = !--pow->refs && !pow->linked;
+    unlock(cache);
+    if (dead) {
+        free(pow->val.bits);
+        free(pow);
+    }
+}
+
+// Releases lock of cache
+void unlock(dwhl_rpow_cache_t *cache) {
+    atomic_flag_clear_explicit(&cache->lock, memory_order_release);
+}
+
+size_t rpow_get(bitfld_t *rp, unsigned base, size_t k, dwhl_rpow_cache_t *cache) {
+    bitfld_t big, *tp = NULL;
+    const unsigned d = digits(base, &big);
+    const size_t cap = rpow_size(base, k);
+    size_t n = 1, q = k / d;
+
+    if (!cache)
+        cache = &global;
+    rp[0] = 1;
+    for (k %= d; k; --k)
+        rp[0] *= base;
+    if (q & 1) {
+        rp[n] = ln_mul_1(rp, rp, n, big);
+        n += rp[n] != 0;
+    }
+    for (unsigned i = 1; q >>= 1; ++i) {
+        if (!(q & 1))
+            continue;
+
+        rpow_t *const pow = acquire(cache, base, i);
+        size_t m;
+
+        if (!pow || (!tp && !(tp = malloc((cap + 1 + ln_mul_itch(cap, cap)) * sizeof(bitfld_t))))) {
+            if (pow)
+                release(pow);
+            free(tp);
+            return 0;
+        }
+        m = ln_norm(pow->val.bits, pow->val.size);
+        ln_mul(tp, rp, n, pow->val.bits, m, tp + cap + 1);
+        release(pow);
+        n = ln_norm(tp, n + m);
+        memcpy(rp, tp, n * sizeof(bitfld_t));
+    }
+    free(tp);
+    return n;
+}
+
+size_t rpow_size(unsigned base, size_t k) {
+    bitfld_t big;
+
+    // base^(d q) < 2^(BITFLD_BITS q), and base^(k mod d) fits one more bitfield
+    return k / digits(base, &big) + 1;
+}
+
+// ---- Radix Powers ----
+
+export dwhl_rpow_cache_t *dwhl_rpow_cache_new(size_t limit, dwhl_rpow_policy_t policy) {
+    dwhl_rpow_cache_t *const cache = calloc(1, sizeof(dwhl_rpow_cache_t));
+
+    if (!cache)
+        return NULL;
+    atomic_flag_clear(&cache->lock);
+    cache->limit = limit;
+    cache->policy = policy;
+    return cache;
+}
+export void dwhl_rpow_cache_free(dwhl_rpow_cache_t *cache) {
+    if (!cache || cache == &global)
+        return;
+    for (size_t b = 0; b < RADIX_MAX - 1; ++b) {
+        for (size_t i = 0; i < RPOW_LEVELS; ++i) {
+            if (cache->slots[b][i]) {
+                free(cache->slots[b][i]->val.bits);
+                free(cache->slots[b][i]);
+            }
+        }
+    }
+    free(cache);
+}
+export void dwhl_rpow_config(dwhl_rpow_cache_t *cache, size_t limit, dwhl_rpow_policy_t policy) {
+    if (!cache)
+        cache = &global;
+    lock(cache);
+    cache->limit = limit;
+    cache->policy = policy;
+    if (policy == RP_LRU)
+        evict(cache, 0);
+    unlock(cache);
+}
+export unsigned dwhl_rpow_digits(unsigned base) {
+    bitfld_t big;
+
+    if (base < 2 || base > RADIX_MAX) {
+        errno = EINVAL;
+        return 0;
+    }
+    return digits(base, &big);
+}
+export const dwhl_t *dwhl_rpow_get(dwhl_ctx_t *ctx, unsigned base, unsigned i) {
+    const int saved = errno;
+    rpow_t *pow;
+
+    if (base < 2 || base > RADIX_MAX || i >= RPOW_LEVELS) {
+        if (ctx)
+            ctx->err = EINVAL;
+        else
+            errno = EINVAL;
+        return NULL;
+    }
+    errno = 0;
+    if (!(pow = acquire(ctx && ctx->rpow ? ctx->rpow : &global, base, i))) {
+        const int err = errno ? errno : ENOMEM;
+
+        if (ctx) {
+            ctx->err = err;
+            errno = saved;
+        } else
+            errno = err;
+        return NULL;
+    }
+    errno = saved;
+    return &pow->val;
+}
+export void dwhl_rpow_put(const dwhl_t *pow) {
+    if (pow)
+        release((rpow_t *) pow);
+}
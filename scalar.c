@@ -0,0 +1,351 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#define PREFIX  dwhl
+
+/* Arithmetic with machine-integer operands
+ *
+ * The operand is applied to the low bitfield with a single-bitfield kernel,
+ * and its sign extension to the rest of the integer, in two's complement and
+ * in place. No temporaries are allocated; the bit buffer only grows when the
+ * result needs another bitfield.
+ *
+ * Every operation yields `ext', the bitfield that follows the result's top
+ * bitfield in infinite precision, which `put_top()' appends if needed. */
+
+// ---- Helper Functions ----
+
+static dwhl_t *add_1(dwhl_t *, bitfld_t, bool);
+static dwhl_t *bitwise_1(dwhl_t *, bitfld_t, char);
+static dwhl_t *div_1(dwhl_t *, bitfld_t, bool, bool);
+static dwhl_t *divexact_1(dwhl_t *, bitfld_t, bool);
+static dwhl_t *mul_1(dwhl_t *, bitfld_t, bool);
+static void neg_n(bitfld_t *, size_t);
+
+// Adds or subtracts bitfield in place
+dwhl_t *add_1(dwhl_t *tar, bitfld_t val, bool sub) {
+    const bitfld_t ext = sign_ext(tar), carry = sub
+      ? ln_sub_1(tar->bits, tar->bits, tar->size, val)
+      : ln_add_1(tar->bits, tar->bits, tar->size, val);
+    const bitfld_t top = sub ? ext - carry : ext + carry;
+
+    return put_top(tar, top, top & SIGN_BIT);
+}
+
+/* Applies bitwise operation ('&', '|', or '^') with sign-extended `integr_t' in place
+ * Low bitfield of operand is `val'; the rest are its sign */
+dwhl_t *bitwise_1(dwhl_t *tar, bitfld_t val, char op) {
+    const bitfld_t fill = val & SIGN_BIT ? BITFLD_MAX : 0;
+    bitfld_t ext = sign_ext(tar);
+
+    switch (op) {
+    case '&':
+        tar->bits[0] &= val;
+        if (!fill)
+            memset(tar->bits + 1, 0, (tar->size - 1) * sizeof(bitfld_t));
+        ext &= fill;
+        break;
+    case '|':
+        tar->bits[0] |= val;
+        if (fill)
+            memset(tar->bits + 1, 0xff, (tar->size - 1) * sizeof(bitfld_t));
+        ext |= fill;
+        break;
+    case '^':
+        tar->bits[0] ^= val;
+        if (fill) {
+            for (size_t i = 1; i < tar->size; ++i)
+                tar->bits[i] = ~tar->bits[i];
+        }
+        ext ^= fill;
+        break;
+    }
+    return put_top(tar, ext, ext);
+}
+
+/* Divides by nonzero bitfield in place, truncating, storing quotient or remainder
+ * Quotient takes sign of integer, flipped if `flip'; remainder takes sign of integer */
+dwhl_t *div_1(dwhl_t *tar, bitfld_t val, bool flip, bool rem) {
+    const bool neg = last_fld(tar) & SIGN_BIT;
+    bitfld_t r;
+
+    if (!val) {
+        errno = EDOM;
+        return NULL;
+    }
+
+    // Magnitude fits the same # of bitfields, read as unsigned
+    if (neg)
+        neg_n(tar->bits, tar->size);
+    r = ln_divrem_1(tar->bits, tar->bits, tar->size, val);
+    if (rem)
+        return set_abs(tar, &r, 1, neg);
+    if (neg ^ flip) {
+        neg_n(tar->bits, tar->size);
+        return tar;
+    }
+    return put_top(tar, 0, false);  // Quotient of most negative integer by 1 needs a sign bitfield
+}
+
+/* Divides by nonzero bitfield dividing integer exactly, in place
+ * Quotient takes sign of integer, flipped if `flip' */
+dwhl_t *divexact_1(dwhl_t *tar, bitfld_t val, bool flip) {
+    const bool neg = last_fld(tar) & SIGN_BIT;
+
+    if (!val) {
+        errno = EDOM;
+        return NULL;
+    }
+    if (neg)
+        neg_n(tar->bits, tar->size);
+    assert_exact(!ln_mod_1(tar->bits, tar->size, val), tar);
+    ln_divexact_1(tar->bits, tar->bits, tar->size, val);
+    if (neg ^ flip) {
+        neg_n(tar->bits, tar->size);
+        return tar;
+    }
+    return put_top(tar, 0, false);
+}
+
+// Multiplies by bitfield in place, negating result if `neg'
+dwhl_t *mul_1(dwhl_t *tar, bitfld_t val, bool neg) {
+    const bool tar_neg = last_fld(tar) & SIGN_BIT;
+    const bitfld_t hi = ln_mul_1(tar->bits, tar->bits, tar->size, val);
+
+    /* Negative integer x of n bitfields reads as x + 2^(BITFLD_BITS n), so product
+     * exceeds true value by val 2^(BITFLD_BITS n), and hi < val */
+    if (!put_top(tar, tar_neg ? hi - val : hi, tar_neg && val))
+        return NULL;
+    if (neg) {
+        const bitfld_t ext = ~sign_ext(tar), carry = !ln_norm(tar->bits, tar->size);
+
+        neg_n(tar->bits, tar->size);
+        return put_top(tar, ext + carry, (ext + carry) & SIGN_BIT);
+    }
+    return tar;
+}
+
+// Negates buffer in two's complement, modulo its size
+void neg_n(bitfld_t *ap, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        ap[i] = ~ap[i];
+    ln_add_1(ap, ap, n, 1);
+}
+
+// ---- Scalar Arithmetic ----
+
+export int dwhl_cmps(const dwhl_t *lhs, integr_t rhs) {
+    if (!lhs) {
+        errno = EINVAL;
+        return 2;
+    }
+
+    const bitfld_t ext = sign_ext(lhs);
+    bool fits = (lhs->bits[0] & SIGN_BIT ? BITFLD_MAX : 0) == ext;
+    int tmp;
+
+    for (size_t i = 1; i < lhs->size && fits; ++i)
+        fits = lhs->bits[i] == ext;
+    if (fits) {
+        const integr_t val = (integr_t) lhs->bits[0];
+
+        tmp = (val > rhs) - (val < rhs);
+    } else
+        tmp = ext ? -1 : 1;
+    return tmp;
+}
+export int dwhl_cmpu(const dwhl_t *lhs, uintegr_t rhs) {
+    if (!lhs) {
+        errno = EINVAL;
+        return 2;
+    }
+
+    int tmp = -1;
+
+    if (!(last_fld(lhs) & SIGN_BIT)) {
+        tmp = ln_norm(lhs->bits, lhs->size) > 1 ? 1 : (lhs->bits[0] > rhs) - (lhs->bits[0] < rhs);
+    }
+    return tmp;
+}
+
+export dwhl_t *dwhl_addeqs(dwhl_t *tar, integr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return val < 0 ? add_1(tar, -(bitfld_t) val, true) : add_1(tar, val, false);
+}
+export dwhl_t *dwhl_addequ(dwhl_t *tar, uintegr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return add_1(tar, val, false);
+}
+export dwhl_t *dwhl_subeqs(dwhl_t *tar, integr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return val < 0 ? add_1(tar, -(bitfld_t) val, false) : add_1(tar, val, true);
+}
+export dwhl_t *dwhl_subequ(dwhl_t *tar, uintegr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return add_1(tar, val, true);
+}
+
+export dwhl_t *dwhl_andeqs(dwhl_t *tar, integr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return bitwise_1(tar, val, '&');
+}
+export dwhl_t *dwhl_andequ(dwhl_t *tar, uintegr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    tar->bits[0] &= val;
+    memset(tar->bits + 1, 0, (tar->size - 1) * sizeof(bitfld_t));
+    return put_top(tar, 0, false);
+}
+export dwhl_t *dwhl_oreqs(dwhl_t *tar, integr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return bitwise_1(tar, val, '|');
+}
+export dwhl_t *dwhl_orequ(dwhl_t *tar, uintegr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+
+    const bitfld_t ext = sign_ext(tar);
+
+    tar->bits[0] |= val;
+    return put_top(tar, ext, ext);
+}
+export dwhl_t *dwhl_xoreqs(dwhl_t *tar, integr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return bitwise_1(tar, val, '^');
+}
+export dwhl_t *dwhl_xorequ(dwhl_t *tar, uintegr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+
+    const bitfld_t ext = sign_ext(tar);
+
+    tar->bits[0] ^= val;
+    return put_top(tar, ext, ext);
+}
+
+export dwhl_t *dwhl_diveqs(dwhl_t *tar, integr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return div_1(tar, val < 0 ? -(bitfld_t) val : (bitfld_t) val, val < 0, false);
+}
+export dwhl_t *dwhl_divequ(dwhl_t *tar, uintegr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return div_1(tar, val, false, false);
+}
+export dwhl_t *dwhl_divexacteqs(dwhl_t *tar, integr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return divexact_1(tar, val < 0 ? -(bitfld_t) val : (bitfld_t) val, val < 0);
+}
+export dwhl_t *dwhl_divexactequ(dwhl_t *tar, uintegr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return divexact_1(tar, val, false);
+}
+export dwhl_t *dwhl_modeqs(dwhl_t *tar, integr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return div_1(tar, val < 0 ? -(bitfld_t) val : (bitfld_t) val, false, true);
+}
+export dwhl_t *dwhl_modequ(dwhl_t *tar, uintegr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return div_1(tar, val, false, true);
+}
+export dwhl_t *dwhl_muleqs(dwhl_t *tar, integr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return mul_1(tar, val < 0 ? -(bitfld_t) val : (bitfld_t) val, val < 0);
+}
+export dwhl_t *dwhl_mulequ(dwhl_t *tar, uintegr_t val) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return mul_1(tar, val, false);
+}
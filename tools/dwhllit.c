@@ -0,0 +1,198 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Converts integer constants to `DWHL_LITERAL' initializers
+ *
+ * Usage: dwhllit [-t table] < constants > constants.h
+ *
+ * Input holds one constant per line, as `name value', where value is decimal, or hexadecimal
+ * with prefix `0x', may be negative, and may contain `_' or `'' between digits. Each constant
+ * becomes a static integer built at compile time:
+ *     static const dwhl_t name = DWHL_LITERAL(...);
+ * With `-t', lines hold values only, which become elements of one array, in order:
+ *     static const dwhl_t table[] = {DWHL_LITERAL(...), ...};
+ * Blank lines and lines starting with `#' are skipped.
+ *
+ * Output is the shortest two's complement form, and is meant to be included at file scope
+ * after `arbitrary.h'. The generator does not link against the library, but needs a compiler
+ * providing `unsigned __int128'. */
+
+// Bitfields printed per line of output
+#define PER_LINE    4
+
+// ---- Helper Functions ----
+
+static bool is_ident(const char *);
+static size_t parse(uint64_t **, const char *);
+static void put(const uint64_t *, size_t, const char *);
+static uint64_t *reserve(uint64_t *, size_t *, size_t);
+
+// Returns true if string is a C identifier
+bool is_ident(const char *str) {
+    if (!isalpha((unsigned char) *str) && *str != '_')
+        return false;
+    while (*++str) {
+        if (!isalnum((unsigned char) *str) && *str != '_')
+            return false;
+    }
+    return true;
+}
+
+/* Converts constant to bitfields in two's complement, least significant first
+ * Stores heap-allocated bitfields in *lp
+ * Returns # of bitfields, or 0 if constant is malformed or memory runs out */
+size_t parse(uint64_t **lp, const char *str) {
+    const bool neg = *str == '-';
+    unsigned base = 10;
+    size_t n = 1, cap = 4;
+    uint64_t *ap = calloc(cap, sizeof(uint64_t));
+    bool digits = false;
+
+    if (!ap)
+        return 0;
+    str += neg;
+    if (str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+        base = 16;
+        str += 2;
+    }
+    for (; *str; ++str) {
+        uint64_t carry;
+
+        if (isdigit((unsigned char) *str))
+            carry = *str - '0';
+        else if (base == 16 && isxdigit((unsigned char) *str))
+            carry = tolower((unsigned char) *str) - 'a' + 10;
+        else if (digits && (*str == '_' || *str == '\'') && str[1])
+            continue;
+        else
+            goto fail;
+        digits = true;
+        for (size_t i = 0; i < n; ++i) {
+            const unsigned __int128 prod = (unsigned __int128) ap[i] * base + carry;
+
+            ap[i] = (uint64_t) prod;
+            carry = (uint64_t) (prod >> 64);
+        }
+        if (carry) {
+            if (!(ap = reserve(ap, &cap, n + 1)))
+                return 0;
+            ap[n++] = carry;
+        }
+    }
+    if (!digits)
+        goto fail;
+
+    // Magnitude takes a clear sign bit before negation
+    if (ap[n - 1] >> 63) {
+        if (!(ap = reserve(ap, &cap, n + 1)))
+            return 0;
+        ap[n++] = 0;
+    }
+    if (neg) {
+        bool carry = true;
+
+        for (size_t i = 0; i < n; ++i) {
+            ap[i] = ~ap[i] + carry;
+            carry = carry && !ap[i];
+        }
+    }
+
+    // Bitfields repeating the sign of the one below are redundant
+    while (n > 1 && ap[n - 1] == (ap[n - 2] >> 63 ? UINT64_MAX : 0))
+        --n;
+    *lp = ap;
+    return n;
+fail:
+    free(ap);
+    return 0;
+}
+
+// Prints initializer of n bitfields, breaking long lists across lines
+void put(const uint64_t *ap, size_t n, const char *indent) {
+    printf("DWHL_LITERAL(");
+    for (size_t i = 0; i < n; ++i) {
+        if (n > PER_LINE && !(i % PER_LINE))
+            printf("\n%s    ", indent);
+        printf("0x%016" PRIx64 "%s", ap[i], i + 1 < n ? (n > PER_LINE && i % PER_LINE == PER_LINE - 1 ? "," : ", ") : "");
+    }
+    printf(n > PER_LINE ? "\n%s)" : ")", indent);
+}
+
+/* Grows buffer of bitfields to hold at least n, clearing new bitfields
+ * Frees buffer and returns NULL if memory runs out */
+uint64_t *reserve(uint64_t *ap, size_t *cap, size_t n) {
+    uint64_t *tmp;
+
+    if (n <= *cap)
+        return ap;
+    if (!(tmp = realloc(ap, 2 * *cap * sizeof(uint64_t)))) {
+        free(ap);
+        return NULL;
+    }
+    memset(tmp + *cap, 0, *cap * sizeof(uint64_t));
+    *cap *= 2;
+    return tmp;
+}
+
+// ---- Main ----
+
+int main(int argc, char **argv) {
+    const char *table = NULL;
+    char *line = NULL;
+    size_t len = 0, at = 0, count = 0;
+
+    if (argc == 3 && !strcmp(argv[1], "-t") && is_ident(argv[2]))
+        table = argv[2];
+    else if (argc != 1) {
+        fprintf(stderr, "usage: %s [-t table] < constants\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    printf("// Generated by dwhllit; do not edit\n\n");
+    while (getline(&line, &len, stdin) != -1) {
+        const char *name = NULL, *value = strtok(line, " \t\r\n");
+        uint64_t *ap;
+        size_t n;
+
+        ++at;
+        if (!value || *value == '#')
+            continue;
+        if (!table) {
+            name = value;
+            value = strtok(NULL, " \t\r\n");
+        }
+        if (!value || strtok(NULL, " \t\r\n") || (name && !is_ident(name)) || !(n = parse(&ap, value))) {
+            fprintf(stderr, "%s: line %zu: malformed constant\n", argv[0], at);
+            free(line);
+            return EXIT_FAILURE;
+        }
+        if (table) {
+            if (count)
+                printf(",\n    ");
+            else
+                printf("static const dwhl_t %s[] = {\n    ", table);
+            put(ap, n, "    ");
+        } else {
+            printf("static const dwhl_t %s = ", name);
+            put(ap, n, "");
+            printf(";\n");
+        }
+        ++count;
+        free(ap);
+    }
+    free(line);
+    if (table) {
+        if (!count) {
+            fprintf(stderr, "%s: table holds no constants\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+        printf("\n};\n");
+    }
+    return EXIT_SUCCESS;
+}
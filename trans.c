@@ -0,0 +1,578 @@
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#if ARBITRARY_THREADS > 1
+#include <pthread.h>
+#endif
+
+#define PREFIX  ddec
+
+/* Transcendental functions
+ *
+ * Series of rational terms are summed by binary splitting: the terms of a range
+ * are combined into one fraction from the fractions of its halves, so a sum of
+ * n terms costs O(log n) levels of full multiplications of balanced operands,
+ * each level as large as the sum, and benefits from every faster multiplication
+ * the integers gain. Halves of large ranges are split on separate threads, up to
+ * ARBITRARY_THREADS of them.
+ *
+ *  e       sum of 1/k!
+ *  exp(x)  product of exp(y_j), squared r times, for x/2^r below 1/2 cut into y_j
+ *  log(x)  log(m) + k ln 2, for x = m 2^k with m near 1
+ *  ln 2    18 atanh(1/26) - 2 atanh(1/4801) + 8 atanh(1/8749)
+ *  pi      Chudnovsky series
+ *
+ * A series for exp(y) in a full-precision y would hold products of as many
+ * full-precision numerators as it has terms. Instead y is cut into pieces y_j
+ * whose bits start where the last ended, each twice as long ("bit-burst"): a
+ * piece with more bits lies closer to 0, and needs fewer terms. log(m) is found
+ * by Newton's method on exp, y + m exp(-y) - 1, doubling the places of each step.
+ *
+ * Sums are carried to GUARD_DIGITS places beyond the scale of the result, then
+ * rounded once, by the rules of the result. Constants are kept at the highest
+ * precision yet requested, and later requests of no more places are rounded
+ * from them. Square roots are exact integer roots, so are rounded exactly. */
+
+// ---- Constants ----
+
+// Decimal places carried beyond scale of result
+#define GUARD_DIGITS    12
+
+// Bits of first piece of argument of exp
+#define BURST_BITS      8
+
+// Places from which logarithms are refined by Newton's method, and steps taken to reach them
+#define NEWTON_PLACES   20
+#define NEWTON_START    8
+
+// ---- Types ----
+
+// Series summed by binary splitting, of exp(u / v), or of atanh(1 / u) with v = u^2
+typedef struct {
+    char kind;          // 'e', 'x' (exp), 'a' (atanh), or 'p' (pi)
+    const dwhl_t *u, *v;
+} series_t;
+
+/* Terms a(n)/b(n) p(0)...p(n)/q(0)...q(n) over a range, as T/(BQ), where P and Q
+ * are products of p and q; B is only kept by atanh, and is 1 otherwise */
+typedef struct {
+    dwhl_t p, q, b, t;
+} split_t;
+
+// Half of range summed by another thread
+typedef struct {
+    const series_t *ser;
+    size_t lo, hi;
+    unsigned threads;
+    split_t res;
+    bool ok;
+    int err;        // errno of thread, if not ok
+} split_job_t;
+
+// Constant kept at highest precision yet requested
+typedef struct {
+    atomic_flag lock;
+    dwhl_t *(*build)(dwhl_t *, size_t);
+    dwhl_t val;     // Coefficient, truncated, at `scale'; no bit buffer until first built
+    size_t scale;
+} cached_t;
+
+// ---- Helper Functions ----
+
+static dwhl_t *atanh_inv(dwhl_t *, bitfld_t, size_t);
+static dwhl_t *build_e(dwhl_t *, size_t);
+static dwhl_t *build_ln2(dwhl_t *, size_t);
+static dwhl_t *build_pi(dwhl_t *, size_t);
+static void clr_split(split_t *);
+static dwhl_t *exp_fix(dwhl_t *, const dwhl_t *, size_t, size_t);
+static dwhl_t *fix_quot(dwhl_t *, dwhl_t *, const dwhl_t *, size_t);
+static dwhl_t *get_const(dwhl_t *, cached_t *, size_t);
+static bool leaf(split_t *, const series_t *, size_t);
+static bool log_step(dwhl_t *, const dwhl_t *, const dwhl_t *, size_t);
+static ddec_t *put_const(ddec_t *, cached_t *);
+static bool split(split_t *, const series_t *, size_t, size_t, bool, unsigned);
+static void *split_worker(void *);
+static size_t terms(size_t, size_t);
+
+static inline void lock(atomic_flag *);
+static inline void unlock(atomic_flag *);
+
+// Cached constants
+static cached_t e_cache   = {ATOMIC_FLAG_INIT, build_e,   {NULL, 0, false, NULL}, 0};
+static cached_t ln2_cache = {ATOMIC_FLAG_INIT, build_ln2, {NULL, 0, false, NULL}, 0};
+static cached_t pi_cache  = {ATOMIC_FLAG_INIT, build_pi,  {NULL, 0, false, NULL}, 0};
+
+/* Assigns atanh(1/k) 10^w, truncated, to uninitialized tar
+ * Returns NULL and sets errno on internal error */
+dwhl_t *atanh_inv(dwhl_t *tar, bitfld_t k, size_t w) {
+    const dwhl_t u = {&k, 1, false, NULL}, v = {(bitfld_t []) {k * k}, 1, false, NULL};
+    const series_t ser = {'a', &u, &v};
+
+    // Each term gains at least 2 floor(log2 k) bits; 10 w / 3 bits exceed w digits
+    const size_t n = w * 10 / 3 / (2 * (bitfld_sig(k) - 1)) + 2;
+    split_t s;
+
+    if (!split(&s, &ser, 0, n, false, ARBITRARY_THREADS))
+        return NULL;
+    *tar = s.t;
+    s.t = (dwhl_t) {NULL, 0, false, NULL};
+
+    const bool ok = dwhl_muleq(&s.b, &s.q) && fix_quot(tar, tar, &s.b, w);
+
+    clr_split(&s);
+    if (!ok)
+        dwhl_clr(tar);
+    return ok ? tar : NULL;
+}
+
+// Assigns e 10^w, truncated, to uninitialized tar
+dwhl_t *build_e(dwhl_t *tar, size_t w) {
+    const series_t ser = {'e', NULL, NULL};
+    split_t s;
+
+    if (!split(&s, &ser, 0, terms(w * 10 / 3, 0), false, ARBITRARY_THREADS))
+        return NULL;
+    *tar = s.t;
+    s.t = (dwhl_t) {NULL, 0, false, NULL};
+    if (!fix_quot(tar, tar, &s.q, w)) {
+        clr_split(&s);
+        dwhl_clr(tar);
+        return NULL;
+    }
+    clr_split(&s);
+    return tar;
+}
+
+/* Assigns ln 2 10^w, truncated, to uninitialized tar
+ * Each atanh is short of its value by less than 1; two more places absorb the sum of errors */
+dwhl_t *build_ln2(dwhl_t *tar, size_t w) {
+    dwhl_t a = {NULL, 0, false, NULL}, b = {NULL, 0, false, NULL};
+    bool ok = atanh_inv(tar, 26, w + 2) && atanh_inv(&a, 4801, w + 2) && atanh_inv(&b, 8749, w + 2)
+      && dwhl_mulequ(tar, 18) && dwhl_mulequ(&a, 2) && dwhl_mulequ(&b, 8)
+      && dwhl_subeq(tar, &a) && dwhl_addeq(tar, &b) && div_pow10(tar, tar, 2, AF_NULL, NULL);
+
+    dwhl_clr(&a);
+    dwhl_clr(&b);
+    if (!ok)
+        dwhl_clr(tar);
+    return ok ? tar : NULL;
+}
+
+/* Assigns pi 10^w, truncated, to uninitialized tar
+ * pi = 426880 sqrt(10005) Q / T, with sqrt(10005) truncated at w places */
+dwhl_t *build_pi(dwhl_t *tar, size_t w) {
+    const series_t ser = {'p', NULL, NULL};
+    split_t s;
+
+    // Each term gains over 14 digits
+    if (!split(&s, &ser, 0, w / 14 + 2, false, ARBITRARY_THREADS))
+        return NULL;
+
+    const bool ok = dwhl_initu(tar, 10005) && mul_pow10(tar, 2 * w, NULL) && dwhl_sqrteq(tar)
+      && dwhl_mulequ(tar, 426880) && dwhl_muleq(tar, &s.q) && dwhl_diveq(tar, &s.t);
+
+    clr_split(&s);
+    if (!ok)
+        dwhl_clr(tar);
+    return ok ? tar : NULL;
+}
+
+// Frees partial sums of range
+void clr_split(split_t *s) {
+    dwhl_clr(&s->p);
+    dwhl_clr(&s->q);
+    dwhl_clr(&s->b);
+    dwhl_clr(&s->t);
+}
+
+/* Assigns exp(x 10^-s) 10^w, truncated, to uninitialized tar, short by a few units at most
+ * Returns NULL and sets errno to ERANGE if result is too large, or on internal error */
+dwhl_t *exp_fix(dwhl_t *tar, const dwhl_t *x, size_t s, size_t w) {
+    const bool neg = dwhl_isneg(x);
+    dwhl_t z = {NULL, 0, false, NULL}, u = {NULL, 0, false, NULL}, v = {NULL, 0, false, NULL}, f = {NULL, 0, false, NULL};
+    bool ok;
+
+    *tar = (dwhl_t) {NULL, 0, false, NULL};
+    if (!dwhl_initu(&v, 1) || !mul_pow10(&v, s, NULL)) {
+        dwhl_clr(&v);
+        return NULL;
+    }
+
+    // |x| < 2^(xb - vb + 1), so y = x/2^r is below 1/2
+    const size_t xb = dwhl_cmpu(x, 0) ? dwhl_sizeinbase(x, 2) : 0, vb = dwhl_sizeinbase(&v, 2);
+    const size_t r = xb + 2 > vb ? xb + 2 - vb : 0;
+
+    if (r >= BITFLD_BITS - 2) {     // Result too large, or too small to hold in working precision
+        dwhl_clr(&v);
+        errno = ERANGE;
+        return NULL;
+    }
+
+    /* Squaring r times multiplies relative error by 2^r, and a result as large as e^x
+     * holds up to x log10(e) < 2^(r - 1) digits before the point */
+    const size_t ww = w + r * 3 / 10 + 1 + (neg || !r ? 0 : (size_t) 1 << (r - 1)), bits = ww * 10 / 3 + r + 8;
+
+    // |y| is z/2^bits, truncated
+    ok = dwhl_initi(&z, x) && dwhl_abseq(&z) && dwhl_lshifteq(&z, bits - r) && dwhl_diveq(&z, &v)
+      && dwhl_initu(&f, 1) && mul_pow10(&f, ww, NULL);
+    dwhl_clr(&v);
+    v = (dwhl_t) {NULL, 0, false, NULL};
+
+    // Piece from bit `lo' to bit `hi' below the point lies below 2^-lo
+    for (size_t lo = 0, hi = BURST_BITS; ok && lo < bits; lo = hi, hi *= 2) {
+        if (hi > bits)
+            hi = bits;
+        ok = dwhl_initi(&u, &z) && dwhl_rshifteq(&u, bits - hi) && dwhl_initi(&v, &u)
+          && dwhl_rshifteq(&v, hi - lo) && dwhl_lshifteq(&v, hi - lo) && dwhl_subeq(&u, &v);
+        dwhl_clr(&v);
+        v = (dwhl_t) {NULL, 0, false, NULL};
+        if (ok && dwhl_cmpu(&u, 0)) {
+            const series_t ser = {'x', &u, &v};
+            split_t sp;
+
+            ok = (!neg || dwhl_negeq(&u)) && dwhl_initu(&v, 1) && dwhl_lshifteq(&v, hi)
+              && split(&sp, &ser, 0, terms(bits, lo ? lo : 1), false, ARBITRARY_THREADS);
+            dwhl_clr(&v);
+            v = (dwhl_t) {NULL, 0, false, NULL};
+            if (ok) {
+                ok = fix_quot(&sp.t, &sp.t, &sp.q, ww) && dwhl_muleq(&f, &sp.t) && div_pow10(&f, &f, ww, AF_NULL, NULL);
+                clr_split(&sp);
+            }
+        }
+        dwhl_clr(&u);
+        u = (dwhl_t) {NULL, 0, false, NULL};
+    }
+    dwhl_clr(&z);
+    for (size_t i = 0; i < r && ok; ++i)
+        ok = dwhl_muleq(&f, &f) && div_pow10(&f, &f, ww, AF_NULL, NULL);
+    if (ok && div_pow10(&f, &f, ww - w, AF_NULL, NULL)) {
+        *tar = f;
+        return tar;
+    }
+    dwhl_clr(&f);
+    return NULL;
+}
+
+/* Assigns num 10^w / den, truncated, to tar; num is destroyed, and may be tar
+ * Returns NULL and sets errno on internal error */
+dwhl_t *fix_quot(dwhl_t *tar, dwhl_t *num, const dwhl_t *den, size_t w) {
+    if (!mul_pow10(num, w, NULL) || !dwhl_diveq(num, den))
+        return NULL;
+    return tar == num ? tar : dwhl_eq(tar, num);
+}
+
+/* Assigns constant 10^w, truncated, to uninitialized tar, building and caching it
+ * unless cached to at least w places
+ * Returns NULL and sets errno on internal error */
+dwhl_t *get_const(dwhl_t *tar, cached_t *c, size_t w) {
+    size_t scale = w;
+    bool hit, ok = true;
+
+    *tar = (dwhl_t) {NULL, 0, false, NULL};
+    lock(&c->lock);
+    if ((hit = c->val.bits && c->scale >= w)) {
+        ok = dwhl_initi(tar, &c->val);
+        scale = c->scale;
+    }
+    unlock(&c->lock);
+    if (!ok || (!hit && !c->build(tar, w))) {
+        *tar = (dwhl_t) {NULL, 0, false, NULL};
+        return NULL;
+    }
+    if (!hit) {
+        dwhl_t cpy;
+
+        // Copy is published unless another thread has built more places meanwhile
+        if (dwhl_initi(&cpy, tar)) {
+            lock(&c->lock);
+            if (!c->val.bits || c->scale < w) {
+                dwhl_swp(&cpy, &c->val);
+                c->scale = w;
+            }
+            unlock(&c->lock);
+        }
+        dwhl_clr(&cpy);
+    }
+    if (!div_pow10(tar, tar, scale - w, AF_NULL, NULL)) {
+        dwhl_clr(tar);
+        *tar = (dwhl_t) {NULL, 0, false, NULL};
+        return NULL;
+    }
+    return tar;
+}
+
+/* Stores term n of series as a range of its own
+ * Returns false and sets errno on internal error */
+bool leaf(split_t *res, const series_t *ser, size_t n) {
+    bool ok = true;
+
+    *res = (split_t) {{NULL, 0, false, NULL}, {NULL, 0, false, NULL}, {NULL, 0, false, NULL}, {NULL, 0, false, NULL}};
+    switch (ser->kind) {
+    case 'e':   // p(n) = 1, q(n) = n
+        ok = dwhl_initu(&res->p, 1) && dwhl_initu(&res->q, n ? n : 1);
+        break;
+    case 'x':   // p(n) = u, q(n) = n v
+        if (n)
+            ok = dwhl_initi(&res->p, ser->u) && dwhl_initi(&res->q, ser->v) && dwhl_mulequ(&res->q, n);
+        else
+            ok = dwhl_initu(&res->p, 1) && dwhl_initu(&res->q, 1);
+        break;
+    case 'a':   // p(n) = 1, q(n) = v, b(n) = 2n + 1; q(0) = u
+        ok = dwhl_initu(&res->p, 1) && dwhl_initi(&res->q, n ? ser->v : ser->u) && dwhl_initu(&res->b, 2 * n + 1);
+        break;
+    case 'p':   // p(n) = -(6n - 5)(2n - 1)(6n - 1), q(n) = n^3 640320^3 / 24, a(n) = 13591409 + 545140134 n
+        if (n) {
+            ok = dwhl_initu(&res->p, 6 * n - 5) && dwhl_mulequ(&res->p, 2 * n - 1) && dwhl_mulequ(&res->p, 6 * n - 1)
+              && dwhl_negeq(&res->p) && dwhl_initu(&res->q, n) && dwhl_mulequ(&res->q, n) && dwhl_mulequ(&res->q, n)
+              && dwhl_mulequ(&res->q, 10939058860032000);
+        } else
+            ok = dwhl_initu(&res->p, 1) && dwhl_initu(&res->q, 1);
+        break;
+    }
+    ok = ok && dwhl_initi(&res->t, &res->p) && (ser->kind != 'p' || dwhl_mulequ(&res->t, 13591409 + 545140134 * n));
+    if (!ok)
+        clr_split(res);
+    return ok;
+}
+
+/* Takes one step of Newton's method toward log(a/b) from y 10^-p, to y + (a/b) exp(-y) - 1
+ * Returns false and sets errno on internal error */
+bool log_step(dwhl_t *y, const dwhl_t *a, const dwhl_t *b, size_t p) {
+    dwhl_t e = {NULL, 0, false, NULL}, m = {NULL, 0, false, NULL};
+    bool ok;
+
+    ok = dwhl_initi(&m, y) && dwhl_negeq(&m) && exp_fix(&e, &m, p, p);
+    dwhl_clr(&m);
+    m = (dwhl_t) {NULL, 0, false, NULL};
+    ok = ok && dwhl_initi(&m, a) && fix_quot(&m, &m, b, p) && dwhl_muleq(&e, &m) && div_pow10(&e, &e, p, AF_NULL, NULL)
+      && dwhl_addeq(y, &e) && dwhl_equ(&m, 1) && mul_pow10(&m, p, NULL) && dwhl_subeq(y, &m);
+    dwhl_clr(&e);
+    dwhl_clr(&m);
+    return ok;
+}
+
+/* Assigns constant to tar at its scale, rounded by its rules
+ * Returns NULL and sets errno on internal error */
+ddec_t *put_const(ddec_t *tar, cached_t *c) {
+    dwhl_t val;
+    dwhl_t *tmp;
+
+    if (!get_const(&val, c, tar->scale + GUARD_DIGITS))
+        return NULL;
+    tmp = div_pow10(&tar->coef, &val, GUARD_DIGITS, tar->rules, NULL);
+    dwhl_clr(&val);
+    return tmp ? tar : NULL;
+}
+
+/* Sums terms lo to hi - 1 of series into res, splitting halves across up to `threads' threads
+ * P of the range is only completed if `need_p'
+ * Returns false and sets errno on internal error */
+bool split(split_t *res, const series_t *ser, size_t lo, size_t hi, bool need_p, unsigned threads) {
+    if (hi - lo == 1)
+        return leaf(res, ser, lo);
+
+    const size_t mid = lo + (hi - lo) / 2;
+    const bool has_b = ser->kind == 'a';
+    split_job_t left = {ser, lo, mid, threads / 2,
+      {{NULL, 0, false, NULL}, {NULL, 0, false, NULL}, {NULL, 0, false, NULL}, {NULL, 0, false, NULL}}, false, 0};
+    split_t right;
+    bool ok;
+
+#if ARBITRARY_THREADS > 1
+    // Left half runs on a new thread, or here if none can be started
+    pthread_t id;
+    const bool spawned = threads > 1 && hi - lo >= SERIES_THREAD_THRESHOLD
+      && !pthread_create(&id, NULL, split_worker, &left);
+
+    ok = split(&right, ser, mid, hi, need_p, spawned ? threads - threads / 2 : 1);
+    if (spawned)
+        pthread_join(id, NULL);
+    else
+        split_worker(&left);
+#else
+    ok = split(&right, ser, mid, hi, need_p, 1);
+    split_worker(&left);
+#endif
+    if (!ok || !left.ok) {
+        if (ok)
+            clr_split(&right);
+        if (left.ok)
+            clr_split(&left.res);
+        else
+            errno = left.err;
+        return false;
+    }
+
+    // T = B2 Q2 T1 + B1 P1 T2, P = P1 P2, Q = Q1 Q2, B = B1 B2
+    split_t *const l = &left.res;
+
+    ok = dwhl_muleq(&l->t, &right.q) && (!has_b || dwhl_muleq(&l->t, &right.b))
+      && dwhl_muleq(&right.t, &l->p) && (!has_b || dwhl_muleq(&right.t, &l->b))
+      && dwhl_addeq(&l->t, &right.t) && dwhl_muleq(&l->q, &right.q)
+      && (!has_b || dwhl_muleq(&l->b, &right.b)) && (!need_p || dwhl_muleq(&l->p, &right.p));
+    clr_split(&right);
+    if (!ok) {
+        clr_split(l);
+        return false;
+    }
+    *res = *l;
+    return true;
+}
+
+// Sums range of job
+void *split_worker(void *arg) {
+    split_job_t *const job = arg;
+
+    errno = 0;
+    job->ok = split(&job->res, job->ser, job->lo, job->hi, true, job->threads ? job->threads : 1);
+    job->err = errno ? errno : ENOMEM;
+    return NULL;
+}
+
+/* Returns # of terms of a series whose term n is below 2^-(gain n) / n!, for sum to fall
+ * within 2^-bits; log2 n! is bounded below by the sum of floor(log2 k) */
+size_t terms(size_t bits, size_t gain) {
+    size_t n = 0, acc = 0;
+
+    while (acc < bits + 2)
+        acc += gain + bitfld_sig(++n) - 1;
+    return n + 1;
+}
+
+// Acquires spinlock
+void lock(atomic_flag *flag) {
+    while (atomic_flag_test_and_set_explicit(flag, memory_order_acquire))
+        ;
+}
+
+// Releases spinlock
+void unlock(atomic_flag *flag) {
+    atomic_flag_clear_explicit(flag, memory_order_release);
+}
+
+// ---- Constants ----
+
+export ddec_t *ddec_eqe(ddec_t *tar) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return put_const(tar, &e_cache);
+}
+export ddec_t *ddec_eqln2(ddec_t *tar) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return put_const(tar, &ln2_cache);
+}
+export ddec_t *ddec_eqpi(ddec_t *tar) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return put_const(tar, &pi_cache);
+}
+
+// ---- Transcendental Functions ----
+
+export ddec_t *ddec_expeq(ddec_t *tar) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    dwhl_t t;
+    bool ok;
+
+    // Result is positive even where it falls below working precision
+    ok = exp_fix(&t, &tar->coef, tar->scale, tar->scale + GUARD_DIGITS) && (dwhl_cmpu(&t, 0) || dwhl_addequ(&t, 1))
+      && div_pow10(&tar->coef, &t, GUARD_DIGITS, tar->rules, NULL);
+    dwhl_clr(&t);
+    return ok ? tar : NULL;
+}
+export ddec_t *ddec_logeq(ddec_t *tar) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (dwhl_cmpu(&tar->coef, 0) <= 0) {
+        errno = EDOM;
+        return NULL;
+    }
+
+    dwhl_t a = {NULL, 0, false, NULL}, b = {NULL, 0, false, NULL}, y = {NULL, 0, false, NULL}, ln2 = {NULL, 0, false, NULL};
+    size_t places[BITFLD_BITS], n = 0;
+    bool ok;
+
+    if (!dwhl_initi(&a, &tar->coef) || !dwhl_initu(&b, 1) || !mul_pow10(&b, tar->scale, NULL)) {
+        dwhl_clr(&a);
+        dwhl_clr(&b);
+        return NULL;
+    }
+
+    // x = m 2^k for m = a/b from 1/2 to 2
+    const size_t ab = dwhl_sizeinbase(&a, 2), bb = dwhl_sizeinbase(&b, 2);
+    const integr_t k = ab > bb ? (integr_t) (ab - bb) : -(integr_t) (bb - ab);
+
+    /* Error of ln 2 is multiplied by |k|, which has at most 20 digits
+     * Each step of Newton's method squares the error of the last, less 2 places */
+    for (size_t p = tar->scale + GUARD_DIGITS + 20; ; p = p / 2 + 2) {
+        places[n++] = p;
+        if (p <= NEWTON_PLACES)
+            break;
+    }
+    ok = (k < 0 ? dwhl_lshifteq(&a, -k) : dwhl_lshifteq(&b, k)) && dwhl_initu(&y, 0);
+    for (size_t i = 0; i < NEWTON_START && ok; ++i)
+        ok = log_step(&y, &a, &b, places[n - 1]);
+    while (--n && ok)
+        ok = mul_pow10(&y, places[n - 1] - places[n], NULL) && log_step(&y, &a, &b, places[n - 1]);
+    dwhl_clr(&a);
+    dwhl_clr(&b);
+    ok = ok && (!k || (get_const(&ln2, &ln2_cache, places[0]) && dwhl_muleqs(&ln2, k) && dwhl_addeq(&y, &ln2)))
+      && div_pow10(&tar->coef, &y, places[0] - tar->scale, tar->rules, NULL);
+    dwhl_clr(&ln2);
+    dwhl_clr(&y);
+    return ok ? tar : NULL;
+}
+export ddec_t *ddec_sqrteq(ddec_t *tar) {
+    if (!tar) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (dwhl_isneg(&tar->coef)) {
+        errno = EDOM;
+        return NULL;
+    }
+
+    // sqrt(c 10^-s) 10^s = sqrt(c 10^s), an integer root whose remainder decides rounding
+    dwhl_t rem;
+    bool ok, up = false;
+
+    if (!dwhl_initu(&rem, 0))
+        return NULL;
+    ok = mul_pow10(&tar->coef, tar->scale, NULL) && dwhl_sqrtrem(&tar->coef, &rem, &tar->coef);
+    if (ok) {
+        switch (tar->rules) {
+        case AF_ROUND:  // (q + 1/2)^2 = q^2 + q + 1/4, so remainder above q rounds up
+            up = dwhl_cmp(&rem, &tar->coef) > 0;
+            break;
+        case AF_CEIL:
+            up = dwhl_cmpu(&rem, 0) > 0;
+            break;
+        default:
+            break;
+        }
+        ok = !up || dwhl_addequ(&tar->coef, 1);
+    }
+    dwhl_clr(&rem);
+    return ok ? tar : NULL;
+}
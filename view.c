@@ -0,0 +1,356 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ladle/common/lib.h>
+
+#include "arbitrary.h"
+#include "etc.h"
+
+#define PREFIX  dwhl
+
+/* Bit-slice views
+ *
+ * A view names a range of bits of an integer by the bitfield holding its
+ * lowest bit and the offset of that bit, so taking one copies nothing. Each
+ * bitfield of a view is shifted into place and masked to the width of the view
+ * only as it is read. Sums and comparisons read views a few bitfields at a
+ * time into a buffer on the stack, or straight from the integer when the view
+ * starts on a bitfield boundary.
+ *
+ * Products need their operands whole. A view starting on a bitfield boundary
+ * is multiplied in place, as its full bitfields and the partial bitfield above
+ * them; the partial bitfield is folded in with single-bitfield products. Other
+ * views are shifted into scratch space first. */
+
+// ---- Constants ----
+
+// # of bitfields of view read at once by sums and comparisons
+#define VIEW_CHUNK  32
+
+// ---- Helper Functions ----
+
+static dwhl_t *add_view(dwhl_t *, const dwhl_view_t *, bool);
+static int cmp_views(const dwhl_view_t *, const dwhl_view_t *);
+static const bitfld_t *load(const dwhl_view_t *, size_t, size_t, bitfld_t *);
+static void mul_parts(bitfld_t *, const bitfld_t *, size_t, bitfld_t, const bitfld_t *, size_t, bitfld_t, bitfld_t *);
+static size_t split(const dwhl_view_t *, bitfld_t *);
+
+static inline bitfld_t view_fld(const dwhl_view_t *, size_t);
+static inline size_t view_size(const dwhl_view_t *);
+
+/* Adds or subtracts view in two's complement, stores result in tar
+ * View is read in chunks, as `do_add()' reads an integer with no sign extension */
+dwhl_t *add_view(dwhl_t *tar, const dwhl_view_t *val, bool sub) {
+    const size_t n = view_size(val);
+    bitfld_t buf[VIEW_CHUNK], carry = 0, ext;
+
+    if (tar->size < n && !extend(tar, n))
+        return NULL;
+    ext = sign_ext(tar);
+    for (size_t i = 0; i < n; i += VIEW_CHUNK) {
+        const size_t k = n - i < VIEW_CHUNK ? n - i : VIEW_CHUNK;
+        const bitfld_t *const vp = load(val, i, k, buf);
+        bitfld_t *const rp = tar->bits + i;
+
+        // Borrow or carry in and out of chunk total at most 1
+        carry = sub
+          ? ln_sub_n(rp, rp, vp, k) + ln_sub_1(rp, rp, k, carry)
+          : ln_add_n(rp, rp, vp, k) + ln_add_1(rp, rp, k, carry);
+    }
+    carry = sub
+      ? ln_sub_1(tar->bits + n, tar->bits + n, tar->size - n, carry)
+      : ln_add_1(tar->bits + n, tar->bits + n, tar->size - n, carry);
+    ext = sub ? ext - carry : ext + carry;
+    return put_top(tar, ext, ext & SIGN_BIT);
+}
+
+// Compares values of views
+int cmp_views(const dwhl_view_t *lhs, const dwhl_view_t *rhs) {
+    bitfld_t lbuf[VIEW_CHUNK], rbuf[VIEW_CHUNK];
+    size_t ln = view_size(lhs), rn = view_size(rhs);
+    int tmp = 0;
+
+    while (ln > rn && !view_fld(lhs, ln - 1))
+        --ln;
+    while (rn > ln && !view_fld(rhs, rn - 1))
+        --rn;
+    if (ln != rn)
+        return ln > rn ? 1 : -1;
+    for (size_t i = ln; i && !tmp;) {
+        const size_t k = i < VIEW_CHUNK ? i : VIEW_CHUNK;
+
+        i -= k;
+        tmp = ln_cmp(load(lhs, i, k, lbuf), load(rhs, i, k, rbuf), k);
+    }
+    return tmp;
+}
+
+/* Returns bitfields i to i + n of view, in place if they need no shift or mask, else loaded into buf
+ * Requires i + n no greater than # of bitfields spanned by view */
+const bitfld_t *load(const dwhl_view_t *view, size_t i, size_t n, bitfld_t *buf) {
+    if (!view->shift && i + n <= view->size && i + n <= view->width / BITFLD_BITS)
+        return view->bits + i;
+    for (size_t j = 0; j < n; ++j)
+        buf[j] = view_fld(view, i + j);
+    return buf;
+}
+
+/* Stores (a + at B^an)(b + bt B^bn) in rp, which holds an + bn + 2 bitfields, for B = 2^BITFLD_BITS
+ * Squares when a and b are the same buffer; rp may not overlap either */
+void mul_parts(bitfld_t *rp, const bitfld_t *ap, size_t an, bitfld_t at, const bitfld_t *bp, size_t bn, bitfld_t bt,
+  bitfld_t *tp) {
+    const size_t n = an + bn;
+    const dbitfld_t top = (dbitfld_t) at * bt;
+
+    if (!an || !bn)
+        memset(rp, 0, n * sizeof(bitfld_t));
+    else if (ap == bp && an == bn)
+        ln_sqr(rp, ap, an, tp);
+    else
+        ln_mul(rp, ap, an, bp, bn, tp);
+    rp[n] = (bitfld_t) top;
+    rp[n + 1] = (bitfld_t) (top >> BITFLD_BITS);
+
+    // Cross products end below the top two bitfields, which absorb their carries
+    if (at && bn)
+        ln_add_1(rp + n, rp + n, 2, ln_addmul_1(rp + an, bp, bn, at));
+    if (bt && an)
+        ln_add_1(rp + n, rp + n, 2, ln_addmul_1(rp + bn, ap, an, bt));
+}
+
+/* Returns # of full bitfields of view, storing bitfield above them, partial or 0, in top
+ * Full bitfields are read in place by `load()' when the view starts on a bitfield boundary */
+size_t split(const dwhl_view_t *view, bitfld_t *top) {
+    const size_t n = view_size(view), full = view->width / BITFLD_BITS;
+
+    if (full < n) {
+        *top = view_fld(view, full);
+        return full;
+    }
+    *top = 0;
+    return n;
+}
+
+// Returns bitfield i of view, shifted into place and masked to its width
+bitfld_t view_fld(const dwhl_view_t *view, size_t i) {
+    const bitfld_t ext = view->neg ? BITFLD_MAX : 0;
+    const shift_t left = view->width - (shift_t) i * BITFLD_BITS;
+    bitfld_t fld = i < view->size ? view->bits[i] : ext;
+
+    if (view->shift)
+        fld = fld >> view->shift | (i + 1 < view->size ? view->bits[i + 1] : ext) << (BITFLD_BITS - view->shift);
+    return left < BITFLD_BITS ? fld & ~(BITFLD_MAX << left) : fld;
+}
+
+/* Returns # of bitfields spanned by view
+ * Those past the buffer of a nonnegative integer are 0, and left out */
+size_t view_size(const dwhl_view_t *view) {
+    const size_t n = view->width / BITFLD_BITS + (view->width % BITFLD_BITS != 0);
+
+    return view->neg || n < view->size ? n : view->size;
+}
+
+// ---- Bit-Slice Views ----
+
+export dwhl_view_t *dwhl_view(dwhl_view_t *restrict tar, const dwhl_t *restrict val, shift_t lo, shift_t width) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (width > SHIFT_MAX - lo) {
+        errno = ERANGE;
+        return NULL;
+    }
+
+    const size_t at = lo / BITFLD_BITS;
+
+    *tar = (dwhl_view_t) {
+        val->bits + (at < val->size ? at : 0), at < val->size ? val->size - at : 0,
+        width, lo % BITFLD_BITS, last_fld(val) & SIGN_BIT
+    };
+    return tar;
+}
+export dwhl_view_t *dwhl_view_sub(dwhl_view_t *tar, const dwhl_view_t *val, shift_t lo, shift_t width) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (lo >= val->width)
+        lo = width = 0;
+    else if (width > val->width - lo)
+        width = val->width - lo;
+
+    // Offset of view from start of integer cannot exceed that of the end of val
+    const shift_t off = val->shift + lo;
+    const size_t at = off / BITFLD_BITS;
+
+    *tar = (dwhl_view_t) {
+        val->bits + (at < val->size ? at : 0), at < val->size ? val->size - at : 0,
+        width, off % BITFLD_BITS, val->neg
+    };
+    return tar;
+}
+
+export dwhl_t *dwhl_eqv(dwhl_t *restrict tar, const dwhl_view_t *restrict val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+
+    const size_t n = view_size(val);
+    const size_t size = n ? n + ((view_fld(val, n - 1) & SIGN_BIT) != 0) : 1;
+
+    if (size > BITFLD_CT_MAX) {     // Integer too large
+        errno = ERANGE;
+        return NULL;
+    }
+    if (tar->refs) {    // Overwritten, so the shared buffer is released rather than copied
+        dwhl_release(tar);
+        *tar = (dwhl_t) {NULL, 0, false, NULL};
+    }
+    if (tar->size < size) {
+        bitfld_t *const bits = realloc(tar->bits, size * sizeof(bitfld_t));
+
+        if (!bits)
+            return NULL;
+        tar->bits = bits;
+        tar->size = size;
+    }
+
+    const bitfld_t *const src = load(val, 0, n, tar->bits);
+
+    if (src != tar->bits)
+        memcpy(tar->bits, src, n * sizeof(bitfld_t));
+    memset(tar->bits + n, 0, (tar->size - n) * sizeof(bitfld_t));
+    return tar;
+}
+export dwhl_t *dwhl_initv(dwhl_t *restrict tar, const dwhl_view_t *restrict val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    *tar = (dwhl_t) {NULL, 0, false, NULL};
+    if (!dwhl_eqv(tar, val)) {
+        free(tar->bits);
+        return NULL;
+    }
+    return tar;
+}
+
+export int dwhl_cmpv(const dwhl_t *lhs, const dwhl_view_t *rhs) {
+    if (!lhs || !rhs) {
+        errno = EINVAL;
+        return 2;
+    }
+    if (last_fld(lhs) & SIGN_BIT)   // Views are never negative
+        return -1;
+
+    const dwhl_view_t all = {lhs->bits, lhs->size, (shift_t) lhs->size * BITFLD_BITS, 0, false};
+
+    return cmp_views(&all, rhs);
+}
+export int dwhl_view_cmp(const dwhl_view_t *lhs, const dwhl_view_t *rhs) {
+    if (!lhs || !rhs) {
+        errno = EINVAL;
+        return 2;
+    }
+    return cmp_views(lhs, rhs);
+}
+
+export dwhl_t *dwhl_addeqv(dwhl_t *tar, const dwhl_view_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return add_view(tar, val, false);
+}
+export dwhl_t *dwhl_muleqv(dwhl_t *tar, const dwhl_view_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+
+    bitfld_t bt;
+    const size_t an = tar->size, bm = split(val, &bt);
+
+    if (an + bm + 2 > BITFLD_CT_MAX) {  // Integer too large
+        errno = ERANGE;
+        return NULL;
+    }
+
+    bitfld_t *const tp = malloc((2 * (an + bm) + 2 + ln_mul_itch(an, bm ? bm : 1)) * sizeof(bitfld_t));
+
+    if (!tp)
+        return NULL;
+
+    // Magnitude of tar, then view if it must be shifted, then product, then scratch space
+    bitfld_t *const ap = tp, *const rp = tp + an + bm;
+    const size_t a_n = get_abs(ap, tar);
+    const bitfld_t *const bp = load(val, 0, bm, ap + an);
+    const size_t bn = bt ? bm : ln_norm(bp, bm);
+    dwhl_t *tmp;
+
+    mul_parts(rp, ap, a_n, 0, bp, bn, bt, rp + an + bm + 2);
+    tmp = set_abs(tar, rp, a_n + bn + 2, last_fld(tar) & SIGN_BIT);
+    free(tp);
+    return tmp;
+}
+export dwhl_t *dwhl_subeqv(dwhl_t *tar, const dwhl_view_t *val) {
+    if (!tar || !val) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+    own_bits(tar);
+    return add_view(tar, val, true);
+}
+export dwhl_t *dwhl_view_add(dwhl_t *tar, const dwhl_view_t *lhs, const dwhl_view_t *rhs) {
+    if (!tar || !lhs || !rhs) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return dwhl_eqv(tar, lhs) ? add_view(tar, rhs, false) : NULL;
+}
+export dwhl_t *dwhl_view_mul(dwhl_t *tar, const dwhl_view_t *lhs, const dwhl_view_t *rhs) {
+    if (!tar || !lhs || !rhs) {
+        errno = EINVAL;
+        return NULL;
+    }
+    assert_lval(tar);
+
+    // Equal views are loaded once, and squared
+    const bool same = lhs->bits == rhs->bits && lhs->size == rhs->size && lhs->width == rhs->width
+      && lhs->shift == rhs->shift && lhs->neg == rhs->neg;
+    bitfld_t at, bt;
+    const size_t am = split(lhs, &at), bm = split(rhs, &bt);
+
+    if (am + bm + 2 > BITFLD_CT_MAX) {  // Integer too large
+        errno = ERANGE;
+        return NULL;
+    }
+
+    const size_t itch = same ? ln_sqr_itch(am ? am : 1) : ln_mul_itch(am ? am : 1, bm ? bm : 1);
+    bitfld_t *const tp = malloc((2 * (am + bm) + 2 + itch) * sizeof(bitfld_t));
+
+    if (!tp)
+        return NULL;
+
+    // Views if they must be shifted, then product, then scratch space
+    bitfld_t *const rp = tp + am + bm;
+    const bitfld_t *const ap = load(lhs, 0, am, tp), *const bp = same ? ap : load(rhs, 0, bm, tp + am);
+
+    // Partial top bitfield sits just above the full ones, so those are only trimmed when it is 0
+    const size_t an = at ? am : ln_norm(ap, am), bn = same ? an : bt ? bm : ln_norm(bp, bm);
+    dwhl_t *tmp;
+
+    mul_parts(rp, ap, an, at, bp, bn, bt, rp + am + bm + 2);
+    tmp = set_abs(tar, rp, an + bn + 2, false);
+    free(tp);
+    return tmp;
+}